@@ -0,0 +1,91 @@
+#include <lib_math/lib_math.h>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Compare the Jacobian of a segment with a rigid segment by the forward-mode
+ * AD against the hand-written calcVariableLengthWithRigidSegmentJacobian() and
+ * the fused calcVariableLengthWithRigidSegmentPoseAndJacobian().
+ */
+namespace {
+constexpr int SAMPLE_NUM = 1000;
+constexpr int REPEAT_NUM = 200;
+
+template<typename Scalar, typename Func>
+void run(const char *name, const std::vector<Eigen::Vector<Scalar, 3>> &qs,
+         Scalar Lr, Func func)
+{
+    Eigen::Matrix<Scalar, 3, 3> Jv, Jw;
+    Scalar sum = 0;
+    auto time_start = mmath::timer::getCurrentTimePoint();
+    for(int k = 0; k < REPEAT_NUM; k++) {
+        for(const auto &q : qs) {
+            func(q[2], q[0], q[1], Lr, Jv, Jw);
+            sum += Jv(0, 0) + Jw(2, 1);
+        }
+    }
+    float ms = mmath::timer::getDurationSince(time_start);
+    printf("  %-28s %8.2f ns/call  (checksum %.3f)\n", name,
+           ms * 1e6 / (REPEAT_NUM * qs.size()), static_cast<double>(sum));
+}
+
+
+template<typename Scalar>
+void benchmark(const char *type_name)
+{
+    using namespace mmath::continuum;
+    std::vector<Eigen::Vector<Scalar, 3>> qs(SAMPLE_NUM);
+    for(int i = 0; i < SAMPLE_NUM; i++) {
+        Scalar s = Scalar(i) / SAMPLE_NUM;
+        qs[i] = Eigen::Vector<Scalar, 3>(
+                    Scalar(1.5) * s, Scalar(mmath::PI) * (2 * s - 1), 20 + 10 * s);
+    }
+    const Scalar Lr = 5;
+
+    // The max difference of AD against the hand-written Jacobian
+    Scalar err = 0;
+    for(const auto &q : qs) {
+        Eigen::Matrix<Scalar, 3, 3> Jv, Jw, Jv0, Jw0;
+        calcVariableLengthWithRigidSegmentJacobianAD<Scalar>(
+                    q[2], q[0], q[1], Lr, Jv, Jw);
+        calcVariableLengthWithRigidSegmentJacobian<Scalar>(
+                    q[2], q[0], q[1], Lr, Jv0, Jw0);
+        err = std::max(err, (Jv - Jv0).cwiseAbs().maxCoeff());
+        err = std::max(err, (Jw - Jw0).cwiseAbs().maxCoeff());
+    }
+    printf("[%s] %d samples x %d repeats, max |J_AD - J| = %.3e\n", type_name,
+           SAMPLE_NUM, REPEAT_NUM, static_cast<double>(err));
+
+    run<Scalar>("hand-written Jacobian", qs, Lr,
+                [](Scalar L, Scalar theta, Scalar delta, Scalar Lr,
+                   Eigen::Matrix<Scalar, 3, 3> &Jv,
+                   Eigen::Matrix<Scalar, 3, 3> &Jw) {
+        calcVariableLengthWithRigidSegmentJacobian<Scalar>(
+                    L, theta, delta, Lr, Jv, Jw);
+    });
+    run<Scalar>("fused pose and Jacobian", qs, Lr,
+                [](Scalar L, Scalar theta, Scalar delta, Scalar Lr,
+                   Eigen::Matrix<Scalar, 3, 3> &Jv,
+                   Eigen::Matrix<Scalar, 3, 3> &Jw) {
+        mmath::PoseT<Scalar> pose;
+        calcVariableLengthWithRigidSegmentPoseAndJacobian<Scalar>(
+                    L, theta, delta, Lr, pose, Jv, Jw);
+    });
+    run<Scalar>("forward-mode AD Jacobian", qs, Lr,
+                [](Scalar L, Scalar theta, Scalar delta, Scalar Lr,
+                   Eigen::Matrix<Scalar, 3, 3> &Jv,
+                   Eigen::Matrix<Scalar, 3, 3> &Jw) {
+        calcVariableLengthWithRigidSegmentJacobianAD<Scalar>(
+                    L, theta, delta, Lr, Jv, Jw);
+    });
+}
+}
+
+
+int main()
+{
+    printf("================= lib_math Jacobian benchmark =================\n");
+    benchmark<float>("float");
+    benchmark<double>("double");
+    return 0;
+}
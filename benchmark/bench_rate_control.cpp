@@ -0,0 +1,97 @@
+#include <lib_math/lib_math.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/**
+ * Run the ResolvedRateController in a periodic loop at 1 kHz and 10 kHz, where
+ * the end of a segment tracks a target sweeping the bending direction once per
+ * second, and report the percentiles of the execution time per step and the
+ * lateness of the wake-ups.
+ */
+namespace {
+using Clock = std::chrono::steady_clock;
+constexpr double DURATION_S = 2.0;
+
+
+double percentile(const std::vector<double> &sorted, double p)
+{
+    std::size_t i = static_cast<std::size_t>(p / 100 * (sorted.size() - 1));
+    return sorted[i];
+}
+
+
+void report(const char *name, std::vector<double> &ns)
+{
+    std::sort(ns.begin(), ns.end());
+    printf("  %-12s p50 %8.0f  p90 %8.0f  p99 %8.0f  p99.9 %8.0f  max %8.0f ns\n",
+           name, percentile(ns, 50), percentile(ns, 90), percentile(ns, 99),
+           percentile(ns, 99.9), ns.back());
+}
+
+
+void run(int rate_hz, bool is_variable_length)
+{
+    using namespace mmath::continuum;
+    using Vector3 = Eigen::Vector<mmath::kfloat, 3>;
+    const mmath::kfloat Lr = 5;
+    const mmath::kfloat dt = mmath::kfloat(1.0 / rate_hz);
+    const int step_num = static_cast<int>(DURATION_S * rate_hz);
+
+    ResolvedRateController controller(Lr, is_variable_length);
+    controller.setOrientationWeight(0);
+    controller.setRateLimits(2, 10, 50);
+    ConfigSpc q(mmath::deg2rad(30.f), 0, 25, true);
+
+    // The buffers are allocated before the loop
+    std::vector<double> exec_ns(step_num), late_ns(step_num);
+    mmath::kfloat err_max = 0;
+    int miss_num = 0;
+    const auto period = std::chrono::nanoseconds(1000000000 / rate_hz);
+    Vector3 target_last = calcSingleWithRigidSegmentPose(q, Lr).t;
+    auto wake = Clock::now() + period;
+    for(int k = 0; k < step_num; k++) {
+        std::this_thread::sleep_until(wake);
+        auto time_start = Clock::now();
+
+        // The target is reachable with both the fixed and variable lengths
+        mmath::kfloat phase = mmath::kfloat(2 * mmath::PI) * k * dt;
+        mmath::kfloat length = is_variable_length ? 25 + 3 * std::sin(phase) : 25;
+        Vector3 target = calcSingleWithRigidSegmentPose(
+                    ConfigSpc(mmath::deg2rad(30.f), phase, length, true), Lr).t;
+        Vector3 p = calcSingleWithRigidSegmentPose(q, Lr).t;
+        Eigen::Vector<mmath::kfloat, 6> twist;
+        // The feedforward of the target velocity with the feedback
+        twist << (target - target_last) / dt + 20 * (target - p), 0, 0, 0;
+        target_last = target;
+        controller.step(q, twist, dt);
+
+        auto time_end = Clock::now();
+        exec_ns[k] = std::chrono::duration<double, std::nano>(
+                    time_end - time_start).count();
+        late_ns[k] = std::chrono::duration<double, std::nano>(
+                    time_start - wake).count();
+        if(time_end > wake + period) miss_num++;
+        if(k > rate_hz) err_max = std::max(err_max, (target - p).norm());
+        wake += period;
+    }
+
+    printf("[%5d Hz, %s] %d steps, %d deadline misses, tracking error %.3f\n",
+           rate_hz, is_variable_length ? "variable length" : "fixed length",
+           step_num, miss_num, static_cast<double>(err_max));
+    report("step", exec_ns);
+    report("wake-up", late_ns);
+}
+}
+
+
+int main()
+{
+    for(int rate_hz : {1000, 10000}) {
+        run(rate_hz, false);
+        run(rate_hz, true);
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <lib_math/lib_math.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Compare the table-based single segment kinematics of SegmentApprox against
+ * the exact calcSingleSegmentPose() and calcSingleSegmentJacobian(), and
+ * report the errors of the tables and the speedup per degree.
+ */
+namespace {
+constexpr int SAMPLE_NUM = 1000;
+constexpr int REPEAT_NUM = 200;
+constexpr int TRIAL_NUM = 5;
+
+/** Return the best time per call of TRIAL_NUM trials, in ns. */
+template<typename Scalar, typename Func>
+double run(const char *name, const std::vector<Eigen::Vector<Scalar, 3>> &qs,
+           Func func)
+{
+    mmath::PoseT<Scalar> pose;
+    Eigen::Matrix<Scalar, 3, 2> Jv, Jw;
+    Scalar sum = 0;
+    double ns_min = 1e30;
+    for(int trial = 0; trial < TRIAL_NUM; trial++) {
+        auto time_start = mmath::timer::getCurrentTimePoint();
+        for(int k = 0; k < REPEAT_NUM; k++) {
+            for(const auto &q : qs) {
+                func(q[2], q[0], q[1], pose, Jv, Jw);
+                sum += pose.t[0] + Jv(0, 0) + Jw(1, 1);
+            }
+        }
+        float ms = mmath::timer::getDurationSince(time_start);
+        ns_min = std::min(ns_min, ms * 1e6 / (REPEAT_NUM * qs.size()));
+    }
+    printf("  %-28s %8.2f ns/call  (checksum %.3f)\n", name, ns_min,
+           static_cast<double>(sum));
+    return ns_min;
+}
+
+
+template<typename Scalar>
+void benchmark(const char *type_name)
+{
+    using namespace mmath::continuum;
+    std::vector<Eigen::Vector<Scalar, 3>> qs(SAMPLE_NUM);
+    for(int i = 0; i < SAMPLE_NUM; i++) {
+        Scalar s = Scalar(i) / SAMPLE_NUM;
+        qs[i] = Eigen::Vector<Scalar, 3>(
+                    Scalar(2.5) * s, Scalar(mmath::PI) * (2 * s - 1), 20 + 10 * s);
+    }
+
+    for(int degree : {3, 5, 7}) {
+        SegmentApproxT<Scalar> approx(0, Scalar(mmath::PI), 16, degree);
+        SegmentApproxError error = approx.errorReport();
+        printf("[%s] 16 pieces of degree %d, term error %.3e\n", type_name,
+               degree, static_cast<double>(approx.termError()));
+        printf("  error per unit L: R %.3e, t %.3e, Jv %.3e, Jw %.3e\n",
+               error.rotation, error.position, error.jacobian_v,
+               error.jacobian_w);
+
+        double ns_exact = run<Scalar>("exact pose and Jacobian", qs,
+                    [](Scalar L, Scalar theta, Scalar delta,
+                       mmath::PoseT<Scalar> &pose,
+                       Eigen::Matrix<Scalar, 3, 2> &Jv,
+                       Eigen::Matrix<Scalar, 3, 2> &Jw) {
+            calcSingleSegmentPose<Scalar>(L, theta, delta, pose);
+            calcSingleSegmentJacobian<Scalar>(L, theta, delta, Jv, Jw);
+        });
+        double ns_fused = run<Scalar>("fused pose and Jacobian", qs,
+                    [](Scalar L, Scalar theta, Scalar delta,
+                       mmath::PoseT<Scalar> &pose,
+                       Eigen::Matrix<Scalar, 3, 2> &Jv,
+                       Eigen::Matrix<Scalar, 3, 2> &Jw) {
+            calcSingleSegmentPoseAndJacobian<Scalar>(L, theta, delta, pose,
+                                                     Jv, Jw);
+        });
+        double ns_table = run<Scalar>("table pose and Jacobian", qs,
+                    [&approx](Scalar L, Scalar theta, Scalar delta,
+                              mmath::PoseT<Scalar> &pose,
+                              Eigen::Matrix<Scalar, 3, 2> &Jv,
+                              Eigen::Matrix<Scalar, 3, 2> &Jw) {
+            approx.calcSingleSegmentPoseAndJacobian(L, theta, delta, pose,
+                                                    Jv, Jw);
+        });
+        printf("  speedup of table: %.2fx vs exact, %.2fx vs fused\n",
+               ns_exact / ns_table, ns_fused / ns_table);
+    }
+}
+}
+
+
+int main()
+{
+    printf("============== lib_math segment approximation benchmark ==============\n");
+    benchmark<float>("float");
+    benchmark<double>("double");
+    return 0;
+}
@@ -37,6 +37,7 @@
 /** Tiny utilities */
 #include "lib_math/util/angle.h"
 #include "lib_math/util/linspace.h"
+#include "lib_math/util/format.h"
 
 /** Matrix related utilities */
 #include "lib_math/matrix/mat.h"
@@ -46,9 +47,27 @@
 
 /** Kinematics related utilities */
 #include "lib_math/kine/pose.h"
+#include "lib_math/kine/qpose.h"
+#include "lib_math/kine/lie.h"
+#include "lib_math/kine/pose_trajectory.h"
+#include "lib_math/kine/dual_quat.h"
+#include "lib_math/kine/pose_chain.h"
+#include "lib_math/kine/frame_tree.h"
+#include "lib_math/kine/pose_average.h"
 #include "lib_math/kine/continuum_configspc.h"
 #include "lib_math/kine/continuum_pose.h"
+#include "lib_math/kine/continuum_pose_generic.h"
+#include "lib_math/kine/continuum_terms.h"
+#include "lib_math/kine/continuum_pose_batch.h"
+#include "lib_math/kine/continuum_approx.h"
 #include "lib_math/kine/dcontinuum_pose.h"
+#include "lib_math/kine/continuum_actuation.h"
+#include "lib_math/kine/continuum_robot.h"
+#include "lib_math/kine/singularity_monitor.h"
+#include "lib_math/kine/continuum_ik.h"
+#include "lib_math/kine/continuum_rate_control.h"
+#include "lib_math/kine/continuum_trajectory.h"
+#include "lib_math/kine/continuum_workspace.h"
 
 /** Curve related utilities */
 #include "lib_math/curve/line_2d.h"
@@ -22,6 +22,9 @@
  * --------------------------------------------------------------------
  * Change History:                        
  * 
+ * 2026/10/16 Template this class on the scalar type, keep CameraProjector as
+ * alias.
+ * 
  * -------------------------------------------------------------------*/
 #ifndef LIB_MATH_CAMERA_PROJECTOR_H_LF
 #define LIB_MATH_CAMERA_PROJECTOR_H_LF
@@ -53,8 +56,11 @@ extern ID RIGHT;
  * the left or right camera frame for binocular.
  * - SPECIFIED imaging frame: equals to image frame for monocular, or indicates  
  * the left or right image frame for binocular.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
  */
-class CameraProjector
+template<typename Scalar>
+class CameraProjectorT
 {
 public:
     /**
@@ -69,8 +75,8 @@ public:
      * @param t   The distance between stereo cameras. When no distance or zero
      *            value is given, the camera is supposed to be a monocular.
      */
-    CameraProjector(kfloat fxy, kfloat cx, kfloat cy, kfloat t = 0);
-    ~CameraProjector();
+    CameraProjectorT(Scalar fxy, Scalar cx, Scalar cy, Scalar t = 0);
+    ~CameraProjectorT();
 
 
     /**
@@ -83,8 +89,8 @@ public:
      * @param [in]  z  Z coordinate of the 3D point w.r.t GLOBAL camera frame.
      * @param [out] pt2D A 2D point w.r.t GLOBAL imaging frame.
      */
-    void cvt3Dto2D(kfloat x, kfloat y, kfloat z, 
-                   Eigen::Vector<kfloat, 2>& pt2D) const;
+    void cvt3Dto2D(Scalar x, Scalar y, Scalar z, 
+                   Eigen::Vector<Scalar, 2>& pt2D) const;
 
 
     /**
@@ -101,7 +107,7 @@ public:
      * 
      * @return A 2D point w.r.t GLOBAL imaging frame.
      */
-    Eigen::Vector<kfloat, 2> cvt3Dto2D(kfloat x, kfloat y, kfloat z) const;
+    Eigen::Vector<Scalar, 2> cvt3Dto2D(Scalar x, Scalar y, Scalar z) const;
 
 
     /**
@@ -114,8 +120,8 @@ public:
      * @param [in]  pt3D A 3D point w.r.t GLOBAL camera frame.
      * @param [out] pt2D A 2D point w.r.t GLOBAL imaging frame.
      */
-    void cvt3Dto2D(const Eigen::Vector<kfloat, 3>& pt3D,
-                   Eigen::Vector<kfloat, 2>& pt2D) const;
+    void cvt3Dto2D(const Eigen::Vector<Scalar, 3>& pt3D,
+                   Eigen::Vector<Scalar, 2>& pt2D) const;
 
 
     /**
@@ -130,7 +136,7 @@ public:
      * 
      * @return A 2D point w.r.t GLOBAL imaging frame.
      */
-    Eigen::Vector<kfloat, 2> cvt3Dto2D(const Eigen::Vector<kfloat, 3>& pt3D) const;
+    Eigen::Vector<Scalar, 2> cvt3Dto2D(const Eigen::Vector<Scalar, 3>& pt3D) const;
 
 
     /**
@@ -144,8 +150,8 @@ public:
      * @param [in]  id  Specify the camera index for binocular.
      * @param [out] pt2D A 2D point w.r.t SPECIFIED imaging frame.
      */
-    void cvt3Dto2D(kfloat x, kfloat y, kfloat z, cam::ID id,
-                   Eigen::Vector<kfloat, 2>& pt2D) const;
+    void cvt3Dto2D(Scalar x, Scalar y, Scalar z, cam::ID id,
+                   Eigen::Vector<Scalar, 2>& pt2D) const;
 
 
     /**
@@ -163,7 +169,7 @@ public:
      * 
      * @return A 2D point w.r.t SPECIFIED imaging frame.
      */
-    Eigen::Vector<kfloat, 2> cvt3Dto2D(kfloat x, kfloat y, kfloat z,
+    Eigen::Vector<Scalar, 2> cvt3Dto2D(Scalar x, Scalar y, Scalar z,
                                        cam::ID id) const;
 
 
@@ -178,8 +184,8 @@ public:
      * @param [in]  id    Specify the camera index for binocular.
      * @param [out] pt2D  A 2D point w.r.t SPECIFIED imaging frame.
      */
-    void cvt3Dto2D(const Eigen::Vector<kfloat, 3>& pt3D, cam::ID id,
-                   Eigen::Vector<kfloat, 2>& pt2D) const;
+    void cvt3Dto2D(const Eigen::Vector<Scalar, 3>& pt3D, cam::ID id,
+                   Eigen::Vector<Scalar, 2>& pt2D) const;
 
 
     /**
@@ -195,7 +201,7 @@ public:
      * 
      * @return A 2D point w.r.t SPECIFIED imaging frame.
      */
-    Eigen::Vector<kfloat, 2> cvt3Dto2D(const Eigen::Vector<kfloat, 3>& pt3D,
+    Eigen::Vector<Scalar, 2> cvt3Dto2D(const Eigen::Vector<Scalar, 3>& pt3D,
                                        cam::ID id) const;
 
 
@@ -209,8 +215,8 @@ public:
      * @param [in] depth Depth of the given 2D point w.r.t GLOBAL camera frame.
      * @param [out] pt3D  A 3D point w.r.t GLOBAL camera frame.
      */
-    void cvt2Dto3D(kfloat u, kfloat v, kfloat depth,
-                  Eigen::Vector<kfloat, 3>& pt3D) const;
+    void cvt2Dto3D(Scalar u, Scalar v, Scalar depth,
+                  Eigen::Vector<Scalar, 3>& pt3D) const;
 
 
     /**
@@ -227,7 +233,7 @@ public:
      * 
      * @return A 3D point w.r.t GLOBAL camera frame
      */
-    Eigen::Vector<kfloat, 3> cvt2Dto3D(kfloat u, kfloat v, kfloat depth) const;
+    Eigen::Vector<Scalar, 3> cvt2Dto3D(Scalar u, Scalar v, Scalar depth) const;
 
 
     /**
@@ -241,8 +247,8 @@ public:
      * @param [in] depth Depth of the given 2D point w.r.t GLOBAL camera frame.
      * @param [out] pt3D  A 3D point w.r.t GLOBAL camera frame.
      */
-    void cvt2Dto3D(const Eigen::Vector<kfloat, 2>& pt2D, kfloat depth,
-                   Eigen::Vector<kfloat, 3>& pt3D) const;
+    void cvt2Dto3D(const Eigen::Vector<Scalar, 2>& pt2D, Scalar depth,
+                   Eigen::Vector<Scalar, 3>& pt3D) const;
 
 
     /**
@@ -258,8 +264,8 @@ public:
      * 
      * @return A 3D point w.r.t GLOBAL camera frame.
      */
-    Eigen::Vector<kfloat, 3> cvt2Dto3D(const Eigen::Vector<kfloat, 2>& pt2D,
-                                       kfloat depth) const;
+    Eigen::Vector<Scalar, 3> cvt2Dto3D(const Eigen::Vector<Scalar, 2>& pt2D,
+                                       Scalar depth) const;
 
 
     /**
@@ -273,8 +279,8 @@ public:
      * @param [in] id    Specify the camera index for binocular.
      * @param [out] pt3D  A 3D point w.r.t GLOBAL camera frame.
      */
-    void cvt2Dto3D(kfloat u, kfloat v, kfloat depth, cam::ID id, 
-                   Eigen::Vector<kfloat, 3>& pt3D) const;
+    void cvt2Dto3D(Scalar u, Scalar v, Scalar depth, cam::ID id, 
+                   Eigen::Vector<Scalar, 3>& pt3D) const;
 
     /**
      * @brief Lifting 2D point that w.r.t SPECIFIED imaging frame to 3D.
@@ -291,7 +297,7 @@ public:
      * 
      * @return A 3D point w.r.t GLOBAL camera frame.
      */
-    Eigen::Vector<kfloat, 3> cvt2Dto3D(kfloat u, kfloat v, kfloat depth,
+    Eigen::Vector<Scalar, 3> cvt2Dto3D(Scalar u, Scalar v, Scalar depth,
                                        cam::ID id) const;
 
 
@@ -307,8 +313,8 @@ public:
      * @param [in] id    Specify the camera index for binocular.
      * @param [out] pt3D  A 3D point w.r.t GLOBAL camera frame.
      */
-    void cvt2Dto3D(const Eigen::Vector<kfloat, 2>& pt2D, kfloat depth, 
-                   cam::ID id, Eigen::Vector<kfloat, 3>& pt3D) const;
+    void cvt2Dto3D(const Eigen::Vector<Scalar, 2>& pt2D, Scalar depth, 
+                   cam::ID id, Eigen::Vector<Scalar, 3>& pt3D) const;
 
 
     /**
@@ -325,15 +331,22 @@ public:
      * 
      * @return A 3D point w.r.t GLOBAL camera frame
      */
-    Eigen::Vector<kfloat, 3> cvt2Dto3D(const Eigen::Vector<kfloat, 2>& pt2D,
-                                       kfloat depth, cam::ID id) const;
+    Eigen::Vector<Scalar, 3> cvt2Dto3D(const Eigen::Vector<Scalar, 2>& pt2D,
+                                       Scalar depth, cam::ID id) const;
 
 
-    const float fxy; //!< Focal length
-    const float cx;  //!< x coordinates of optical axis in imaging plane
-    const float cy;  //!< y coordinates of optical axis in imaging plane
-    const float t;   //!< Distance between binocular's optical axis
+    const Scalar fxy; //!< Focal length
+    const Scalar cx;  //!< x coordinates of optical axis in imaging plane
+    const Scalar cy;  //!< y coordinates of optical axis in imaging plane
+    const Scalar t;   //!< Distance between binocular's optical axis
 };
 
+
+extern template class CameraProjectorT<float>;
+extern template class CameraProjectorT<double>;
+
+/** The CameraProjector with the precision controlled by LIB_MATH_USE_DOUBLE. */
+using CameraProjector = CameraProjectorT<kfloat>;
+
 } // mmath
 #endif // LIB_MATH_CAMERA_PROJECTOR_H_LF
@@ -0,0 +1,192 @@
+/**--------------------------------------------------------------------
+ *
+ *   				   Mathematics extension library
+ *
+ * Description:
+ * This file is part of lib_math. You can redistribute it and or modify
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ *
+ * @file 		continuum_actuation.h
+ *
+ * @brief 		Design the mapping between the configuration space and the
+ *              actuation space, i.e., the lengths of the backbones or the
+ *              tendons, of a continuum segment.
+ *
+ * @author		Longfei Wang
+ *
+ * @date		2026/10/16
+ *
+ * @license		MIT
+ *
+ * Copyright (C) 2019-Now Longfei Wang.
+ *
+ * --------------------------------------------------------------------
+ * Change History:
+ *
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_CONTINUUM_ACTUATION_H_LF
+#define LIB_MATH_CONTINUUM_ACTUATION_H_LF
+#include <Eigen/Dense>
+#include <cstddef>
+#include <vector>
+#include "continuum_configspc.h"
+
+namespace mmath{
+namespace continuum{
+
+/**
+ * @brief A class designed to map a segment configuration to the lengths of
+ * its actuators and back, for a multi-backbone or tendon-driven segment.
+ *
+ * @details The N backbones (or tendons) are equally spaced on a circle of
+ * radius r, the pitch radius, where the i-th one is at the angle
+ * sigma_i = phase + 2*pi*i/N in the base frame of the segment. Under the
+ * constant curvature assumption, the length of the i-th backbone is
+ *   l_i = L - r*theta*cos(delta - sigma_i),
+ * where L is the length of the central backbone. The lengths are segment-local,
+ * i.e., the part of each backbone within this segment.
+ *
+ * The inverse mapping is the least-squares solution of the above, with
+ *   L = mean(l_i),
+ *   r*theta*[cos(delta), sin(delta)] = -2/N * sum(l_i*[cos(sigma_i), sin(sigma_i)]),
+ * which gives theta >= 0 and delta in [-pi, pi]. The configuration with
+ * theta < 0 has the same lengths as (-theta, delta + pi).
+ *
+ * A segment with is_bend = false has all the lengths equal to L.
+ *
+ * @tparam Scalar  The floating-point type, float or double.
+ */
+template<typename Scalar>
+class SegmentActuationT
+{
+public:
+    /**
+     * @brief Construct a new SegmentActuation object.
+     *
+     * @param backbone_num  The number of backbones, at least 3.
+     * @param pitch_radius  The radius of the circle of the backbones.
+     * @param phase         The angle of the first backbone.
+     */
+    SegmentActuationT(int backbone_num, Scalar pitch_radius, Scalar phase = 0);
+
+
+    /**
+     * @brief Return the number of backbones.
+     */
+    int backboneNum() const;
+
+
+    /**
+     * @brief Return the pitch radius.
+     */
+    Scalar pitchRadius() const;
+
+
+    /**
+     * @brief Return the angle of the i-th backbone.
+     */
+    Scalar backboneAngle(int i) const;
+
+
+    /**
+     * @brief Calculate the lengths of the backbones of a configuration.
+     *
+     * @param [in] q         The configuration.
+     * @param [out] lengths  The lengths, an array with backboneNum() values.
+     */
+    void calcLengths(const ConfigSpcT<Scalar>& q, Scalar* lengths) const;
+
+
+    /**
+     * @brief Calculate the lengths of the backbones of a batch of
+     * configurations.
+     *
+     * @param [in] qs        The configurations, an array with num values.
+     * @param [in] num       The number of configurations.
+     * @param [out] lengths  The lengths, an array with num*backboneNum()
+     *                       values, where the lengths of qs[k] start from
+     *                       lengths + k*backboneNum().
+     */
+    void calcLengthsBatch(const ConfigSpcT<Scalar>* qs, std::size_t num,
+                          Scalar* lengths) const;
+
+
+    /**
+     * @brief Calculate the configuration of the lengths of the backbones.
+     *
+     * @param [in] lengths  The lengths, an array with backboneNum() values.
+     * @param [out] q       The configuration, which is a bending segment.
+     */
+    void calcConfig(const Scalar* lengths, ConfigSpcT<Scalar>& q) const;
+
+
+    /**
+     * @brief Calculate the configuration of the lengths of the backbones.
+     *
+     * @remark This is an overloaded function, provided for convenience.
+     */
+    ConfigSpcT<Scalar> calcConfig(const Scalar* lengths) const;
+
+
+    /**
+     * @brief Calculate the configurations of a batch of lengths.
+     *
+     * @param [in] lengths  The lengths, an array with num*backboneNum() values.
+     * @param [in] num      The number of configurations.
+     * @param [out] qs      The configurations, an array with num values.
+     */
+    void calcConfigBatch(const Scalar* lengths, std::size_t num,
+                         ConfigSpcT<Scalar>* qs) const;
+
+
+    /**
+     * @brief Calculate the Jacobian of the lengths w.r.t the configuration.
+     *
+     * @param [in] q    The configuration.
+     * @param [out] Jl  The N x 3 Jacobian, with [dl/dtheta, dl/ddelta, dl/dL].
+     */
+    void calcLengthJacobian(
+            const ConfigSpcT<Scalar>& q,
+            Eigen::Ref<Eigen::Matrix<Scalar, Eigen::Dynamic, 3>> Jl) const;
+
+
+    /**
+     * @brief Calculate the Jabobian of the end frame of a segment, which with
+     * a rigid segment, w.r.t the lengths of the backbones.
+     *
+     * @details The Jacobian of calcVariableLengthWithRigidSegmentJacobian() is
+     * chained with the Jacobian of the inverse mapping. Since d(delta)/dl is
+     * proportional to 1/theta while the delta column of the segment Jacobian
+     * is proportional to theta, the product is taken analytically, which is
+     * finite at theta = 0. No memory is allocated.
+     *
+     * @param [in] q    The configuration.
+     * @param [in] Lr   The length of the rigid segment.
+     * @param [out] Jv  The 3 x N Jacobian w.r.t Velocity.
+     * @param [out] Jw  The 3 x N Jacobian w.r.t Angular-Velocity.
+     *
+     * @see mmath::continuum::calcVariableLengthWithRigidSegmentJacobian().
+     */
+    void calcActuationJacobian(
+            const ConfigSpcT<Scalar>& q, Scalar Lr,
+            Eigen::Ref<Eigen::Matrix<Scalar, 3, Eigen::Dynamic>> Jv,
+            Eigen::Ref<Eigen::Matrix<Scalar, 3, Eigen::Dynamic>> Jw) const;
+
+private:
+    int                 _backbone_num;
+    Scalar              _pitch_radius;
+    Scalar              _phase;
+    std::vector<Scalar> _cos;   //!< cos(sigma_i)
+    std::vector<Scalar> _sin;   //!< sin(sigma_i)
+};
+
+
+extern template class SegmentActuationT<float>;
+extern template class SegmentActuationT<double>;
+
+/** The SegmentActuation with the precision controlled by LIB_MATH_USE_DOUBLE. */
+using SegmentActuation = SegmentActuationT<kfloat>;
+
+}} // mmath::continuum
+#endif // LIB_MATH_CONTINUUM_ACTUATION_H_LF
@@ -0,0 +1,227 @@
+/**--------------------------------------------------------------------
+ *
+ *   				   Mathematics extension library
+ *
+ * Description:
+ * This file is part of lib_math. You can redistribute it and or modify
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ *
+ * @file 		continuum_approx.h
+ *
+ * @brief 		Design the single segment kinematics by precomputed polynomial
+ *              tables, for the hard-real-time controllers.
+ *
+ * @author		Longfei Wang
+ *
+ * @date		2026/10/16
+ *
+ * @license		MIT
+ *
+ * Copyright (C) 2019-Now Longfei Wang.
+ *
+ * --------------------------------------------------------------------
+ * Change History:
+ *
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_CONTINUUM_APPROX_H_LF
+#define LIB_MATH_CONTINUUM_APPROX_H_LF
+#include <Eigen/Dense>
+#include <vector>
+#include "pose.h"
+#include "../util/angle.h"
+
+namespace mmath{
+namespace continuum{
+
+/**
+ * @brief The errors of mmath::continuum::SegmentApproxT against the exact
+ * path, which are the max-abs errors over the samples.
+ */
+struct SegmentApproxError
+{
+    double theta_terms = 0; //!< sin, cos, f1, f2 of theta and their derivatives.
+    double delta_terms = 0; //!< sin, cos of delta.
+    double rotation = 0;    //!< The entries of the rotation.
+    double position = 0;    //!< The position, divided by L.
+    double jacobian_v = 0;  //!< Jv, divided by L.
+    double jacobian_w = 0;  //!< Jw.
+};
+
+
+/**
+ * @brief A class designed to calculate the pose and the Jacobian of a single
+ * segment without calling sin/cos.
+ *
+ * @details The theta terms, i.e., sin, cos, f1 = (1 - cos(theta))/theta,
+ * f2 = sin(theta)/theta, df1/dtheta and df2/dtheta, are fitted in
+ * [theta_min, theta_max] piecewise, and sin/cos of delta in [-pi, pi]. Each
+ * piece is the Chebyshev interpolant of the given degree, which is stored in
+ * the power basis of the local coordinate. A lookup is an index computation
+ * and a Horner evaluation, i.e., constant time. The table is built in the
+ * constructor, which allocates memory, while the calculations never do.
+ *
+ * The theta out of [theta_min, theta_max] falls back to the exact terms, and
+ * delta is wrapped into [-pi, pi].
+ *
+ * A call dispatches the degree once for both tables, and costs about
+ * 8*(degree + 1) multiply-adds in place of the two sin/cos pairs, so the
+ * table pays off with a low degree, or on a target with a slow libm. In
+ * float, a degree above 5 adds cost without accuracy, thus degree 3 to 5 is
+ * the choice; in double, degree 5 to 7 reaches 1e-9 to 1e-12. The benchmark
+ * bench_segment_approx reports the speedup per degree on the target.
+ *
+ * @tparam Scalar  The floating-point type, float or double.
+ */
+template<typename Scalar>
+class SegmentApproxT
+{
+public:
+    /**
+     * @brief Construct a new SegmentApprox object and build the tables.
+     *
+     * @param theta_min     The lower bound of the fitted theta.
+     * @param theta_max     The upper bound of the fitted theta.
+     * @param interval_num  The number of pieces in each table.
+     * @param degree        The degree of the polynomial of each piece, which
+     *                      is clamped into [1, 8].
+     */
+    SegmentApproxT(Scalar theta_min = 0, Scalar theta_max = Scalar(PI),
+                   int interval_num = 16, int degree = 5);
+
+
+    /**
+     * @brief Return the lower bound of the fitted theta.
+     */
+    Scalar thetaMin() const;
+
+
+    /**
+     * @brief Return the upper bound of the fitted theta.
+     */
+    Scalar thetaMax() const;
+
+
+    /**
+     * @brief Return the max-abs error of the fitted terms, measured in the
+     * constructor, which bounds the error of a lookup up to the rounding.
+     */
+    Scalar termError() const;
+
+
+    /**
+     * @brief Calculating the end pose of a single segment.
+     *
+     * @param [in] L      The length of the segment.
+     * @param [in] theta  The bending angle of the segment.
+     * @param [in] delta  The bending direction of the segment.
+     * @param [out] pose  The end pose w.r.t its base frame.
+     *
+     * @see mmath::continuum::calcSingleSegmentPose().
+     */
+    void calcSingleSegmentPose(Scalar L, Scalar theta, Scalar delta,
+                               PoseT<Scalar>& pose) const;
+
+
+    /**
+     * @brief Calculating the end pose of a single segment with a rigid
+     * segment.
+     *
+     * @param [in] L      The length of the segment.
+     * @param [in] theta  The bending angle of the segment.
+     * @param [in] delta  The bending direction of the segment.
+     * @param [in] Lr     The length of the rigid segment.
+     * @param [out] pose  The end pose w.r.t its base frame.
+     *
+     * @see mmath::continuum::calcSingleWithRigidSegmentPose().
+     */
+    void calcSingleWithRigidSegmentPose(Scalar L, Scalar theta, Scalar delta,
+                                        Scalar Lr, PoseT<Scalar>& pose) const;
+
+
+    /**
+     * @brief Calculate the Jabobian of a single segment w.r.t Velocity and
+     * Angular-Velocity.
+     *
+     * @param [in] L      The length of the segment.
+     * @param [in] theta  The bending angle of the segment.
+     * @param [in] delta  The bending direction of the segment.
+     * @param [out] Jv    The returned Jacobian w.r.t Velocity, with
+     *                    [Jv_theta(:), Jv_delta(:)].
+     * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with
+     *                    [Jw_theta(:), Jw_delta(:)].
+     *
+     * @see mmath::continuum::calcSingleSegmentJacobian().
+     */
+    void calcSingleSegmentJacobian(Scalar L, Scalar theta, Scalar delta,
+                                   Eigen::Matrix<Scalar, 3, 2>& Jv,
+                                   Eigen::Matrix<Scalar, 3, 2>& Jw) const;
+
+
+    /**
+     * @brief Calculate the end pose and the Jabobian of a single segment, in
+     * one lookup of the tables.
+     *
+     * @param [in] L      The length of the segment.
+     * @param [in] theta  The bending angle of the segment.
+     * @param [in] delta  The bending direction of the segment.
+     * @param [out] pose  The end pose w.r.t its base frame.
+     * @param [out] Jv    The returned Jacobian w.r.t Velocity, with
+     *                    [Jv_theta(:), Jv_delta(:)].
+     * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with
+     *                    [Jw_theta(:), Jw_delta(:)].
+     *
+     * @see mmath::continuum::calcSingleSegmentPoseAndJacobian().
+     */
+    void calcSingleSegmentPoseAndJacobian(
+            Scalar L, Scalar theta, Scalar delta, PoseT<Scalar>& pose,
+            Eigen::Matrix<Scalar, 3, 2>& Jv,
+            Eigen::Matrix<Scalar, 3, 2>& Jw) const;
+
+
+    /**
+     * @brief Compare the pose and the Jacobian against the exact path in
+     * double, over a uniform grid of theta in [thetaMin(), thetaMax()] and
+     * delta in [-pi, pi].
+     *
+     * @param sample_num  The number of samples on each axis.
+     *
+     * @return The errors.
+     */
+    SegmentApproxError errorReport(int sample_num = 256) const;
+
+private:
+    /** The number of fitted theta terms and delta terms. */
+    static constexpr int THETA_TERM_NUM = 6;
+    static constexpr int DELTA_TERM_NUM = 2;
+
+    /** Look up the theta terms t and the delta terms d. */
+    template<int D>
+    void calcTerms(Scalar theta, Scalar delta, Scalar* t, Scalar* d) const;
+    void calcTerms(Scalar theta, Scalar delta, Scalar* t, Scalar* d) const;
+    static void poseFromTerms(const Scalar* t, const Scalar* d, Scalar L,
+                              Scalar Lr, PoseT<Scalar>& pose);
+    static void jacobianFromTerms(const Scalar* t, const Scalar* d, Scalar L,
+                                  Eigen::Matrix<Scalar, 3, 2>& Jv,
+                                  Eigen::Matrix<Scalar, 3, 2>& Jw);
+
+    Scalar              _theta_min;
+    Scalar              _theta_max;
+    int                 _interval_num;
+    int                 _degree;
+    Scalar              _theta_scale;   //!< interval_num / (max - min)
+    Scalar              _delta_scale;   //!< interval_num / (2 * pi)
+    Scalar              _term_error;
+    std::vector<Scalar> _theta_coeffs;  //!< [interval][power][term]
+    std::vector<Scalar> _delta_coeffs;  //!< [interval][power][term]
+};
+
+
+extern template class SegmentApproxT<float>;
+extern template class SegmentApproxT<double>;
+
+/** The SegmentApprox with the precision controlled by LIB_MATH_USE_DOUBLE. */
+using SegmentApprox = SegmentApproxT<kfloat>;
+
+}} // mmath::continuum
+#endif // LIB_MATH_CONTINUUM_APPROX_H_LF
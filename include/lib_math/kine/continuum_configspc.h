@@ -22,12 +22,18 @@
  * --------------------------------------------------------------------
  * Change History:                        
  * 
+ * 2026/10/16 Add comparison operators.
+ * 2026/10/16 Add reentrant info() and binary record.
+ * 2026/10/16 Template this class on the scalar type, keep ConfigSpc as alias.
+ * 
  * -------------------------------------------------------------------*/
 #ifndef LIB_MATH_CONTINUUM_CONFIGSPC_H_LF
 #define LIB_MATH_CONTINUUM_CONFIGSPC_H_LF
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include "../math_precision.h"
+#include "../util/format.h"
 
 namespace mmath{
 namespace continuum{
@@ -43,11 +49,15 @@ namespace continuum{
  * is_bend  --  sepcifiy the bending/rigid segment, the default value is
  *              bending segment. If rigid segment is set, the kinematics
  *              of this segment will only consider a rotation alone z.
+ *
+ * @tparam Scalar  The floating-point type, float or double.
  */ 
-class ConfigSpc
+template<typename Scalar>
+class ConfigSpcT
 {
 public:
-    ConfigSpc(kfloat theta = 0, kfloat delta = 0, kfloat len = 0, bool bend = false)
+    ConfigSpcT(Scalar theta = 0, Scalar delta = 0, Scalar len = 0,
+               bool bend = false)
         : theta(theta), delta(delta), length(len), is_bend(bend)
     {}
 	
@@ -57,28 +67,127 @@ public:
      */
     void clear()
     {
-        *this = ConfigSpc();
+        *this = ConfigSpcT();
+    }
+
+
+    /**
+     * @brief Cast the configuration value to another scalar type.
+     */
+    template<typename Tp1>
+    ConfigSpcT<Tp1> cast() const
+    {
+        return ConfigSpcT<Tp1>(static_cast<Tp1>(theta), static_cast<Tp1>(delta),
+                               static_cast<Tp1>(length), is_bend);
+    }
+
+
+    /**
+     * @brief Compare with another configuration value.
+     *
+     * @return Return whether all the members are exactly the same.
+     */
+    bool operator==(const ConfigSpcT& q) const
+    {
+        return theta == q.theta && delta == q.delta && length == q.length
+                && is_bend == q.is_bend;
+    }
+
+
+    /**
+     * @brief Compare with another configuration value.
+     *
+     * @return Return whether any of the members is different.
+     */
+    bool operator!=(const ConfigSpcT& q) const
+    {
+        return !(*this == q);
     }
 
 
     /**
      * @brief Return a string a current configure value.
+     *
+     * @note The returned array is a thread-local buffer, which is valid until
+     * the next call of this function in the same thread.
      */
     const char* info() const
     {
-        static char info[64];
-        sprintf(info, "theta:%f,delta:%f,length:%f,is_bend:%d",
-                theta, delta, length, is_bend);
+        thread_local char info[64];
+        this->info(info, sizeof(info));
         return info;
     }
 
-    kfloat theta;
-    kfloat delta;
-    kfloat length;
+
+    /**
+     * @brief Write a string of current configure value into a caller-provided
+     * buffer, which is reentrant and uses neither static nor heap memory.
+     *
+     * @param [out] buf   The buffer, 64 bytes are enough for usual values.
+     * @param [in] size   The size of the buffer.
+     * @param [in] precision  The number of digits after the decimal point.
+     *
+     * @return The length of the string, the string is truncated if the 
+     * returned value is not less than size.
+     */
+    int info(char *buf, std::size_t size, int precision = 6) const
+    {
+        FormatWriter writer(buf, size);
+        writer.append("theta:").append(theta, precision)
+                .append(",delta:").append(delta, precision)
+                .append(",length:").append(length, precision)
+                .append(",is_bend:").append(is_bend ? 1 : 0);
+        return writer.length();
+    }
+
+
+    /** The size of a binary record of a ConfigSpc in bytes. */
+    static constexpr std::size_t RECORD_SIZE = 4 * sizeof(Scalar);
+
+
+    /**
+     * @brief Write current configure value as a binary record, for high-rate
+     * logging.
+     *
+     * @details The record contains [theta, delta, length, is_bend] as 4 Scalar
+     * values, where is_bend is stored as 1 or 0.
+     *
+     * @param [out] record  The buffer with at least RECORD_SIZE bytes.
+     *
+     * @return The number of bytes written, i.e., RECORD_SIZE.
+     */
+    std::size_t toRecord(void *record) const
+    {
+        Scalar values[4] = {theta, delta, length, Scalar(is_bend ? 1 : 0)};
+        std::memcpy(record, values, RECORD_SIZE);
+        return RECORD_SIZE;
+    }
+
+
+    /**
+     * @brief Read the configure value from a binary record.
+     *
+     * @param [in] record  The buffer with at least RECORD_SIZE bytes.
+     */
+    void fromRecord(const void *record)
+    {
+        Scalar values[4];
+        std::memcpy(values, record, RECORD_SIZE);
+        theta = values[0];
+        delta = values[1];
+        length = values[2];
+        is_bend = values[3] != 0;
+    }
+
+    Scalar theta;
+    Scalar delta;
+    Scalar length;
 	bool is_bend;
 };
 
 
+/** The ConfigSpc with the precision controlled by LIB_MATH_USE_DOUBLE. */
+using ConfigSpc = ConfigSpcT<kfloat>;
 
 }} // mmath::continuum
 #endif // LIB_MATH_CONFIGSPC_H_LF
@@ -0,0 +1,205 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		continuum_ik.h
+ * 
+ * @brief 		A damped-least-squares inverse kinematics solver for
+ *          	continuum robots.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_CONTINUUM_IK_H_LF
+#define LIB_MATH_CONTINUUM_IK_H_LF
+#include <Eigen/Dense>
+#include <vector>
+#include <cstdint>
+#include "pose.h"
+#include "continuum_robot.h"
+
+namespace mmath{
+namespace continuum{
+
+/**
+ * @brief The status returned by ContinuumIkSolver::solve().
+ */
+enum class IkStatus : uint8_t
+{
+    CONVERGED,      //!< The errors are within the tolerances.
+    MAX_ITERATION,  //!< The maximum number of iterations is reached.
+    TIMEOUT,        //!< The time budget is used up.
+    STALLED,        //!< No further decrease of the error can be made.
+    INVALID         //!< The robot has more joint variables than MAX_DOF.
+};
+
+
+/**
+ * @brief A damped-least-squares (DLS) inverse kinematics solver for a
+ * ContinuumRobot.
+ *
+ * @details Each iteration solves 
+ *   dq = J^T * (J*J^T + lambda^2*I)^-1 * e
+ * with the 6xN chain Jacobian J and the 6D pose error e, where lambda is 
+ * adapted in the Levenberg-Marquardt manner: decreased after a successful 
+ * step, increased after a rejected step. The updated theta and L are clamped
+ * into their limits.
+ *
+ * The solver works on the configuration of the robot in place, thus the
+ * previous solution is the warm start of the next call. All the workspaces
+ * are allocated in the constructor, solve() never allocates memory.
+ */
+class ContinuumIkSolver
+{
+public:
+    /** The maximum number of joint variables supported by the solver. */
+    static constexpr int MAX_DOF = 18;
+
+
+    /**
+     * @brief Construct a new ContinuumIkSolver object.
+     *
+     * @param robot  The robot to be solved, which should outlive the solver.
+     * @param is_variable_length  Whether the length of each segment is a joint
+     *                            variable.
+     */
+    explicit ContinuumIkSolver(ContinuumRobot& robot,
+                               bool is_variable_length = false);
+
+
+    /**
+     * @brief Set the joint limits of the i-th segment.
+     *
+     * @param [in] i          The index of the segment, start from 0.
+     * @param [in] theta_min  The lower limit of the bending angle.
+     * @param [in] theta_max  The upper limit of the bending angle.
+     * @param [in] L_min      The lower limit of the length, only used for a
+     *                        variable length.
+     * @param [in] L_max      The upper limit of the length, only used for a
+     *                        variable length.
+     */
+    void setLimits(std::size_t i, kfloat theta_min, kfloat theta_max,
+                   kfloat L_min = 0, kfloat L_max = 1e9);
+
+
+    /**
+     * @brief Set the tolerances for convergence.
+     *
+     * @param [in] position     The tolerance of the position error.
+     * @param [in] orientation  The tolerance of the orientation error, in
+     *                          radian.
+     */
+    void setTolerance(kfloat position, kfloat orientation);
+
+
+    /**
+     * @brief Set the budget of each solve().
+     *
+     * @param [in] max_iteration  The maximum number of iterations.
+     * @param [in] max_time_ms    The maximum time in milliseconds, a
+     *                            non-positive value disables the time budget.
+     */
+    void setBudget(int max_iteration, float max_time_ms = 0);
+
+
+    /**
+     * @brief Set the range of the adaptive damping factor lambda.
+     *
+     * @param [in] init  The initial damping factor for each solve().
+     * @param [in] min   The minimum damping factor.
+     * @param [in] max   The maximum damping factor, the solver stalls if a 
+     *                   step is still rejected with this damping factor.
+     */
+    void setDamping(kfloat init, kfloat min, kfloat max);
+
+
+    /**
+     * @brief Set the weight of the orientation error relative to the
+     * position error. A zero weight solves the position only, where the
+     * orientation tolerance is ignored.
+     *
+     * @param [in] weight  The weight, which should be non-negative.
+     *
+     * @return false if the weight is negative or NaN, which is not applied.
+     */
+    bool setOrientationWeight(kfloat weight);
+
+
+    /**
+     * @brief Return whether the robot fits in the solver, i.e., it has at
+     * most MAX_DOF joint variables. Otherwise solve() returns
+     * IkStatus::INVALID without touching the robot.
+     */
+    bool isValid() const;
+
+
+    /**
+     * @brief Solve the configuration that the end pose of the robot reaches
+     * the target, starting from the current configuration of the robot.
+     *
+     * @param [in] target  The target end pose w.r.t the world.
+     *
+     * @return The status of the solution, the configuration of the robot is
+     * always updated to the best solution found.
+     */
+    IkStatus solve(const Pose& target);
+
+
+    /**
+     * @brief Return the number of iterations of the last solve().
+     */
+    int iterations() const;
+
+
+    /**
+     * @brief Return the position error of the last solve().
+     */
+    kfloat positionError() const;
+
+
+    /**
+     * @brief Return the orientation error of the last solve(), in radian.
+     */
+    kfloat orientationError() const;
+
+private:
+    using Vector6 = Eigen::Vector<kfloat, 6>;
+    using VectorQ = Eigen::Matrix<kfloat, Eigen::Dynamic, 1, 0, MAX_DOF, 1>;
+
+    void calcError(const Pose& target, Vector6& e) const;
+    void applyStep(const VectorQ& dq);
+
+    ContinuumRobot&         _robot;
+    bool                    _is_variable_length;
+    bool                    _is_valid;
+    std::vector<kfloat>     _theta_min, _theta_max;
+    std::vector<kfloat>     _L_min, _L_max;
+    std::vector<ConfigSpc>  _q_backup;
+    ChainJacobian<MAX_DOF>  _J;
+
+    kfloat  _tol_position, _tol_orientation;
+    int     _max_iteration;
+    float   _max_time_ms;
+    kfloat  _lambda_init, _lambda_min, _lambda_max;
+    kfloat  _w_orientation;
+
+    int     _iterations;
+    kfloat  _err_position, _err_orientation;
+};
+
+}} // mmath::continuum
+#endif // LIB_MATH_CONTINUUM_IK_H_LF
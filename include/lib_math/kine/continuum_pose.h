@@ -22,6 +22,9 @@
  * --------------------------------------------------------------------
  * Change History:                        
  * 
+ * 2026/10/16 Template the functions on the scalar type.
+ * 2026/10/16 Take the branch-free terms of theta near zero.
+ * 
  * -------------------------------------------------------------------*/
 #ifndef LIB_MATH_CONTINUUM_POSE_H_LF
 #define LIB_MATH_CONTINUUM_POSE_H_LF
@@ -47,7 +50,9 @@ namespace continuum{
  * 
  * @see mmath::Pose.
  */
-void calcSingleSegmentPose(kfloat L, kfloat theta, kfloat delta, Pose &pose);
+template<typename Scalar>
+void calcSingleSegmentPose(NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+                           NonDeduced<Scalar> delta, PoseT<Scalar> &pose);
 
 
 /**
@@ -67,7 +72,10 @@ void calcSingleSegmentPose(kfloat L, kfloat theta, kfloat delta, Pose &pose);
  * 
  * @see mmath::Pose.
  */
-Pose calcSingleSegmentPose(kfloat L, kfloat theta, kfloat delta);
+template<typename Scalar = kfloat>
+PoseT<Scalar> calcSingleSegmentPose(NonDeduced<Scalar> L,
+                                    NonDeduced<Scalar> theta,
+                                    NonDeduced<Scalar> delta);
 
 
 /**
@@ -85,7 +93,8 @@ Pose calcSingleSegmentPose(kfloat L, kfloat theta, kfloat delta);
  * 
  * @see mmath::Pose, mmath::continuum::ConfigSpc
  */
-void calcSingleSegmentPose(const ConfigSpc &q, Pose &pose);
+template<typename Scalar>
+void calcSingleSegmentPose(const ConfigSpcT<Scalar> &q, PoseT<Scalar> &pose);
 
 
 /**
@@ -103,7 +112,8 @@ void calcSingleSegmentPose(const ConfigSpc &q, Pose &pose);
  * 
  * @see mmath::Pose, mmath::continuum::ConfigSpc
  */
-Pose calcSingleSegmentPose(const ConfigSpc& q);
+template<typename Scalar>
+PoseT<Scalar> calcSingleSegmentPose(const ConfigSpcT<Scalar>& q);
 
 
 
@@ -122,8 +132,11 @@ Pose calcSingleSegmentPose(const ConfigSpc& q);
  * 
  * @see mmath::Pose
  */
-void calcSingleWithRigidSegmentPose(kfloat L, kfloat theta, kfloat delta,
-                                    kfloat Lr, Pose &pose);
+template<typename Scalar>
+void calcSingleWithRigidSegmentPose(NonDeduced<Scalar> L,
+                                    NonDeduced<Scalar> theta,
+                                    NonDeduced<Scalar> delta,
+                                    NonDeduced<Scalar> Lr, PoseT<Scalar> &pose);
 
 
 /** 
@@ -145,8 +158,10 @@ void calcSingleWithRigidSegmentPose(kfloat L, kfloat theta, kfloat delta,
  * 
  * @see mmath::Pose
  */
-Pose calcSingleWithRigidSegmentPose(kfloat L, kfloat theta, kfloat delta,
-                                    kfloat Lr);
+template<typename Scalar = kfloat>
+PoseT<Scalar> calcSingleWithRigidSegmentPose(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr);
 
 
 /** 
@@ -165,7 +180,9 @@ Pose calcSingleWithRigidSegmentPose(kfloat L, kfloat theta, kfloat delta,
  * 
  * @see mmath::Pose, mmath::continuum::ConfigSpc
  */
-void calcSingleWithRigidSegmentPose(const ConfigSpc &q, kfloat Lr, Pose &pose);
+template<typename Scalar>
+void calcSingleWithRigidSegmentPose(const ConfigSpcT<Scalar> &q,
+                                    NonDeduced<Scalar> Lr, PoseT<Scalar> &pose);
 
 
 /**
@@ -185,7 +202,9 @@ void calcSingleWithRigidSegmentPose(const ConfigSpc &q, kfloat Lr, Pose &pose);
  * 
  * @see mmath::Pose, mmath::continuum::ConfigSpc
  */
-Pose calcSingleWithRigidSegmentPose(const ConfigSpc &q, kfloat Lr);
+template<typename Scalar>
+PoseT<Scalar> calcSingleWithRigidSegmentPose(
+        const ConfigSpcT<Scalar> &q, NonDeduced<Scalar> Lr);
 
 
 }} // mmath::continuum
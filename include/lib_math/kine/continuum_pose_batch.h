@@ -0,0 +1,104 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		continuum_pose_batch.h
+ * 
+ * @brief 		Batched interfaces for continuum segment kinematics, which
+ *          	evaluate many segments in structure-of-arrays layout.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * 2026/10/16 Template the functions on the scalar type.
+ * 2026/10/16 Take the branch-free terms of theta.
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_CONTINUUM_POSE_BATCH_H_LF
+#define LIB_MATH_CONTINUUM_POSE_BATCH_H_LF
+#include <cstddef>
+#include "../math_precision.h"
+
+namespace mmath{
+namespace continuum{
+
+/**
+ * @brief Calculating the end poses of a batch of single continuum segments
+ * with respect to their base frames.
+ *
+ * @details The inputs are given in structure-of-arrays layout and the batch is
+ * evaluated in blocks, where sin/cos of each block are evaluated by the 
+ * vectorized array functions of Eigen. The terms of theta near zero are
+ * resolved by a per-lane selection instead of a branch, see
+ * mmath::continuum::calcSegmentThetaTerms().
+ * 
+ * The outputs are written contiguously, record by record:
+ *   R  --  num x 9 values, each record is a column-major 3x3 rotation matrix,
+ *          i.e., Eigen::Map<Eigen::Matrix<Scalar, 3, 3>>(R + 9*i).
+ *   t  --  num x 3 values, each record is a translation vector,
+ *          i.e., Eigen::Map<Eigen::Vector<Scalar, 3>>(t + 3*i).
+ *
+ * @note All the segments are treated as bending segments, which gives the same
+ * result as mmath::continuum::calcSingleSegmentPose(L, theta, delta, pose).
+ *
+ * @param [in] L      The lengths of the segments, an array with num values.
+ * @param [in] theta  The bending angles of the segments, an array with num 
+ *                    values.
+ * @param [in] delta  The bending directions of the segments, an array with num
+ *                    values.
+ * @param [in] num    The number of segments in the batch.
+ * @param [out] R     The rotation matrices of the end frames, an array with 
+ *                    9*num values.
+ * @param [out] t     The positions of the end frames, an array with 3*num
+ *                    values.
+ *
+ * @tparam Scalar     The floating-point type, float or double.
+ *
+ * @see mmath::continuum::calcSingleSegmentPose().
+ */
+template<typename Scalar>
+void calcSingleSegmentPoseBatch(const Scalar *L, const Scalar *theta,
+                                const Scalar *delta, std::size_t num,
+                                Scalar *R, Scalar *t);
+
+
+/**
+ * @brief Calculating the end poses of a batch of single continuum segments,
+ * which with a rigid segment, with respect to their base frames.
+ *
+ * @param [in] L      The lengths of the segments, an array with num values.
+ * @param [in] theta  The bending angles of the segments, an array with num 
+ *                    values.
+ * @param [in] delta  The bending directions of the segments, an array with num
+ *                    values.
+ * @param [in] Lr     The lengths of the rigid segments, an array with num 
+ *                    values.
+ * @param [in] num    The number of segments in the batch.
+ * @param [out] R     The rotation matrices of the end frames, an array with 
+ *                    9*num values.
+ * @param [out] t     The positions of the end frames, an array with 3*num
+ *                    values.
+ *
+ * @see mmath::continuum::calcSingleSegmentPoseBatch(),
+ * mmath::continuum::calcSingleWithRigidSegmentPose().
+ */
+template<typename Scalar>
+void calcSingleWithRigidSegmentPoseBatch(const Scalar *L, const Scalar *theta,
+                                         const Scalar *delta, const Scalar *Lr,
+                                         std::size_t num, Scalar *R, Scalar *t);
+
+}} // mmath::continuum
+#endif // LIB_MATH_CONTINUUM_POSE_BATCH_H_LF
@@ -0,0 +1,205 @@
+/**--------------------------------------------------------------------
+ *
+ *   				   Mathematics extension library
+ *
+ * Description:
+ * This file is part of lib_math. You can redistribute it and or modify
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ *
+ * @file 		continuum_pose_generic.h
+ *
+ * @brief 		Design the scalar-generic kernels of continuum segment
+ *              kinematics, which run on the forward-mode AD types.
+ *
+ * @author		Longfei Wang
+ *
+ * @date		2026/10/16
+ *
+ * @license		MIT
+ *
+ * Copyright (C) 2019-Now Longfei Wang.
+ *
+ * --------------------------------------------------------------------
+ * Change History:
+ *
+ * 2026/10/16 Share the Taylor series of continuum_terms.h.
+ *
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_CONTINUUM_POSE_GENERIC_H_LF
+#define LIB_MATH_CONTINUUM_POSE_GENERIC_H_LF
+#include <Eigen/Dense>
+#include <unsupported/Eigen/AutoDiff>
+#include <cmath>
+#include "continuum_terms.h"
+
+namespace mmath{
+namespace continuum{
+
+/**
+ * @brief Calculating the rotation and position of the end frame of a single
+ * continuum segment with a rigid segment, for a generic scalar type.
+ *
+ * @details Different from calcSingleWithRigidSegmentPose(), which is compiled
+ * only for float and double, this kernel is defined in the header and only
+ * requires sin, cos, abs, the arithmetic and the comparison with a constant,
+ * which are found by ADL. Thus it runs on Eigen::AutoDiffScalar or any
+ * dual-number type.
+ *
+ * @tparam Scalar  The scalar type.
+ * @param [in] L      The length of the segment.
+ * @param [in] theta  The bending angle of the segment.
+ * @param [in] delta  The bending direction of the segment.
+ * @param [in] Lr     The length of the rigid segment.
+ * @param [out] R     The end rotation w.r.t its base frame.
+ * @param [out] t     The end position w.r.t its base frame.
+ *
+ * @note Instead of the limit values, the Taylor series of (1 - cos)/theta and
+ * sin/theta are taken when theta is near zero, so that the derivatives carried
+ * by the scalar are still correct at theta = 0.
+ */
+template<typename Scalar>
+void calcSingleWithRigidSegmentPoseGeneric(
+        const Scalar &L, const Scalar &theta, const Scalar &delta,
+        const Scalar &Lr, Eigen::Matrix<Scalar, 3, 3> &R,
+        Eigen::Vector<Scalar, 3> &t)
+{
+    using std::sin;
+    using std::cos;
+    using std::abs;
+
+    const Scalar st = sin(theta), ct = cos(theta);
+    const Scalar sd = sin(delta), cd = cos(delta);
+
+    Scalar omc, f1, f2;
+    if (abs(theta) < SEGMENT_SERIES_THETA) {
+        const Scalar theta2 = theta * theta;
+        f1 = theta * internal::evalSeries(theta2, internal::F1_SERIES);
+        f2 = internal::evalSeries(theta2, internal::F2_SERIES);
+        omc = theta * f1;
+    }
+    else {
+        omc = Scalar(1) - ct;
+        f1 = omc / theta;
+        f2 = st / theta;
+    }
+
+    const Scalar sdcd = sd * cd;
+    R << Scalar(1) - cd*cd*omc, -sdcd*omc, cd*st,
+            -sdcd*omc, Scalar(1) - sd*sd*omc, sd*st,
+            -cd*st, -sd*st, ct;
+    const Scalar k = L*f1 + Lr*st;
+    t << cd*k, sd*k, L*f2 + Lr*ct;
+}
+
+
+/**
+ * @brief Calculating the rotation and position of the end frame of a single
+ * continuum segment, for a generic scalar type.
+ *
+ * @remark This is an overloaded function, provided for convenience.
+ *
+ * @tparam Scalar  The scalar type.
+ * @param [in] L      The length of the segment.
+ * @param [in] theta  The bending angle of the segment.
+ * @param [in] delta  The bending direction of the segment.
+ * @param [out] R     The end rotation w.r.t its base frame.
+ * @param [out] t     The end position w.r.t its base frame.
+ *
+ * @see mmath::continuum::calcSingleWithRigidSegmentPoseGeneric().
+ */
+template<typename Scalar>
+void calcSingleSegmentPoseGeneric(
+        const Scalar &L, const Scalar &theta, const Scalar &delta,
+        Eigen::Matrix<Scalar, 3, 3> &R, Eigen::Vector<Scalar, 3> &t)
+{
+    calcSingleWithRigidSegmentPoseGeneric(L, theta, delta, Scalar(0), R, t);
+}
+
+
+/**
+ * @brief Calculate the Jacobian w.r.t Velocity and Angular-Velocity of a
+ * segment model by the forward-mode AD.
+ *
+ * @details The kernel is evaluated once on Eigen::AutoDiffScalar with N fixed
+ * derivatives, so no heap memory is used. The i-th columns are
+ *   Jv(:, i) = dt/dq_i,  Jw(:, i) = vee(dR/dq_i * R^T),
+ * which are the same as the hand-written calc*Jacobian() functions.
+ *
+ * @tparam Scalar  The floating-point type, float or double.
+ * @tparam N       The number of variables.
+ * @tparam Kernel  The segment model, callable as kernel(q, R, t), where q is
+ *                 Eigen::Vector<AD, N>, R is Eigen::Matrix<AD, 3, 3> and t is
+ *                 Eigen::Vector<AD, 3>, with AD the type of AutoDiffScalar.
+ * @param [in] kernel  The segment model.
+ * @param [in] q       The variables.
+ * @param [out] Jv     The Jacobian w.r.t Velocity.
+ * @param [out] Jw     The Jacobian w.r.t Angular-Velocity.
+ */
+template<typename Scalar, int N, typename Kernel>
+void calcSegmentJacobianAD(Kernel &&kernel, const Eigen::Vector<Scalar, N> &q,
+                           Eigen::Matrix<Scalar, 3, N> &Jv,
+                           Eigen::Matrix<Scalar, 3, N> &Jw)
+{
+    using AD = Eigen::AutoDiffScalar<Eigen::Vector<Scalar, N>>;
+    Eigen::Vector<AD, N> q_ad;
+    for(int i = 0; i < N; i++) {
+        q_ad[i] = AD(q[i], N, i);
+    }
+    Eigen::Matrix<AD, 3, 3> R;
+    Eigen::Vector<AD, 3> t;
+    kernel(q_ad, R, t);
+
+    Eigen::Matrix<Scalar, 3, 3> R_val;
+    for(int r = 0; r < 3; r++) {
+        for(int c = 0; c < 3; c++) {
+            R_val(r, c) = R(r, c).value();
+        }
+    }
+    for(int i = 0; i < N; i++) {
+        Eigen::Matrix<Scalar, 3, 3> dR;
+        for(int r = 0; r < 3; r++) {
+            Jv(r, i) = t[r].derivatives()[i];
+            for(int c = 0; c < 3; c++) {
+                dR(r, c) = R(r, c).derivatives()[i];
+            }
+        }
+        Eigen::Matrix<Scalar, 3, 3> W = dR * R_val.transpose();
+        Jw.col(i) = Eigen::Vector<Scalar, 3>(W(2, 1), W(0, 2), W(1, 0));
+    }
+}
+
+
+/**
+ * @brief Calculate the Jabobian of a single segment tha has a variable length
+ *        and followed by a rigid segment, w.r.t Velocity and Angular-Velocity,
+ *        by the forward-mode AD.
+ *
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] L      The length of the segment.
+ * @param [in] theta  The bending angle of the segment.
+ * @param [in] delta  The bending direction of the segment.
+ * @param [in] Lr     The length of the rigid segment.
+ * @param [out] Jv    The returned Jacobian w.r.t Velocity, with
+ *                    [Jv_theta(:), Jv_delta(:), Jv_L(:)].
+ * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with
+ *                    [Jw_theta(:), Jw_delta(:), Jw_L(:)].
+ *
+ * @see mmath::continuum::calcVariableLengthWithRigidSegmentJacobian().
+ */
+template<typename Scalar>
+void calcVariableLengthWithRigidSegmentJacobianAD(
+        Scalar L, Scalar theta, Scalar delta, Scalar Lr,
+        Eigen::Matrix<Scalar, 3, 3> &Jv, Eigen::Matrix<Scalar, 3, 3> &Jw)
+{
+    using AD = Eigen::AutoDiffScalar<Eigen::Vector<Scalar, 3>>;
+    calcSegmentJacobianAD<Scalar, 3>(
+                [Lr](const Eigen::Vector<AD, 3> &q,
+                     Eigen::Matrix<AD, 3, 3> &R, Eigen::Vector<AD, 3> &t) {
+        calcSingleWithRigidSegmentPoseGeneric<AD>(q[2], q[0], q[1], AD(Lr),
+                                                   R, t);
+    }, Eigen::Vector<Scalar, 3>(theta, delta, L), Jv, Jw);
+}
+
+}} // mmath::continuum
+#endif // LIB_MATH_CONTINUUM_POSE_GENERIC_H_LF
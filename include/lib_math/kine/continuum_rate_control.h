@@ -0,0 +1,195 @@
+/**--------------------------------------------------------------------
+ *
+ *   				   Mathematics extension library
+ *
+ * Description:
+ * This file is part of lib_math. You can redistribute it and or modify
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ *
+ * @file 		continuum_rate_control.h
+ *
+ * @brief 		Design the resolved-rate motion controller of a continuum
+ *              segment, with a fixed cost per step.
+ *
+ * @author		Longfei Wang
+ *
+ * @date		2026/10/16
+ *
+ * @license		MIT
+ *
+ * Copyright (C) 2019-Now Longfei Wang.
+ *
+ * --------------------------------------------------------------------
+ * Change History:
+ *
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_CONTINUUM_RATE_CONTROL_H_LF
+#define LIB_MATH_CONTINUUM_RATE_CONTROL_H_LF
+#include <Eigen/Dense>
+#include "continuum_configspc.h"
+#include "singularity_monitor.h"
+
+namespace mmath{
+namespace continuum{
+
+/**
+ * @brief A resolved-rate motion controller, which turns a desired twist of
+ * the end frame of a single segment with a rigid segment into the rates of
+ * its configuration.
+ *
+ * @details Each step takes the 6xN Jacobian J = [Jv; w*Jw] by
+ * calcSingleWithRigidSegmentJacobian() (N = 2) or
+ * calcVariableLengthWithRigidSegmentJacobian() (N = 3), and solves the damped
+ * pseudo-inverse
+ *   dq = (J^T*J + lambda^2*I)^-1 * J^T * x,
+ * where x = [v; w*omega] is the weighted twist. The damping is zero while the
+ * minimum singular value sigma_min of J is above the threshold epsilon, and
+ * grows as lambda^2 = lambda_max^2 * (1 - (sigma_min/epsilon)^2) below it,
+ * e.g., as theta approaches 0 where the delta column of J vanishes.
+ *
+ * The rates are then saturated: the rates that would pass the joint limits
+ * within dt are cut at the limits, and the vector of the rates is scaled down
+ * uniformly so that each rate is within its limit, which keeps the direction
+ * of the motion.
+ *
+ * All the matrices are fixed-size, and each step runs the same sequence of
+ * operations without iterations or memory allocation, thus the execution time
+ * per step is bounded and nearly constant.
+ *
+ * @tparam Scalar  The floating-point type, float or double.
+ */
+template<typename Scalar>
+class ResolvedRateControllerT
+{
+public:
+    using Vector6 = Eigen::Vector<Scalar, 6>;
+
+
+    /**
+     * @brief Construct a new ResolvedRateController object.
+     *
+     * @param Lr  The length of the rigid segment.
+     * @param is_variable_length  Whether the length of the segment is a joint
+     *                            variable.
+     */
+    explicit ResolvedRateControllerT(Scalar Lr = 0,
+                                     bool is_variable_length = false);
+
+
+    /**
+     * @brief Set the damping of the pseudo-inverse.
+     *
+     * @param [in] lambda_max  The damping factor at sigma_min = 0.
+     * @param [in] epsilon     The sigma_min below which the damping applies.
+     */
+    void setDamping(Scalar lambda_max, Scalar epsilon);
+
+
+    /**
+     * @brief Set the weight of the angular velocity relative to the velocity,
+     * which has the unit of a length. A zero weight tracks the velocity only.
+     */
+    void setOrientationWeight(Scalar weight);
+
+
+    /**
+     * @brief Set the limits of the absolute rates, where a non-positive value
+     * disables a limit.
+     *
+     * @param [in] theta_rate   The limit of the rate of theta.
+     * @param [in] delta_rate   The limit of the rate of delta.
+     * @param [in] length_rate  The limit of the rate of the length.
+     */
+    void setRateLimits(Scalar theta_rate, Scalar delta_rate,
+                       Scalar length_rate = 0);
+
+
+    /**
+     * @brief Set the joint limits, which are applied with the dt of
+     * calcRate(). The bending angle is limited in [-pi, pi] by default.
+     *
+     * @param [in] theta_min  The lower limit of the bending angle.
+     * @param [in] theta_max  The upper limit of the bending angle.
+     * @param [in] L_min      The lower limit of the length, only used for a
+     *                        variable length.
+     * @param [in] L_max      The upper limit of the length, only used for a
+     *                        variable length.
+     */
+    void setJointLimits(Scalar theta_min, Scalar theta_max, Scalar L_min = 0,
+                        Scalar L_max = Scalar(1e9));
+
+
+    /**
+     * @brief Calculate the rates of the configuration for a desired twist.
+     *
+     * @param [in] q      The current configuration.
+     * @param [in] twist  The desired twist [v; omega] of the end frame w.r.t
+     *                    the base frame of the segment.
+     * @param [in] dt     The period of the controller, which is used to keep
+     *                    the configuration within the joint limits, a
+     *                    non-positive value ignores the joint limits.
+     * @param [out] rate  The rates, where theta, delta and length store the
+     *                    rates of them, and is_bend is copied from q. The
+     *                    rate of the length is zero for a fixed length.
+     */
+    void calcRate(const ConfigSpcT<Scalar>& q, const Vector6& twist, Scalar dt,
+                  ConfigSpcT<Scalar>& rate);
+
+
+    /**
+     * @brief Calculate the rates by calcRate() and integrate them into the
+     * configuration by one period.
+     *
+     * @param [in,out] q  The configuration to be updated.
+     * @param [in] twist  The desired twist, see calcRate().
+     * @param [in] dt     The period of the controller.
+     */
+    void step(ConfigSpcT<Scalar>& q, const Vector6& twist, Scalar dt);
+
+
+    /**
+     * @brief Return the singularity measure of the weighted Jacobian in the
+     * last step.
+     */
+    const SingularityMeasureT<Scalar>& measure() const;
+
+
+    /**
+     * @brief Return the damping factor applied in the last step.
+     */
+    Scalar damping() const;
+
+
+    /**
+     * @brief Return the scale applied to the rates by the saturation in the
+     * last step, which is 1 if not saturated.
+     */
+    Scalar saturation() const;
+
+private:
+    template<int N>
+    void solve(const ConfigSpcT<Scalar>& q, const Vector6& twist,
+               Eigen::Vector<Scalar, N>& dq);
+
+    Scalar  _Lr;
+    bool    _is_variable_length;
+    Scalar  _lambda_max, _epsilon;
+    Scalar  _w_orientation;
+    Scalar  _rate_limit[3];
+    Scalar  _theta_min, _theta_max, _L_min, _L_max;
+
+    SingularityMeasureT<Scalar> _measure;
+    Scalar  _lambda;
+    Scalar  _saturation;
+};
+
+
+extern template class ResolvedRateControllerT<float>;
+extern template class ResolvedRateControllerT<double>;
+
+/** The ResolvedRateController with the precision controlled by LIB_MATH_USE_DOUBLE. */
+using ResolvedRateController = ResolvedRateControllerT<kfloat>;
+
+}} // mmath::continuum
+#endif // LIB_MATH_CONTINUUM_RATE_CONTROL_H_LF
@@ -0,0 +1,311 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		continuum_robot.h
+ * 
+ * @brief 		Define a multi-segment continuum robot, whose forward
+ *          	kinematics are composed segment by segment.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * 2026/10/16 Add the Jacobian w.r.t the lengths of the backbones.
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_CONTINUUM_ROBOT_H_LF
+#define LIB_MATH_CONTINUUM_ROBOT_H_LF
+#include <Eigen/Dense>
+#include <vector>
+#include <cstdint>
+#include "pose.h"
+#include "continuum_configspc.h"
+#include "continuum_actuation.h"
+
+namespace mmath{
+namespace continuum{
+
+/**
+ * @brief The 6xN Jacobian of a chain, with the first three rows w.r.t Velocity
+ * and the last three rows w.r.t Angular-Velocity.
+ *
+ * @details The storage is fixed with at most MaxCols columns, thus resizing it
+ * within the capacity never allocates memory.
+ *
+ * @tparam MaxCols  The capacity of columns.
+ */
+template<int MaxCols>
+using ChainJacobian =
+    Eigen::Matrix<kfloat, 6, Eigen::Dynamic, Eigen::ColMajor, 6, MaxCols>;
+
+
+/**
+ * @brief A class designed to describe a serial chain of continuum segments.
+ *
+ * @details Each segment is described by a ConfigSpc object and may be
+ * followed by a rigid segment with length Lr. The frames of the chain are
+ * indexed as:
+ *   frame(0)  --  the base frame of the robot.
+ *   frame(i)  --  the end frame of the i-th segment (including its rigid
+ *                 segment) w.r.t the world, i = 1, ..., segmentNum().
+ * All the frames are stored in a preallocated array and updated in place by
+ * calcForwardKinematics(), without any temporary Pose objects.
+ *
+ * The poses of the segments and the frames (the prefix products of the segment
+ * poses) are cached. The setters only mark the changed segments as dirty, and
+ * calcForwardKinematics() recomputes the dirty segments and the frames from the
+ * first dirty segment onward. Optionally, the Jacobians of each segment w.r.t
+ * its base frame are cached in the same way, see enableJacobianCache().
+ */
+class ContinuumRobot
+{
+public:
+    /**
+     * @brief Construct a new ContinuumRobot object.
+     *
+     * @param qs    The configurations of the segments, from base to tip.
+     * @param Lrs   The lengths of the rigid segments following each segment.
+     *              An empty vector specifies no rigid segment, otherwise the
+     *              size should be equal to qs.size().
+     * @param base  The pose of the robot base w.r.t the world.
+     */
+    explicit ContinuumRobot(const std::vector<ConfigSpc>& qs,
+                            const std::vector<kfloat>& Lrs = {},
+                            const Pose& base = Pose());
+
+
+    /**
+     * @brief Return the number of segments.
+     */
+    std::size_t segmentNum() const;
+
+
+    /**
+     * @brief Set the configuration of the i-th segment.
+     *
+     * @note The segment is marked as dirty only if the configuration is
+     * changed.
+     *
+     * @param [in] i  The index of the segment, start from 0.
+     * @param [in] q  The configuration.
+     */
+    void setConfig(std::size_t i, const ConfigSpc& q);
+
+
+    /**
+     * @brief Set the configurations of all the segments.
+     *
+     * @param [in] qs  The configurations, the size should be equal to
+     *                 segmentNum().
+     */
+    void setConfig(const std::vector<ConfigSpc>& qs);
+
+
+    /**
+     * @brief Return the configuration of the i-th segment.
+     */
+    const ConfigSpc& config(std::size_t i) const;
+
+
+    /**
+     * @brief Set the length of the rigid segment that follows the i-th
+     * segment.
+     *
+     * @param [in] i   The index of the segment, start from 0.
+     * @param [in] Lr  The length of the rigid segment.
+     */
+    void setRigidLength(std::size_t i, kfloat Lr);
+
+
+    /**
+     * @brief Return the length of the rigid segment that follows the i-th
+     * segment.
+     */
+    kfloat rigidLength(std::size_t i) const;
+
+
+    /**
+     * @brief Set the pose of the robot base w.r.t the world.
+     */
+    void setBasePose(const Pose& base);
+
+
+    /**
+     * @brief Enable/disable caching the Jacobians of each segment.
+     *
+     * @details If enabled, calcForwardKinematics() also updates the Jacobians
+     * of the dirty segments, together with the poses, by
+     * calcVariableLengthWithRigidSegmentPoseAndJacobian().
+     *
+     * @param [in] enable  The flag to enable the cache.
+     *
+     * @see segmentJv(), segmentJw().
+     */
+    void enableJacobianCache(bool enable = true);
+
+
+    /**
+     * @brief Return whether the Jacobians of each segment are cached.
+     */
+    bool isJacobianCacheEnabled() const;
+
+
+    /**
+     * @brief Mark all the segments as dirty, so that the next
+     * calcForwardKinematics() recomputes the whole chain.
+     */
+    void invalidate();
+
+
+    /**
+     * @brief Calculate the forward kinematics of the chain, where the poses of
+     * the dirty segments and the frames after the first dirty segment are
+     * updated in one pass.
+     */
+    void calcForwardKinematics();
+
+
+    /**
+     * @brief Return the pose of the i-th segment w.r.t its base frame, which is
+     * updated by calcForwardKinematics().
+     */
+    const Pose& segmentPose(std::size_t i) const;
+
+
+    /**
+     * @brief Return the number of columns of the Jacobian of the chain.
+     *
+     * @param [in] is_variable_length  Whether the length of each segment is a
+     *                                 joint variable.
+     */
+    std::size_t jacobianCols(bool is_variable_length = false) const;
+
+
+    /**
+     * @brief Calculate the 6xN Jacobian of the end frame of the chain w.r.t the
+     * world, with [Jv; Jw].
+     *
+     * @details The columns are ordered segment by segment, [theta_1, delta_1,
+     * (L_1), theta_2, delta_2, (L_2), ...]. The local Jacobian of each segment
+     * is rotated by the prefix rotation of its base frame, and the lever arm
+     * from the segment end to the end of the chain is added to the Velocity
+     * rows. The forward kinematics is updated first if any segment is dirty.
+     * No memory is allocated.
+     *
+     * @param [out] J  The Jacobian, the storage is owned by the caller, e.g.,
+     *                 a ChainJacobian object or a fixed-size matrix, and its
+     *                 number of columns should be equal to jacobianCols().
+     * @param [in] is_variable_length  Whether the length of each segment is a
+     *                                 joint variable.
+     *
+     * @see mmath::continuum::ChainJacobian, 
+     * mmath::continuum::calcVariableLengthWithRigidSegmentJacobian().
+     */
+    void calcJacobian(Eigen::Ref<Eigen::Matrix<kfloat, 6, Eigen::Dynamic>> J,
+                      bool is_variable_length = false);
+
+
+    /**
+     * @brief Return the number of columns of the Jacobian of the chain w.r.t
+     * the lengths of the backbones.
+     *
+     * @param [in] actuations  The actuation of each segment.
+     */
+    std::size_t actuationCols(
+            const std::vector<SegmentActuation>& actuations) const;
+
+
+    /**
+     * @brief Calculate the 6xN Jacobian of the end frame of the chain w.r.t the
+     * world and the lengths of the backbones, with [Jv; Jw].
+     *
+     * @details The columns are ordered segment by segment, [l_1_1, ...,
+     * l_1_N1, l_2_1, ...], where the lengths are segment-local. The local
+     * Jacobian of each segment is given by
+     * SegmentActuation::calcActuationJacobian(), and composed as
+     * calcJacobian(). No memory is allocated.
+     *
+     * @param [in] actuations  The actuation of each segment, the size should be
+     *                         equal to segmentNum().
+     * @param [out] J          The Jacobian, whose number of columns should be
+     *                         equal to actuationCols(actuations).
+     *
+     * @see mmath::continuum::SegmentActuationT::calcActuationJacobian().
+     */
+    void calcActuationJacobian(
+            const std::vector<SegmentActuation>& actuations,
+            Eigen::Ref<Eigen::Matrix<kfloat, 6, Eigen::Dynamic>> J);
+
+
+    /**
+     * @brief Return the cached Jacobian w.r.t Velocity of the i-th segment,
+     * with [Jv_theta(:), Jv_delta(:), Jv_L(:)] w.r.t the segment base frame.
+     *
+     * @note The value is available only if the Jacobian cache is enabled.
+     */
+    const Eigen::Matrix<kfloat, 3, 3>& segmentJv(std::size_t i) const;
+
+
+    /**
+     * @brief Return the cached Jacobian w.r.t Angular-Velocity of the i-th
+     * segment, with [Jw_theta(:), Jw_delta(:), Jw_L(:)] w.r.t the segment base
+     * frame.
+     *
+     * @note The value is available only if the Jacobian cache is enabled.
+     */
+    const Eigen::Matrix<kfloat, 3, 3>& segmentJw(std::size_t i) const;
+
+
+    /**
+     * @brief Return the i-th frame w.r.t the world, which is updated by
+     * calcForwardKinematics().
+     *
+     * @param [in] i  The index of the frame, where 0 denotes the base frame and
+     *                i denotes the end frame of the i-th segment.
+     */
+    const Pose& frame(std::size_t i) const;
+
+
+    /**
+     * @brief Return all the frames, with segmentNum() + 1 elements.
+     */
+    const std::vector<Pose>& frames() const;
+
+
+    /**
+     * @brief Return the end pose of the robot w.r.t the world, which is
+     * updated by calcForwardKinematics().
+     */
+    const Pose& endPose() const;
+
+private:
+    using Jacobian = Eigen::Matrix<kfloat, 3, 3>;
+
+    void markDirty(std::size_t i);
+
+    std::vector<ConfigSpc>  _qs;             //!< The segment configurations
+    std::vector<kfloat>     _Lrs;            //!< The rigid segment lengths
+    std::vector<Pose>       _segment_poses;  //!< The poses of each segment
+    std::vector<Pose>       _frames;         //!< The frames w.r.t the world
+    std::vector<Jacobian>   _Jvs;            //!< The cached Jv of each segment
+    std::vector<Jacobian>   _Jws;            //!< The cached Jw of each segment
+    std::vector<uint8_t>    _is_dirty;       //!< The dirty flag of each segment
+    std::size_t _first_dirty_frame;          //!< The first frame to be updated
+    bool        _is_jacobian_cached;         //!< The Jacobian cache flag
+};
+
+}} // mmath::continuum
+#endif // LIB_MATH_CONTINUUM_ROBOT_H_LF
@@ -0,0 +1,235 @@
+/**--------------------------------------------------------------------
+ *
+ *   				   Mathematics extension library
+ *
+ * Description:
+ * This file is part of lib_math. You can redistribute it and or modify
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ *
+ * @file 		continuum_terms.h
+ *
+ * @brief 		Design the branch-free kernels of the bending angle terms
+ *              shared by the continuum segment kinematics.
+ *
+ * @author		Longfei Wang
+ *
+ * @date		2026/10/16
+ *
+ * @license		MIT
+ *
+ * Copyright (C) 2019-Now Longfei Wang.
+ *
+ * --------------------------------------------------------------------
+ * Change History:
+ *
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_CONTINUUM_TERMS_H_LF
+#define LIB_MATH_CONTINUUM_TERMS_H_LF
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+
+namespace mmath{
+namespace continuum{
+
+/**
+ * @brief The range of theta, i.e., abs(theta) < SEGMENT_SERIES_THETA, where
+ * the terms are taken from their Taylor series.
+ */
+constexpr double SEGMENT_SERIES_THETA = 0.5;
+
+
+/**
+ * @brief The terms of the bending angle theta in the kinematics of a single
+ * segment, with f1 = (1 - cos(theta))/theta and f2 = sin(theta)/theta.
+ *
+ * @tparam T  float, double, or an Eigen::Array of them for a batch.
+ */
+template<typename T>
+struct SegmentThetaTerms
+{
+    T s;    //!< sin(theta)
+    T c;    //!< cos(theta)
+    T omc;  //!< 1 - cos(theta)
+    T f1;   //!< (1 - cos(theta))/theta
+    T f1_theta; //!< f1/theta, which is 1/2 at theta = 0
+    T f2;   //!< sin(theta)/theta
+    T df1;  //!< d(f1)/d(theta)
+    T df2;  //!< d(f2)/d(theta)
+};
+
+
+/**
+ * @brief The second derivatives of f1 and f2 to theta.
+ */
+template<typename T>
+struct SegmentThetaSecondTerms
+{
+    T ddf1; //!< d2(f1)/d(theta)2
+    T ddf2; //!< d2(f2)/d(theta)2
+};
+
+
+namespace internal {
+/** The operations on a scalar. */
+template<typename T>
+struct TermsTraits
+{
+    using Scalar = T;
+    static T sin(const T &x) { return std::sin(x); }
+    static T cos(const T &x) { return std::cos(x); }
+    static bool isSmall(const T &theta)
+    {
+        return std::abs(theta) < T(SEGMENT_SERIES_THETA);
+    }
+    static T select(bool mask, const T &a, const T &b)
+    {
+        return mask ? a : b;
+    }
+};
+
+
+/** The coefficient-wise operations on an Eigen::Array. */
+template<typename S, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+struct TermsTraits<Eigen::Array<S, Rows, Cols, Options, MaxRows, MaxCols>>
+{
+    using Scalar = S;
+    using T = Eigen::Array<S, Rows, Cols, Options, MaxRows, MaxCols>;
+    using Mask = Eigen::Array<bool, Rows, Cols, Options, MaxRows, MaxCols>;
+    static T sin(const T &x) { return x.sin(); }
+    static T cos(const T &x) { return x.cos(); }
+    static Mask isSmall(const T &theta)
+    {
+        return theta.abs() < S(SEGMENT_SERIES_THETA);
+    }
+    static T select(const Mask &mask, const T &a, const T &b)
+    {
+        return mask.select(a, b);
+    }
+};
+
+
+/** Evaluate c[0] + c[1]*x + ... + c[N-1]*x^(N-1) by Horner's rule. */
+template<typename T, std::size_t N>
+T evalSeries(const T &x, const double (&c)[N])
+{
+    static_assert(N >= 2, "At least two coefficients");
+    using Scalar = typename TermsTraits<T>::Scalar;
+    T r = x * Scalar(c[N - 1]) + Scalar(c[N - 2]);
+    for(std::size_t i = N - 2; i-- > 0;) {
+        r = r * x + Scalar(c[i]);
+    }
+    return r;
+}
+
+
+/**
+ * The Taylor coefficients in theta^2, which are truncated where the next term
+ * is below the double precision for abs(theta) < SEGMENT_SERIES_THETA.
+ */
+constexpr double F1_SERIES[] = {            // f1 / theta
+    1.0/2, -1.0/24, 1.0/720, -1.0/40320, 1.0/3628800, -1.0/479001600,
+    1.0/87178291200 };
+constexpr double F2_SERIES[] = {            // f2
+    1.0, -1.0/6, 1.0/120, -1.0/5040, 1.0/362880, -1.0/39916800,
+    1.0/6227020800, -1.0/1307674368000 };
+constexpr double DF1_SERIES[] = {           // df1
+    1.0/2, -1.0/8, 1.0/144, -1.0/5760, 1.0/403200, -1.0/43545600,
+    1.0/6706022400, -1.0/1394852659200 };
+constexpr double DF2_SERIES[] = {           // df2 / theta
+    -1.0/3, 1.0/30, -1.0/840, 1.0/45360, -1.0/3991680, 1.0/518918400,
+    -1.0/93405312000 };
+constexpr double DDF1_SERIES[] = {          // ddf1 / theta
+    -1.0/4, 1.0/36, -1.0/960, 1.0/50400, -1.0/4354560, 1.0/558835200,
+    -1.0/99632332800, 1.0/23538138624000 };
+constexpr double DDF2_SERIES[] = {          // ddf2
+    -1.0/3, 1.0/10, -1.0/168, 1.0/6480, -1.0/443520, 1.0/47174400,
+    -1.0/7185024000, 1.0/1482030950400 };
+}
+
+
+/**
+ * @brief Calculate the terms of theta without branches.
+ *
+ * @details Both the Taylor series and the closed forms are evaluated, and the
+ * series are selected for abs(theta) < SEGMENT_SERIES_THETA, where the closed
+ * forms such as (theta*cos(theta) - sin(theta))/theta^2 lose precision by
+ * cancellation. The closed forms are divided by 1 instead of theta in that
+ * range, so no inf or nan is produced at theta = 0. Since the lanes only
+ * differ by a selection, the batch of T = Eigen::Array is vectorized as well.
+ *
+ * @param [in] theta   The bending angle.
+ * @param [out] terms  The terms of theta.
+ */
+template<typename T>
+void calcSegmentThetaTerms(const T &theta, SegmentThetaTerms<T> &terms)
+{
+    using Traits = internal::TermsTraits<T>;
+    using Scalar = typename Traits::Scalar;
+    const auto is_small = Traits::isSmall(theta);
+    const T theta2 = theta * theta;
+    const T theta_safe = Traits::select(is_small, theta * Scalar(0) + Scalar(1),
+                                        theta);
+    const T inv_theta = Scalar(1) / theta_safe;
+    const T inv_theta2 = inv_theta * inv_theta;
+
+    terms.s = Traits::sin(theta);
+    terms.c = Traits::cos(theta);
+    const T f1_theta_series = internal::evalSeries(theta2,
+                                                   internal::F1_SERIES);
+    const T f1_series = theta * f1_theta_series;
+    terms.omc = Traits::select(is_small, theta * f1_series, Scalar(1) - terms.c);
+    terms.f1 = Traits::select(is_small, f1_series, terms.omc * inv_theta);
+    terms.f1_theta = Traits::select(is_small, f1_theta_series,
+                                    terms.omc * inv_theta2);
+    terms.f2 = Traits::select(
+                is_small, internal::evalSeries(theta2, internal::F2_SERIES),
+                terms.s * inv_theta);
+    terms.df1 = Traits::select(
+                is_small, internal::evalSeries(theta2, internal::DF1_SERIES),
+                (theta * terms.s - terms.omc) * inv_theta2);
+    terms.df2 = Traits::select(
+                is_small, theta * internal::evalSeries(theta2,
+                                                       internal::DF2_SERIES),
+                (theta * terms.c - terms.s) * inv_theta2);
+}
+
+
+/**
+ * @brief Calculate the second derivatives of f1 and f2 without branches.
+ *
+ * @param [in] theta   The bending angle.
+ * @param [in] terms   The terms of theta by calcSegmentThetaTerms().
+ * @param [out] terms2 The second derivatives.
+ *
+ * @see mmath::continuum::calcSegmentThetaTerms().
+ */
+template<typename T>
+void calcSegmentThetaSecondTerms(const T &theta,
+                                 const SegmentThetaTerms<T> &terms,
+                                 SegmentThetaSecondTerms<T> &terms2)
+{
+    using Traits = internal::TermsTraits<T>;
+    using Scalar = typename Traits::Scalar;
+    const auto is_small = Traits::isSmall(theta);
+    const T theta2 = theta * theta;
+    const T theta_safe = Traits::select(is_small, theta * Scalar(0) + Scalar(1),
+                                        theta);
+    const T inv_theta3 = Scalar(1) / (theta_safe * theta_safe * theta_safe);
+
+    terms2.ddf1 = Traits::select(
+                is_small, theta * internal::evalSeries(theta2,
+                                                       internal::DDF1_SERIES),
+                (theta2 * terms.c - Scalar(2) * theta * terms.s +
+                 Scalar(2) * terms.omc) *
+                inv_theta3);
+    terms2.ddf2 = Traits::select(
+                is_small, internal::evalSeries(theta2, internal::DDF2_SERIES),
+                (Scalar(2) * terms.s - Scalar(2) * theta * terms.c -
+                 theta2 * terms.s) *
+                inv_theta3);
+}
+
+}} // mmath::continuum
+#endif // LIB_MATH_CONTINUUM_TERMS_H_LF
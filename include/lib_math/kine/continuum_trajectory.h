@@ -0,0 +1,253 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		continuum_trajectory.h
+ * 
+ * @brief 		Define a versioned binary file format to record and replay
+ *          	the configurations and the end pose of a continuum robot.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_CONTINUUM_TRAJECTORY_H_LF
+#define LIB_MATH_CONTINUUM_TRAJECTORY_H_LF
+#include <Eigen/Dense>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include "pose.h"
+#include "continuum_configspc.h"
+
+namespace mmath{
+namespace continuum{
+
+/**
+ * @brief The header of a trajectory file.
+ *
+ * @details A trajectory file consists of this header followed by fixed-size
+ * records. Each record is laid out as:
+ *   double        --  the timestamp.
+ *   ConfigSpc[n]  --  n records of ConfigSpc, see ConfigSpc::toRecord().
+ *   Pose          --  the record of the end pose, see Pose::toRecord().
+ * All the values are stored in the native byte order.
+ */
+struct TrajectoryHeader
+{
+    char     magic[8];      //!< "LMTRAJ" padded with '\0'.
+    uint32_t version;       //!< The version of the format.
+    uint32_t scalar_size;   //!< sizeof(kfloat) of the writer.
+    uint32_t segment_num;   //!< The number of ConfigSpc in each record.
+    uint32_t record_size;   //!< The size of each record in bytes.
+    uint64_t reserved;      //!< Reserved, always 0.
+
+    /** The current version of the format. */
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @brief Return the size of a record with segment_num ConfigSpc.
+     */
+    static constexpr std::size_t recordSize(std::size_t segment_num)
+    {
+        return sizeof(double) + segment_num * ConfigSpc::RECORD_SIZE +
+                Pose::RECORD_SIZE;
+    }
+};
+static_assert(sizeof(TrajectoryHeader) == 32, "Unexpected padding");
+
+
+/**
+ * @brief A class designed to append records into a trajectory file.
+ *
+ * @details The file is opened once, then each record is composed in a
+ * preallocated buffer and appended by a buffered fwrite(), thus write() never
+ * allocates memory.
+ */
+class TrajectoryWriter
+{
+public:
+    /**
+     * @brief Construct a new TrajectoryWriter object and create the file.
+     *
+     * @param filename     The name of the file, which is overwritten if exists.
+     * @param segment_num  The number of ConfigSpc in each record.
+     */
+    TrajectoryWriter(const char* filename, std::size_t segment_num);
+    ~TrajectoryWriter();
+
+    TrajectoryWriter(const TrajectoryWriter&) = delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+
+    /**
+     * @brief Return true if the file is created successfully.
+     */
+    bool isOpen() const;
+
+
+    /**
+     * @brief Append a record.
+     *
+     * @remark This is the base of overloaded functions.
+     *
+     * @param [in] time  The timestamp.
+     * @param [in] qs    The array of segmentNum() configurations.
+     * @param [in] pose  The end pose.
+     *
+     * @return true if the record is written.
+     */
+    bool write(double time, const ConfigSpc* qs, const Pose& pose);
+
+
+    /**
+     * @brief Append a record.
+     *
+     * @remark This is an overloaded function, provided for convenience. It
+     * differs from the above function only in what argument(s) it accepts.
+     *
+     * @param [in] time  The timestamp.
+     * @param [in] qs    The configurations, whose size should be segmentNum().
+     * @param [in] pose  The end pose.
+     *
+     * @return true if the record is written.
+     */
+    bool write(double time, const std::vector<ConfigSpc>& qs, const Pose& pose);
+
+
+    /**
+     * @brief Flush the buffered records into the file.
+     */
+    void flush();
+
+
+    /**
+     * @brief Close the file. The file is closed automatically on destruction.
+     */
+    void close();
+
+
+    /**
+     * @brief Return the number of ConfigSpc in each record.
+     */
+    std::size_t segmentNum() const;
+
+
+    /**
+     * @brief Return the number of records written.
+     */
+    std::size_t recordNum() const;
+
+private:
+    FILE*               _file;
+    std::size_t         _segment_num;
+    std::size_t         _record_num;
+    std::vector<char>   _record;    //!< The buffer of a record.
+    std::vector<char>   _io_buffer; //!< The buffer of the stream.
+};
+
+
+
+/**
+ * @brief A class designed to read a trajectory file by memory mapping.
+ *
+ * @details The whole file is mapped into memory read-only, and the records
+ * are accessed in place. R() and t() return zero-copy views of the records.
+ *
+ * @note The files should be written with the same kfloat as the reader, 
+ * otherwise isOpen() returns false.
+ */
+class TrajectoryReader
+{
+public:
+    /** A read-only view of the rotation in a record. */
+    using RotationMap = Eigen::Map<const Eigen::Matrix<kfloat, 3, 3>>;
+    /** A read-only view of the translation in a record. */
+    using TranslationMap = Eigen::Map<const Eigen::Vector<kfloat, 3>>;
+
+
+    /**
+     * @brief Construct a new TrajectoryReader object and map the file.
+     *
+     * @param filename  The name of the file.
+     */
+    explicit TrajectoryReader(const char* filename);
+    ~TrajectoryReader();
+
+    TrajectoryReader(const TrajectoryReader&) = delete;
+    TrajectoryReader& operator=(const TrajectoryReader&) = delete;
+
+
+    /**
+     * @brief Return true if the file is mapped and its header is valid.
+     */
+    bool isOpen() const;
+
+
+    /**
+     * @brief Return the number of ConfigSpc in each record.
+     */
+    std::size_t segmentNum() const;
+
+
+    /**
+     * @brief Return the number of complete records in the file.
+     */
+    std::size_t recordNum() const;
+
+
+    /**
+     * @brief Return the timestamp of the i-th record.
+     */
+    double time(std::size_t i) const;
+
+
+    /**
+     * @brief Return the j-th configuration of the i-th record.
+     */
+    ConfigSpc config(std::size_t i, std::size_t j) const;
+
+
+    /**
+     * @brief Return the rotation of the i-th record, without copy.
+     */
+    RotationMap R(std::size_t i) const;
+
+
+    /**
+     * @brief Return the translation of the i-th record, without copy.
+     */
+    TranslationMap t(std::size_t i) const;
+
+
+    /**
+     * @brief Return the end pose of the i-th record.
+     */
+    Pose pose(std::size_t i) const;
+
+private:
+    const char* record(std::size_t i) const;
+
+    const char* _data;      //!< The mapped file.
+    std::size_t _size;      //!< The size of the mapped file.
+    std::size_t _segment_num;
+    std::size_t _record_size;
+    std::size_t _record_num;
+};
+
+}} // mmath::continuum
+#endif // LIB_MATH_CONTINUUM_TRAJECTORY_H_LF
@@ -0,0 +1,319 @@
+/**--------------------------------------------------------------------
+ *
+ *   				   Mathematics extension library
+ *
+ * Description:
+ * This file is part of lib_math. You can redistribute it and or modify
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ *
+ * @file 		continuum_workspace.h
+ *
+ * @brief 		Design the workspace sampling of continuum robots into a
+ *              sparse voxel map.
+ *
+ * @author		Longfei Wang
+ *
+ * @date		2026/10/16
+ *
+ * @license		MIT
+ *
+ * Copyright (C) 2019-Now Longfei Wang.
+ *
+ * --------------------------------------------------------------------
+ * Change History:
+ *
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_CONTINUUM_WORKSPACE_H_LF
+#define LIB_MATH_CONTINUUM_WORKSPACE_H_LF
+#include <Eigen/Dense>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "pose.h"
+
+namespace mmath{
+namespace continuum{
+
+/**
+ * @brief An axis of a configuration grid, which has the same values as
+ * mmath::linspaceN(start, end, num) but is never materialized.
+ */
+struct GridAxis
+{
+    double      start;  //!< The start value.
+    double      end;    //!< The end value.
+    std::size_t num;    //!< The number of values in [start, end].
+
+    /**
+     * @brief Return the i-th value of the axis.
+     */
+    double value(std::size_t i) const
+    {
+        if(num <= 1) return start;
+        if(i + 1 == num) return end;
+        return start + i * (end - start) / (num - 1);
+    }
+};
+
+
+/**
+ * @brief A class designed to iterate an N-D configuration grid lazily.
+ *
+ * @details The grid is the Cartesian product of the axes, where the first
+ * axis varies the fastest. A linear index is decoded into the values on
+ * demand, thus the grid costs no memory other than the axes.
+ */
+class ConfigGrid
+{
+public:
+    /**
+     * @brief Construct a new ConfigGrid object.
+     *
+     * @param axes  The axes, each of which has at least one value.
+     */
+    explicit ConfigGrid(const std::vector<GridAxis>& axes);
+
+
+    /**
+     * @brief Return the number of axes.
+     */
+    std::size_t dim() const;
+
+
+    /**
+     * @brief Return the number of grid points.
+     */
+    std::size_t size() const;
+
+
+    /**
+     * @brief Return the i-th axis.
+     */
+    const GridAxis& axis(std::size_t i) const;
+
+
+    /**
+     * @brief Decode the grid point of a linear index.
+     *
+     * @param [in] index  The linear index in [0, size()).
+     * @param [out] q     The dim() values of the grid point.
+     */
+    void at(std::size_t index, kfloat* q) const;
+
+private:
+    std::vector<GridAxis> _axes;
+    std::size_t           _size;
+};
+
+
+/**
+ * @brief The statistics of the poses fall into a voxel.
+ *
+ * @details The orientation is summarized by the component-wise bounds of the
+ * approach direction, i.e., the z-axis of the end frame, which bound the cone
+ * of the reachable directions.
+ */
+struct VoxelStats
+{
+    uint32_t        count = 0;      //!< The number of poses.
+    Eigen::Vector3f z_min;          //!< The min of the approach direction.
+    Eigen::Vector3f z_max;          //!< The max of the approach direction.
+
+    /**
+     * @brief Add an approach direction.
+     */
+    void add(const Eigen::Vector3f& z);
+
+
+    /**
+     * @brief Merge the statistics of another voxel.
+     */
+    void merge(const VoxelStats& other);
+};
+
+
+/**
+ * @brief The header of a voxel map file.
+ *
+ * @details A voxel map file consists of this header followed by voxel_num
+ * records. Each record is laid out as:
+ *   int32_t[3]  --  the index of the voxel.
+ *   uint32_t    --  VoxelStats::count.
+ *   float[3]    --  VoxelStats::z_min.
+ *   float[3]    --  VoxelStats::z_max.
+ * All the values are stored in the native byte order.
+ */
+struct VoxelMapHeader
+{
+    char     magic[8];      //!< "LMVOXEL" padded with '\0'.
+    uint32_t version;       //!< The version of the format.
+    uint32_t record_size;   //!< The size of each record in bytes.
+    uint64_t voxel_num;     //!< The number of records.
+    double   voxel_size;    //!< The edge length of the voxels.
+
+    /** The current version of the format. */
+    static constexpr uint32_t VERSION = 1;
+    /** The size of each record in bytes. */
+    static constexpr uint32_t RECORD_SIZE = 40;
+};
+static_assert(sizeof(VoxelMapHeader) == 32, "Unexpected padding");
+
+
+/**
+ * @brief A class designed to store the occupancy of a workspace in sparse
+ * cubic voxels.
+ *
+ * @details The voxel of a position p has the index floor(p / voxelSize()),
+ * and only the occupied voxels are stored, in a hash map keyed by the packed
+ * index. Each index component should be in [-2^20, 2^20).
+ */
+class VoxelMap
+{
+public:
+    /** The index of a voxel. */
+    using Index = Eigen::Vector3i;
+
+
+    /**
+     * @brief Construct a new VoxelMap object.
+     *
+     * @param voxel_size  The edge length of the voxels.
+     */
+    explicit VoxelMap(double voxel_size = 1);
+
+
+    /**
+     * @brief Return the edge length of the voxels.
+     */
+    double voxelSize() const;
+
+
+    /**
+     * @brief Return the number of occupied voxels.
+     */
+    std::size_t size() const;
+
+
+    /**
+     * @brief Remove all the voxels.
+     */
+    void clear();
+
+
+    /**
+     * @brief Return the index of the voxel that contains a position.
+     */
+    Index index(const Eigen::Vector3d& p) const;
+
+
+    /**
+     * @brief Return the center of a voxel.
+     */
+    Eigen::Vector3d center(const Index& index) const;
+
+
+    /**
+     * @brief Add a pose into the voxel that contains its position.
+     *
+     * @return false if the index of the voxel is out of [-2^20, 2^20), where
+     * the pose is dropped.
+     */
+    bool add(const Pose& pose);
+
+
+    /**
+     * @brief Merge the voxels of another map with the same voxel size.
+     */
+    void merge(const VoxelMap& other);
+
+
+    /**
+     * @brief Return the statistics of a voxel, or nullptr if it is empty or
+     * out of the range.
+     */
+    const VoxelStats* find(const Index& index) const;
+
+
+    /**
+     * @brief Return true if the voxel that contains a position is occupied.
+     */
+    bool isOccupied(const Eigen::Vector3d& p) const;
+
+
+    /**
+     * @brief Call func(index, stats) for each occupied voxel, in no order.
+     */
+    void forEach(
+        const std::function<void(const Index&, const VoxelStats&)>& func) const;
+
+
+    /**
+     * @brief Save the map into a binary file, see VoxelMapHeader.
+     *
+     * @return true if the file is written.
+     */
+    bool save(const char* filename) const;
+
+
+    /**
+     * @brief Load the map from a binary file, which replaces the current map.
+     *
+     * @return true if the file is valid and loaded. A file is invalid if it
+     * is shorter than its voxel_num records, or if it has an index out of
+     * [-2^20, 2^20). The map is unchanged if false is returned.
+     */
+    bool load(const char* filename);
+
+private:
+    double                                  _voxel_size;
+    std::unordered_map<uint64_t, VoxelStats> _voxels;
+};
+
+
+/**
+ * @brief The forward kinematics evaluated by sampleWorkspace(), which writes
+ * the end pose of the grid point q.
+ */
+using WorkspaceFK = std::function<void(const kfloat* q, Pose& pose)>;
+
+
+/**
+ * @brief Evaluate the forward kinematics over a configuration grid, and add
+ * the end poses into a voxel map.
+ *
+ * @details The grid points are decoded lazily. The threads take chunks of the
+ * linear indices from a shared counter, evaluate fk into their own maps, and
+ * the maps are merged at last. The result does not depend on thread_num, since
+ * the statistics are order independent.
+ *
+ * @param [in] grid        The configuration grid.
+ * @param [in] fk          The forward kinematics, which should be reentrant.
+ * @param [in,out] map     The voxel map that the poses are added into.
+ * @param [in] thread_num  The number of threads.
+ */
+void sampleWorkspace(const ConfigGrid& grid, const WorkspaceFK& fk,
+                     VoxelMap& map, int thread_num = 1);
+
+
+/**
+ * @brief Sample the workspace of a single continuum segment with a rigid
+ * segment over a [theta, delta, L] grid.
+ *
+ * @param [in] theta       The axis of the bending angle.
+ * @param [in] delta       The axis of the bending direction.
+ * @param [in] L           The axis of the length of the segment.
+ * @param [in] Lr          The length of the rigid segment.
+ * @param [in,out] map     The voxel map that the poses are added into.
+ * @param [in] thread_num  The number of threads.
+ *
+ * @see mmath::continuum::calcSingleWithRigidSegmentPose().
+ */
+void sampleSingleWithRigidSegmentWorkspace(
+        const GridAxis& theta, const GridAxis& delta, const GridAxis& L,
+        kfloat Lr, VoxelMap& map, int thread_num = 1);
+
+}} // mmath::continuum
+#endif // LIB_MATH_CONTINUUM_WORKSPACE_H_LF
@@ -23,6 +23,10 @@
  * --------------------------------------------------------------------
  * Change History:
  * 2022.11.30 Complete Jacobian for [Jv, Jw].
+ * 2026.10.16 Add fused kernels for pose and Jacobian.
+ * 2026.10.16 Template the functions on the scalar type.
+ * 2026.10.16 Add the second derivatives of pose, known as Hessian.
+ * 2026.10.16 Take the branch-free terms of theta near zero.
  * -------------------------------------------------------------------*/
 #ifndef LIB_MATH_DCONTINUUM_POSE_H_LF
 #define LIB_MATH_DCONTINUUM_POSE_H_LF
@@ -47,7 +51,9 @@ namespace continuum{
  * 
  * @see mmath::Pose.
  */
-void dSingleSegmentPose2theta(kfloat L, kfloat theta, kfloat delta, Pose &dpose);
+template<typename Scalar>
+void dSingleSegmentPose2theta(NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+                              NonDeduced<Scalar> delta, PoseT<Scalar> &dpose);
 
 
 /**
@@ -67,7 +73,10 @@ void dSingleSegmentPose2theta(kfloat L, kfloat theta, kfloat delta, Pose &dpose)
  * 
  * @see mmath::Pose.
  */
-Pose dSingleSegmentPose2theta(kfloat L, kfloat theta, kfloat delta);
+template<typename Scalar = kfloat>
+PoseT<Scalar> dSingleSegmentPose2theta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta);
 
 
 /**
@@ -83,7 +92,9 @@ Pose dSingleSegmentPose2theta(kfloat L, kfloat theta, kfloat delta);
  * 
  * @see mmath::Pose.
  */
-void dSingleSegmentPose2delta(kfloat L, kfloat theta, kfloat delta, Pose &dpose);
+template<typename Scalar>
+void dSingleSegmentPose2delta(NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+                              NonDeduced<Scalar> delta, PoseT<Scalar> &dpose);
 
 
 /**
@@ -101,7 +112,10 @@ void dSingleSegmentPose2delta(kfloat L, kfloat theta, kfloat delta, Pose &dpose)
  * 
  * @return The derivatives of pose to delta.
  */
-Pose dSingleSegmentPose2delta(kfloat L, kfloat theta, kfloat delta);
+template<typename Scalar = kfloat>
+PoseT<Scalar> dSingleSegmentPose2delta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta);
 
 
 /**
@@ -117,7 +131,9 @@ Pose dSingleSegmentPose2delta(kfloat L, kfloat theta, kfloat delta);
  * 
  * @see mmath::Pose.
  */
-void dSingleSegmentPose2L(kfloat L, kfloat theta, kfloat delta, Pose &dpose);
+template<typename Scalar>
+void dSingleSegmentPose2L(NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+                          NonDeduced<Scalar> delta, PoseT<Scalar> &dpose);
 
 
 /**
@@ -137,7 +153,10 @@ void dSingleSegmentPose2L(kfloat L, kfloat theta, kfloat delta, Pose &dpose);
  * 
  * @see mmath::Pose.
  */
-Pose dSingleSegmentPose2L(kfloat L, kfloat theta, kfloat delta);
+template<typename Scalar = kfloat>
+PoseT<Scalar> dSingleSegmentPose2L(NonDeduced<Scalar> L,
+                                   NonDeduced<Scalar> theta,
+                                   NonDeduced<Scalar> delta);
 
 
 /**
@@ -154,8 +173,10 @@ Pose dSingleSegmentPose2L(kfloat L, kfloat theta, kfloat delta);
  * 
  * @see mmath::Pose.
  */
-void dSingleWithRigidSegmentPose2theta(kfloat L, kfloat theta, kfloat delta,
-                                       kfloat Lr, Pose &dpose);
+template<typename Scalar>
+void dSingleWithRigidSegmentPose2theta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr, PoseT<Scalar> &dpose);
 
 
 /**
@@ -176,8 +197,10 @@ void dSingleWithRigidSegmentPose2theta(kfloat L, kfloat theta, kfloat delta,
  * 
  * @see mmath::Pose.
  */
-Pose dSingleWithRigidSegmentPose2theta(kfloat L, kfloat theta, kfloat delta,
-                                       kfloat Lr);
+template<typename Scalar = kfloat>
+PoseT<Scalar> dSingleWithRigidSegmentPose2theta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr);
 
 
 /**
@@ -194,8 +217,10 @@ Pose dSingleWithRigidSegmentPose2theta(kfloat L, kfloat theta, kfloat delta,
  * 
  * @see mmath::Pose.
  */
-void dSingleWithRigidSegmentPose2delta(kfloat L, kfloat theta, kfloat delta,
-                                       kfloat Lr, Pose &dpose);
+template<typename Scalar>
+void dSingleWithRigidSegmentPose2delta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr, PoseT<Scalar> &dpose);
 
 
 /**
@@ -216,8 +241,10 @@ void dSingleWithRigidSegmentPose2delta(kfloat L, kfloat theta, kfloat delta,
  * 
  * @see mmath::Pose.
  */
-Pose dSingleWithRigidSegmentPose2delta(kfloat L, kfloat theta, kfloat delta,
-                                       kfloat Lr);
+template<typename Scalar = kfloat>
+PoseT<Scalar> dSingleWithRigidSegmentPose2delta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr);
 
 
 /**
@@ -234,8 +261,11 @@ Pose dSingleWithRigidSegmentPose2delta(kfloat L, kfloat theta, kfloat delta,
  * 
  * @see mmath::Pose.
  */
-void dSingleWithRigidSegmentPose2L(kfloat L, kfloat theta, kfloat delta,
-                                   kfloat Lr, Pose &dpose);
+template<typename Scalar>
+void dSingleWithRigidSegmentPose2L(NonDeduced<Scalar> L,
+                                   NonDeduced<Scalar> theta,
+                                   NonDeduced<Scalar> delta,
+                                   NonDeduced<Scalar> Lr, PoseT<Scalar> &dpose);
 
 
 /**
@@ -256,8 +286,10 @@ void dSingleWithRigidSegmentPose2L(kfloat L, kfloat theta, kfloat delta,
  * 
  * @see mmath::Pose.
  */
-Pose dSingleWithRigidSegmentPose2L(kfloat L, kfloat theta, kfloat delta,
-                                   kfloat Lr);
+template<typename Scalar = kfloat>
+PoseT<Scalar> dSingleWithRigidSegmentPose2L(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr);
 
 
 /*---------------------------------------------------------------------------*/
@@ -277,9 +309,11 @@ Pose dSingleWithRigidSegmentPose2L(kfloat L, kfloat theta, kfloat delta,
  * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with 
  *                    [Jw_theta(:), Jw_delta(:)].
  */
-void calcSingleSegmentJacobian(
-        kfloat L, kfloat theta, kfloat delta,
-        Eigen::Matrix<kfloat, 3, 2>& Jv, Eigen::Matrix<kfloat, 3, 2>& Jw);
+template<typename Scalar>
+void calcSingleSegmentJacobian(NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+                               NonDeduced<Scalar> delta,
+                               Eigen::Matrix<Scalar, 3, 2>& Jv,
+                               Eigen::Matrix<Scalar, 3, 2>& Jw);
 
 
 /**
@@ -292,8 +326,10 @@ void calcSingleSegmentJacobian(
  * @param [out] Jw  The returned Jacobian w.r.t Angular-Velocity, with 
  *                  [Jw_theta(:), Jw_delta(:)].
  */
-void calcSingleSegmentJacobian(const ConfigSpc &q,
-        Eigen::Matrix<kfloat, 3, 2>& Jv, Eigen::Matrix<kfloat, 3, 2>& Jw);
+template<typename Scalar>
+void calcSingleSegmentJacobian(const ConfigSpcT<Scalar> &q,
+                               Eigen::Matrix<Scalar, 3, 2>& Jv,
+                               Eigen::Matrix<Scalar, 3, 2>& Jw);
 
 
 /**
@@ -308,9 +344,11 @@ void calcSingleSegmentJacobian(const ConfigSpc &q,
  * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with 
  *                    [Jw_theta(:), Jw_delta(:), Jw_L(:)].
  */
+template<typename Scalar>
 void calcVariableLengthSegmentJacobian(
-        kfloat L, kfloat theta, kfloat delta,
-        Eigen::Matrix<kfloat, 3, 3>& Jv, Eigen::Matrix<kfloat, 3, 3>& Jw);
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, Eigen::Matrix<Scalar, 3, 3>& Jv,
+        Eigen::Matrix<Scalar, 3, 3>& Jw);
 
 
 /**
@@ -323,8 +361,10 @@ void calcVariableLengthSegmentJacobian(
  * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with 
  *                    [Jw_theta(:), Jw_delta(:), Jw_L(:)].
  */
-void calcVariableLengthSegmentJacobian(const ConfigSpc &q,
-        Eigen::Matrix<kfloat, 3, 3>& Jv, Eigen::Matrix<kfloat, 3, 3>& Jw);
+template<typename Scalar>
+void calcVariableLengthSegmentJacobian(
+        const ConfigSpcT<Scalar> &q, Eigen::Matrix<Scalar, 3, 3>& Jv,
+        Eigen::Matrix<Scalar, 3, 3>& Jw);
 
 
 /**
@@ -340,9 +380,11 @@ void calcVariableLengthSegmentJacobian(const ConfigSpc &q,
  * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with 
  *                    [Jw_theta(:), Jw_delta(:)].
  */
+template<typename Scalar>
 void calcSingleWithRigidSegmentJacobian(
-        kfloat L, kfloat theta, kfloat delta, kfloat Lr,
-        Eigen::Matrix<kfloat, 3, 2>& Jv, Eigen::Matrix<kfloat, 3, 2>& Jw);
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr,
+        Eigen::Matrix<Scalar, 3, 2>& Jv, Eigen::Matrix<Scalar, 3, 2>& Jw);
 
 
 /**
@@ -356,8 +398,10 @@ void calcSingleWithRigidSegmentJacobian(
  * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with 
  *                    [Jw_theta(:), Jw_delta(:)].
  */
-void calcSingleWithRigidSegmentJacobian(const ConfigSpc &q, kfloat Lr,
-        Eigen::Matrix<kfloat, 3, 2>& Jv, Eigen::Matrix<kfloat, 3, 2>& Jw);
+template<typename Scalar>
+void calcSingleWithRigidSegmentJacobian(
+        const ConfigSpcT<Scalar> &q, NonDeduced<Scalar> Lr,
+        Eigen::Matrix<Scalar, 3, 2>& Jv, Eigen::Matrix<Scalar, 3, 2>& Jw);
 
 
 /**
@@ -373,9 +417,11 @@ void calcSingleWithRigidSegmentJacobian(const ConfigSpc &q, kfloat Lr,
  * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with 
  *                    [Jw_theta(:), Jw_delta(:), Jw_L(:)].
  */
+template<typename Scalar>
 void calcVariableLengthWithRigidSegmentJacobian(
-        kfloat L, kfloat theta, kfloat delta, kfloat Lr,
-        Eigen::Matrix<kfloat, 3, 3>& Jv, Eigen::Matrix<kfloat, 3, 3>& Jw);
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr,
+        Eigen::Matrix<Scalar, 3, 3>& Jv, Eigen::Matrix<Scalar, 3, 3>& Jw);
 
 
 /**
@@ -389,8 +435,247 @@ void calcVariableLengthWithRigidSegmentJacobian(
  * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with 
  *                    [Jw_theta(:), Jw_delta(:), Jw_L(:)].
  */
-void calcVariableLengthWithRigidSegmentJacobian(const ConfigSpc &q, kfloat Lr,
-        Eigen::Matrix<kfloat, 3, 3>& Jv, Eigen::Matrix<kfloat, 3, 3>& Jw);
+template<typename Scalar>
+void calcVariableLengthWithRigidSegmentJacobian(
+        const ConfigSpcT<Scalar> &q, NonDeduced<Scalar> Lr,
+        Eigen::Matrix<Scalar, 3, 3>& Jv, Eigen::Matrix<Scalar, 3, 3>& Jw);
+
+
+/*---------------------------------------------------------------------------*/
+/*            Calculate the Pose and the Jacobian in a fused kernel          */
+/*---------------------------------------------------------------------------*/
+
+
+/**
+ * @brief Calculate the end pose and the Jabobian of a single segment w.r.t
+ *        Velocity and Angular-Velocity, in one pass.
+ *
+ * @details The sin/cos of theta and delta are evaluated only once and shared
+ * by the pose, the Jacobian and the optional derivatives, which is cheaper
+ * than calling calcSingleSegmentPose() and calcSingleSegmentJacobian() in
+ * sequence.
+ *
+ * @remark This is the base of overloaded functions.
+ *
+ * @param [in] L      The length of the segment.
+ * @param [in] theta  The bending angle of the segment.
+ * @param [in] delta  The bending direction of the segment.
+ * @param [out] pose  The end pose of the segment w.r.t its base frame.
+ * @param [out] Jv    The returned Jacobian w.r.t Velocity, with 
+ *                    [Jv_theta(:), Jv_delta(:)].
+ * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with 
+ *                    [Jw_theta(:), Jw_delta(:)].
+ * @param [out] dpose2theta  The derivatives of pose to theta, skipped if null.
+ * @param [out] dpose2delta  The derivatives of pose to delta, skipped if null.
+ * @param [out] dpose2L      The derivatives of pose to L, skipped if null.
+ *
+ * @note The derivatives take the limit values when theta is near zero, which
+ * are consistent with the Jacobian.
+ *
+ * @see mmath::continuum::calcSingleSegmentPose(),
+ * mmath::continuum::calcSingleSegmentJacobian(),
+ * mmath::continuum::dSingleSegmentPose2theta(),
+ * mmath::continuum::dSingleSegmentPose2delta(),
+ * mmath::continuum::dSingleSegmentPose2L().
+ */
+template<typename Scalar>
+void calcSingleSegmentPoseAndJacobian(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, PoseT<Scalar>& pose,
+        Eigen::Matrix<Scalar, 3, 2>& Jv, Eigen::Matrix<Scalar, 3, 2>& Jw,
+        PoseT<Scalar> *dpose2theta = nullptr,
+        PoseT<Scalar> *dpose2delta = nullptr, PoseT<Scalar> *dpose2L = nullptr);
+
+
+/**
+ * @brief Calculate the end pose and the Jabobian of a single segment w.r.t
+ *        Velocity and Angular-Velocity, in one pass.
+ *
+ * @remark This is an overloaded function, provided for convenience. It differs 
+ * from the base function only in what argument(s) it accepts.
+ *
+ * @param [in] q      A ConfiSpc object.
+ * @param [out] pose  The end pose of the segment w.r.t its base frame.
+ * @param [out] Jv    The returned Jacobian w.r.t Velocity, with 
+ *                    [Jv_theta(:), Jv_delta(:)].
+ * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with 
+ *                    [Jw_theta(:), Jw_delta(:)].
+ * @param [out] dpose2theta  The derivatives of pose to theta, skipped if null.
+ * @param [out] dpose2delta  The derivatives of pose to delta, skipped if null.
+ * @param [out] dpose2L      The derivatives of pose to L, skipped if null.
+ */
+template<typename Scalar>
+void calcSingleSegmentPoseAndJacobian(
+        const ConfigSpcT<Scalar> &q, PoseT<Scalar>& pose,
+        Eigen::Matrix<Scalar, 3, 2>& Jv, Eigen::Matrix<Scalar, 3, 2>& Jw,
+        PoseT<Scalar> *dpose2theta = nullptr,
+        PoseT<Scalar> *dpose2delta = nullptr, PoseT<Scalar> *dpose2L = nullptr);
+
+
+/**
+ * @brief Calculate the end pose and the Jabobian of a single segment tha has a
+ *        variable length and followed by a rigid segment, w.r.t Velocity and
+ *        Angular-Velocity, in one pass.
+ *
+ * @remark This is the base of overloaded functions.
+ *
+ * @param [in] L      The length of the segment.
+ * @param [in] theta  The bending angle of the segment.
+ * @param [in] delta  The bending direction of the segment.
+ * @param [in] Lr     The length of the rigid segment.
+ * @param [out] pose  The end pose of the segment w.r.t its base frame.
+ * @param [out] Jv    The returned Jacobian w.r.t Velocity, with 
+ *                    [Jv_theta(:), Jv_delta(:), Jv_L(:)].
+ * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with 
+ *                    [Jw_theta(:), Jw_delta(:), Jw_L(:)].
+ * @param [out] dpose2theta  The derivatives of pose to theta, skipped if null.
+ * @param [out] dpose2delta  The derivatives of pose to delta, skipped if null.
+ * @param [out] dpose2L      The derivatives of pose to L, skipped if null.
+ *
+ * @note The derivatives are the partials of the returned pose, i.e., dpose2L
+ * does not contain the rigid segment, which is the same as the third column of
+ * Jv. The limit values are taken when theta is near zero.
+ *
+ * @see mmath::continuum::calcSingleWithRigidSegmentPose(),
+ * mmath::continuum::calcVariableLengthWithRigidSegmentJacobian().
+ */
+template<typename Scalar>
+void calcVariableLengthWithRigidSegmentPoseAndJacobian(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr, PoseT<Scalar>& pose,
+        Eigen::Matrix<Scalar, 3, 3>& Jv, Eigen::Matrix<Scalar, 3, 3>& Jw,
+        PoseT<Scalar> *dpose2theta = nullptr,
+        PoseT<Scalar> *dpose2delta = nullptr, PoseT<Scalar> *dpose2L = nullptr);
+
+
+/**
+ * @brief Calculate the end pose and the Jabobian of a single segment tha has a
+ *        variable length and followed by a rigid segment, w.r.t Velocity and
+ *        Angular-Velocity, in one pass.
+ *
+ * @remark This is an overloaded function, provided for convenience. It differs 
+ * from the base function only in what argument(s) it accepts.
+ *
+ * @param [in] q      A ConfiSpc object.
+ * @param [in] Lr     The length of the rigid segment.
+ * @param [out] pose  The end pose of the segment w.r.t its base frame.
+ * @param [out] Jv    The returned Jacobian w.r.t Velocity, with 
+ *                    [Jv_theta(:), Jv_delta(:), Jv_L(:)].
+ * @param [out] Jw    The returned Jacobian w.r.t Angular-Velocity, with 
+ *                    [Jw_theta(:), Jw_delta(:), Jw_L(:)].
+ * @param [out] dpose2theta  The derivatives of pose to theta, skipped if null.
+ * @param [out] dpose2delta  The derivatives of pose to delta, skipped if null.
+ * @param [out] dpose2L      The derivatives of pose to L, skipped if null.
+ */
+template<typename Scalar>
+void calcVariableLengthWithRigidSegmentPoseAndJacobian(
+        const ConfigSpcT<Scalar> &q, NonDeduced<Scalar> Lr, PoseT<Scalar>& pose,
+        Eigen::Matrix<Scalar, 3, 3>& Jv, Eigen::Matrix<Scalar, 3, 3>& Jw,
+        PoseT<Scalar> *dpose2theta = nullptr,
+        PoseT<Scalar> *dpose2delta = nullptr, PoseT<Scalar> *dpose2L = nullptr);
+
+/*---------------------------------------------------------------------------*/
+/*           Calculate the second derivatives of Pose, i.e., Hessian         */
+/*---------------------------------------------------------------------------*/
+
+
+/**
+ * @brief Calculate the second derivatives of the end pose of a single segment
+ *        w.r.t [theta, delta, L].
+ *
+ * @details d2pose[i][j] is the partial of pose to the i-th and the j-th
+ * variables, where 0, 1, 2 are theta, delta and L, and d2pose[i][j] equals 
+ * d2pose[j][i]. The sin/cos are shared with the optional pose and the first
+ * derivatives, so a Newton step gets all of them in one pass.
+ *
+ * @remark This is the base of overloaded functions.
+ *
+ * @param [in] L      The length of the segment.
+ * @param [in] theta  The bending angle of the segment.
+ * @param [in] delta  The bending direction of the segment.
+ * @param [out] d2pose The second derivatives of pose.
+ * @param [out] pose   The end pose of the segment, skipped if null.
+ * @param [out] dpose  The array of 3 derivatives of pose to theta, delta and L,
+ *                     skipped if null.
+ *
+ * @note The same as the first derivatives, the limit values are taken when 
+ * theta is near zero. Taylor series are used for the second derivatives of 
+ * the position in a wider range of small theta, where the closed forms lose
+ * precision by cancellation.
+ *
+ * @see mmath::continuum::calcSingleSegmentPoseAndJacobian().
+ */
+template<typename Scalar>
+void calcSingleSegmentPoseHessian(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, PoseT<Scalar> d2pose[3][3],
+        PoseT<Scalar> *pose = nullptr, PoseT<Scalar> *dpose = nullptr);
+
+
+/**
+ * @brief Calculate the second derivatives of the end pose of a single segment
+ *        w.r.t [theta, delta, L].
+ *
+ * @remark This is an overloaded function, provided for convenience. It differs 
+ * from the base function only in what argument(s) it accepts.
+ *
+ * @param [in] q       A ConfiSpc object.
+ * @param [out] d2pose The second derivatives of pose.
+ * @param [out] pose   The end pose of the segment, skipped if null.
+ * @param [out] dpose  The array of 3 derivatives of pose to theta, delta and L,
+ *                     skipped if null.
+ */
+template<typename Scalar>
+void calcSingleSegmentPoseHessian(
+        const ConfigSpcT<Scalar> &q, PoseT<Scalar> d2pose[3][3],
+        PoseT<Scalar> *pose = nullptr, PoseT<Scalar> *dpose = nullptr);
+
+
+/**
+ * @brief Calculate the second derivatives of the end pose of a single segment
+ *        with a rigid segment w.r.t [theta, delta, L, Lr].
+ *
+ * @remark This is the base of overloaded functions.
+ *
+ * @param [in] L      The length of the segment.
+ * @param [in] theta  The bending angle of the segment.
+ * @param [in] delta  The bending direction of the segment.
+ * @param [in] Lr     The length of the rigid segment.
+ * @param [out] d2pose The second derivatives of pose, where 0, 1, 2, 3 are
+ *                     theta, delta, L and Lr.
+ * @param [out] pose   The end pose of the segment, skipped if null.
+ * @param [out] dpose  The array of 4 derivatives of pose to theta, delta, L 
+ *                     and Lr, skipped if null.
+ *
+ * @see mmath::continuum::calcSingleSegmentPoseHessian().
+ */
+template<typename Scalar>
+void calcSingleWithRigidSegmentPoseHessian(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr,
+        PoseT<Scalar> d2pose[4][4], PoseT<Scalar> *pose = nullptr,
+        PoseT<Scalar> *dpose = nullptr);
+
+
+/**
+ * @brief Calculate the second derivatives of the end pose of a single segment
+ *        with a rigid segment w.r.t [theta, delta, L, Lr].
+ *
+ * @remark This is an overloaded function, provided for convenience. It differs 
+ * from the base function only in what argument(s) it accepts.
+ *
+ * @param [in] q       A ConfiSpc object.
+ * @param [in] Lr      The length of the rigid segment.
+ * @param [out] d2pose The second derivatives of pose.
+ * @param [out] pose   The end pose of the segment, skipped if null.
+ * @param [out] dpose  The array of 4 derivatives of pose to theta, delta, L 
+ *                     and Lr, skipped if null.
+ */
+template<typename Scalar>
+void calcSingleWithRigidSegmentPoseHessian(
+        const ConfigSpcT<Scalar> &q, NonDeduced<Scalar> Lr,
+        PoseT<Scalar> d2pose[4][4], PoseT<Scalar> *pose = nullptr,
+        PoseT<Scalar> *dpose = nullptr);
 
 }} // mmath::continuum
 #endif // LIB_MATH_DCONTINUUM_POSE_H_LF
\ No newline at end of file
@@ -0,0 +1,227 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		dual_quat.h
+ * 
+ * @brief 		Define the dual quaternion and the dual-quaternion linear blending.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_DUAL_QUAT_H_LF
+#define LIB_MATH_DUAL_QUAT_H_LF
+#include <Eigen/Dense>
+#include <cstddef>
+#include "pose.h"
+
+namespace mmath{
+
+/** 
+ * @brief A class designed to describe the transformation by a unit dual 
+ * quaternion, "dq = real + eps * dual".
+ * 
+ * @details The members are:
+ *   real  --  the rotation quaternion q.
+ *   dual  --  0.5 * t * q, where t is a pure quaternion of the translation.
+ * The 8 scalars are stored contiguously without any padding, so an array of
+ * DualQuat can be blended in batches, see mmath::blendDualQuatBatch().
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ */
+template<typename Scalar>
+class DualQuatT
+{
+public:
+    using Quaternion = Eigen::Quaternion<Scalar>;
+
+
+    /**
+     * @brief Construct a new DualQuat object, which is identity by default.
+     * 
+     * @param real  The real part, i.e., the rotation.
+     * @param dual  The dual part.
+     */
+    DualQuatT(const Quaternion& real = Quaternion::Identity(),
+              const Quaternion& dual = Quaternion(0, 0, 0, 0))
+        : real(real), dual(dual)
+    {}
+
+
+    /**
+     * @brief Construct a new DualQuat object from a Pose.
+     * 
+     * @param pose  The Pose object, whose R should be unit orthogonal.
+     */
+    explicit DualQuatT(const PoseT<Scalar>& pose)
+        : real(pose.R)
+    {
+        dual = Quaternion(0, pose.t.x(), pose.t.y(), pose.t.z()) * real;
+        dual.coeffs() *= Scalar(0.5);
+    }
+
+
+    /**
+     * @brief Return the translation, which is "t = 2 * dual * real^*".
+     */
+    Eigen::Vector<Scalar, 3> translation() const
+    {
+        return 2 * (dual * real.conjugate()).vec();
+    }
+
+
+    /**
+     * @brief Convert to a Pose object.
+     * 
+     * @return A new Pose object.
+     */
+    PoseT<Scalar> toPose() const
+    {
+        PoseT<Scalar> pose;
+        pose.R = real.toRotationMatrix();
+        pose.t = translation();
+        return pose;
+    }
+
+
+    /**
+     * @brief Multiplication with another dual quaternion, i.e., the 
+     * composition "new_dq = (*this) * dq".
+     * 
+     * @param [in] dq The another DualQuat object.
+     * 
+     * @return A new DualQuat object.
+     */
+    DualQuatT operator* (const DualQuatT& dq) const
+    {
+        Quaternion d = real * dq.dual;
+        d.coeffs() += (dual * dq.real).coeffs();
+        return DualQuatT(real * dq.real, d);
+    }
+
+
+    /**
+     * @brief Transform a given point, which is "ret = R * p + t".
+     * 
+     * @param [in] p  The point.
+     * 
+     * @return A new point, an object of class Eigen::Vector<Scalar, 3>.
+     */
+    Eigen::Vector<Scalar, 3> operator* (const Eigen::Vector<Scalar, 3>& p) const
+    {
+        return real * p + translation();
+    }
+
+
+    /**
+     * @brief Return the inverse of a unit dual quaternion, which is the 
+     * quaternion conjugate of both parts.
+     * 
+     * @return A new DualQuat object.
+     */
+    DualQuatT inverse() const
+    {
+        return DualQuatT(real.conjugate(), dual.conjugate());
+    }
+
+
+    /**
+     * @brief Normalize to a unit dual quaternion, i.e., |real| = 1 and
+     * real . dual = 0.
+     */
+    void normalize()
+    {
+        Scalar n = real.norm();
+        real.coeffs() /= n;
+        dual.coeffs() /= n;
+        dual.coeffs() -= real.dot(dual) * real.coeffs();
+    }
+
+
+    Quaternion real; //!< The real part, i.e., the rotation
+    Quaternion dual; //!< The dual part, i.e., 0.5 * t * real
+};
+
+static_assert(sizeof(DualQuatT<float>) == 8 * sizeof(float), "Unexpected size");
+static_assert(sizeof(DualQuatT<double>) == 8 * sizeof(double), "Unexpected size");
+
+
+/**
+ * @brief Blend the dual quaternions with weights, i.e., the dual-quaternion
+ * linear blending (DLB).
+ * 
+ * @details The weighted sum is normalized, so the result is always rigid. 
+ * The dual quaternions in the opposite hemisphere of dqs[0] are negated 
+ * before the sum to take the shortest path.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] dqs      The dual quaternions.
+ * @param [in] weights  The weights, which need not to be normalized.
+ * @param [in] num      The number of dual quaternions.
+ * 
+ * @return A new unit DualQuat object.
+ */
+template<typename Scalar>
+DualQuatT<Scalar> blendDualQuat(const DualQuatT<Scalar> *dqs,
+                                const Scalar *weights, std::size_t num);
+
+
+/**
+ * @brief Blend many groups of dual quaternions, e.g., skinning the frames 
+ * of a backbone, where each output blends k of the input frames.
+ * 
+ * @details The output i is the DLB of dqs[indices[i * k + j]] weighted by
+ * weights[i * k + j], j = 0, ..., k - 1.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] dqs      The input dual quaternions.
+ * @param [in] indices  The indices of the blended inputs, num * k values.
+ * @param [in] weights  The weights, num * k values.
+ * @param [in] k        The number of inputs of each output.
+ * @param [in] num      The number of outputs.
+ * @param [out] out     The blended dual quaternions, num values.
+ */
+template<typename Scalar>
+void blendDualQuatBatch(const DualQuatT<Scalar> *dqs, const int *indices,
+                        const Scalar *weights, int k, std::size_t num,
+                        DualQuatT<Scalar> *out);
+
+
+/**
+ * @brief The screw linear interpolation (ScLERP) between two dual 
+ * quaternions, which is "dq0 * (dq0^-1 * dq1)^h".
+ * 
+ * @details The motion is a constant twist, i.e., the same as 
+ * mmath::InterpMode::SCLERP of mmath::PoseTrajectory.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] dq0  The dual quaternion at h = 0.
+ * @param [in] dq1  The dual quaternion at h = 1.
+ * @param [in] h    The interpolation parameter in [0, 1].
+ * 
+ * @return A new DualQuat object.
+ */
+template<typename Scalar>
+DualQuatT<Scalar> sclerp(const DualQuatT<Scalar>& dq0,
+                         const DualQuatT<Scalar>& dq1, NonDeduced<Scalar> h);
+
+
+/** The DualQuat with the precision controlled by LIB_MATH_USE_DOUBLE. */
+using DualQuat = DualQuatT<kfloat>;
+
+} // mmath
+#endif // LIB_MATH_DUAL_QUAT_H_LF
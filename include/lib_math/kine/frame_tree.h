@@ -0,0 +1,258 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		frame_tree.h
+ * 
+ * @brief 		Design a tree of named frames with timestamped transforms, which can
+ *          	be updated and looked up from many threads.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_FRAME_TREE_H_LF
+#define LIB_MATH_FRAME_TREE_H_LF
+#include <Eigen/Dense>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "pose.h"
+
+namespace mmath{
+
+/**
+ * @brief A class designed to describe a tree of named frames, e.g., camera,
+ * robot base, segments and tool, where each frame is attached to its parent
+ * by a transform buffered over time.
+ * 
+ * @details Each edge keeps the last buffer_size samples of "parent_T_child"
+ * in a ring buffer guarded by a sequence lock, i.e., setTransform() never 
+ * waits for the readers, and a reader retries only if the edge is written 
+ * during its read. So vision and control threads can query the tree at a 
+ * high rate while the drivers are updating it. The samples are stored in
+ * relaxed atomic words, so a read that overlaps a write is retried without a
+ * data race.
+ * 
+ * The path from a frame to the root is resolved once by addFrame(). For 
+ * repeated queries of the same pair of frames, use mmath::FrameLookup, which
+ * caches the path and the composed product.
+ * 
+ * @note The frames should be added before the tree is shared by threads, and
+ * each edge should be written by only one thread at a time.
+ */
+class FrameTree
+{
+public:
+    /** The time that denotes the latest sample of each edge. */
+    static constexpr double LATEST = -std::numeric_limits<double>::infinity();
+
+
+    /**
+     * @brief Construct a new FrameTree object.
+     * 
+     * @param buffer_size  The number of samples buffered for each edge.
+     */
+    explicit FrameTree(std::size_t buffer_size = 100);
+
+
+    FrameTree(const FrameTree&) = delete;
+    FrameTree& operator= (const FrameTree&) = delete;
+    ~FrameTree();
+
+
+    /**
+     * @brief Add a frame.
+     * 
+     * @param name    The unique name of the frame.
+     * @param parent  The name of parent frame, or "" for a root frame.
+     * 
+     * @return The id of the frame, or -1 if the name exists or the parent 
+     * does not exist.
+     */
+    int addFrame(const std::string& name, const std::string& parent = "");
+
+
+    /**
+     * @brief Return the id of a frame, or -1 if the name does not exist.
+     */
+    int frameId(const std::string& name) const;
+
+
+    /**
+     * @brief Return the number of frames.
+     */
+    std::size_t frameNum() const;
+
+
+    /**
+     * @brief Return the name of a frame.
+     */
+    const std::string& frameName(int id) const;
+
+
+    /**
+     * @brief Return the id of the parent frame, or -1 for a root frame.
+     */
+    int parent(int id) const;
+
+
+    /**
+     * @brief Write a sample of the transform from a frame to its parent.
+     * 
+     * @param [in] id    The id of the child frame.
+     * @param [in] time  The timestamp, which should be increasing.
+     * @param [in] pose  The pose of the frame w.r.t. its parent, i.e., 
+     *                   parent_T_child.
+     * 
+     * @return Whether the sample is written, false for a root frame, a static
+     * edge or a non-increasing time.
+     */
+    bool setTransform(int id, double time, const Pose& pose);
+
+
+    /**
+     * @brief Set a transform which is valid for all the time, e.g., the 
+     * mounting of a camera.
+     * 
+     * @param [in] id    The id of the child frame.
+     * @param [in] pose  The pose of the frame w.r.t. its parent.
+     * 
+     * @return Whether the transform is set, false for a root frame.
+     */
+    bool setStaticTransform(int id, const Pose& pose);
+
+
+    /**
+     * @brief Return the version of an edge, which is changed by each write.
+     */
+    uint64_t version(int id) const;
+
+
+    /**
+     * @brief Look up the pose of the source frame w.r.t. the target frame at
+     * the given time, i.e., target_T_source.
+     * 
+     * @details The transform of each edge at time is interpolated between 
+     * the two neighboring samples, i.e., SLERP of rotation and linear 
+     * interpolation of translation.
+     * 
+     * @remark This is the base of overloaded functions.
+     * 
+     * @param [in] target  The id of target frame.
+     * @param [in] source  The id of source frame.
+     * @param [in] time    The query time, or LATEST.
+     * @param [out] pose   The pose target_T_source.
+     * 
+     * @return Whether the lookup succeeds, false if the frames are in 
+     * different trees, or the time is out of the buffer of any edge.
+     */
+    bool lookup(int target, int source, double time, Pose& pose) const;
+
+
+    /**
+     * @brief Look up the pose of the source frame w.r.t. the target frame.
+     * 
+     * @remark This is an overloaded function, provided for convenience. It 
+     * differs from the base function only in what argument(s) it accepts.
+     * 
+     * @param [in] target  The name of target frame.
+     * @param [in] source  The name of source frame.
+     * @param [in] time    The query time, or LATEST.
+     * @param [out] pose   The pose target_T_source.
+     * 
+     * @return Whether the lookup succeeds.
+     */
+    bool lookup(const std::string& target, const std::string& source,
+                double time, Pose& pose) const;
+
+
+private:
+    friend class FrameLookup;
+    struct Frame;
+
+    /** Return the common ancestor of two frames, or -1 if not connected. */
+    int commonAncestor(int a, int b) const;
+
+    /** Return parent_T_child of an edge at time, and the version read. */
+    bool edgeTransform(int id, double time, Pose& pose,
+                       uint64_t *version = nullptr) const;
+
+    /** Return ancestor_T_frame by composing the edges upwards. */
+    bool composeUp(int id, int ancestor, double time, Pose& pose) const;
+
+    std::size_t _buffer_size;                      //!< The samples per edge.
+    std::vector<std::unique_ptr<Frame>> _frames;   //!< The frames.
+    std::unordered_map<std::string, int> _ids;     //!< The ids of names.
+};
+
+
+/**
+ * @brief A class designed to look up one pair of frames repeatedly.
+ * 
+ * @details The path between the frames is resolved once, and the composed
+ * product is cached with the versions of all edges on the path, so a query 
+ * at the same time returns the cached pose if no edge has been written 
+ * since. Each thread should own its FrameLookup objects.
+ */
+class FrameLookup
+{
+public:
+    /**
+     * @brief Construct a new FrameLookup object.
+     * 
+     * @param tree    The frame tree, which should outlive this object.
+     * @param target  The id of target frame.
+     * @param source  The id of source frame.
+     */
+    FrameLookup(const FrameTree& tree, int target, int source);
+
+
+    /**
+     * @brief Whether the frames are connected in the tree.
+     */
+    bool isValid() const;
+
+
+    /**
+     * @brief Look up the pose target_T_source, the same as 
+     * mmath::FrameTree::lookup().
+     * 
+     * @param [in] time   The query time, or FrameTree::LATEST.
+     * @param [out] pose  The pose target_T_source.
+     * 
+     * @return Whether the lookup succeeds.
+     */
+    bool lookup(double time, Pose& pose);
+
+
+private:
+    const FrameTree&      _tree;      //!< The frame tree.
+    bool                  _is_valid;  //!< Whether the path exists.
+    std::vector<int>      _up;        //!< The edges from target upwards.
+    std::vector<int>      _down;      //!< The edges from source upwards.
+    std::vector<uint64_t> _versions;  //!< The versions of the cached pose.
+    bool                  _is_cached; //!< Whether the cache is valid.
+    double                _time;      //!< The time of the cached pose.
+    Pose                  _pose;      //!< The cached pose.
+};
+
+} // mmath
+#endif // LIB_MATH_FRAME_TREE_H_LF
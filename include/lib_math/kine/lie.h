@@ -0,0 +1,216 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		lie.h
+ * 
+ * @brief 		Design the exponential and logarithm maps of SO(3) and SE(3), and
+ *          	their left and right Jacobians.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_LIE_H_LF
+#define LIB_MATH_LIE_H_LF
+#include <Eigen/Dense>
+#include "pose.h"
+
+namespace mmath{
+
+/**
+ * @brief Return the rotation matrix of a rotation vector, i.e., the
+ * exponential map of SO(3), "R = exp(phi^)".
+ * 
+ * @details The Rodrigues' formula is used. If theta = |phi| is close to zero,
+ * the coefficients are replaced by their Taylor series, so the result is 
+ * accurate and smooth at theta = 0.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] phi  The rotation vector, i.e., axis * angle.
+ * 
+ * @return A rotation matrix.
+ * 
+ * @see mmath::logSO3().
+ */
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> expSO3(const Eigen::Vector<Scalar, 3>& phi);
+
+
+/**
+ * @brief Return the rotation vector of a rotation matrix, i.e., the
+ * logarithm map of SO(3), "phi = log(R)v".
+ * 
+ * @details The rotation vector is computed from the quaternion of R, which is
+ * well-conditioned for both theta -> 0 and theta -> pi. The returned angle 
+ * is in [0, pi].
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] R  The unit orthogonal rotation matrix.
+ * 
+ * @return The rotation vector.
+ * 
+ * @see mmath::expSO3().
+ */
+template<typename Scalar>
+Eigen::Vector<Scalar, 3> logSO3(const Eigen::Matrix<Scalar, 3, 3>& R);
+
+
+/**
+ * @brief Return the left Jacobian of SO(3), which satisfies
+ * "exp((phi + dphi)^) = exp((Jl * dphi)^) * exp(phi^)" to the first order.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] phi  The rotation vector.
+ * 
+ * @return The 3x3 left Jacobian.
+ */
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> leftJacobianSO3(const Eigen::Vector<Scalar, 3>& phi);
+
+
+/**
+ * @brief Return the inverse of the left Jacobian of SO(3).
+ * 
+ * @note The inverse is singular at theta = 2 * pi.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] phi  The rotation vector.
+ * 
+ * @return The 3x3 inverse of left Jacobian.
+ */
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> leftJacobianInvSO3(
+        const Eigen::Vector<Scalar, 3>& phi);
+
+
+/**
+ * @brief Return the right Jacobian of SO(3), which satisfies
+ * "exp((phi + dphi)^) = exp(phi^) * exp((Jr * dphi)^)" to the first order.
+ * 
+ * @note Jr(phi) = Jl(-phi) = Jl(phi)^T.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] phi  The rotation vector.
+ * 
+ * @return The 3x3 right Jacobian.
+ */
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> rightJacobianSO3(
+        const Eigen::Vector<Scalar, 3>& phi);
+
+
+/**
+ * @brief Return the inverse of the right Jacobian of SO(3).
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] phi  The rotation vector.
+ * 
+ * @return The 3x3 inverse of right Jacobian.
+ */
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> rightJacobianInvSO3(
+        const Eigen::Vector<Scalar, 3>& phi);
+
+
+/**
+ * @brief Return the pose of a twist, i.e., the exponential map of SE(3).
+ * 
+ * @details The twist is xi = [rho; phi], where the translational part rho is
+ * on the top, the same as the order of the Jacobians in this library. The 
+ * returned pose is "R = exp(phi^), t = Jl(phi) * rho".
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] xi  The twist.
+ * 
+ * @return A new Pose object.
+ * 
+ * @see mmath::logSE3().
+ */
+template<typename Scalar>
+PoseT<Scalar> expSE3(const Eigen::Vector<Scalar, 6>& xi);
+
+
+/**
+ * @brief Return the twist of a pose, i.e., the logarithm map of SE(3).
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] pose  The pose with a unit orthogonal R.
+ * 
+ * @return The twist [rho; phi].
+ * 
+ * @see mmath::expSE3().
+ */
+template<typename Scalar>
+Eigen::Vector<Scalar, 6> logSE3(const PoseT<Scalar>& pose);
+
+
+/**
+ * @brief Return the left Jacobian of SE(3), i.e., [Jl, Q; 0, Jl], where Jl
+ * is the left Jacobian of SO(3) and Q is the coupling block.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] xi  The twist [rho; phi].
+ * 
+ * @return The 6x6 left Jacobian.
+ */
+template<typename Scalar>
+Eigen::Matrix<Scalar, 6, 6> leftJacobianSE3(const Eigen::Vector<Scalar, 6>& xi);
+
+
+/**
+ * @brief Return the inverse of the left Jacobian of SE(3), which is computed
+ * in closed form by [Jl^-1, -Jl^-1 * Q * Jl^-1; 0, Jl^-1].
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] xi  The twist [rho; phi].
+ * 
+ * @return The 6x6 inverse of left Jacobian.
+ */
+template<typename Scalar>
+Eigen::Matrix<Scalar, 6, 6> leftJacobianInvSE3(
+        const Eigen::Vector<Scalar, 6>& xi);
+
+
+/**
+ * @brief Return the right Jacobian of SE(3).
+ * 
+ * @note Jr(xi) = Jl(-xi).
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] xi  The twist [rho; phi].
+ * 
+ * @return The 6x6 right Jacobian.
+ */
+template<typename Scalar>
+Eigen::Matrix<Scalar, 6, 6> rightJacobianSE3(
+        const Eigen::Vector<Scalar, 6>& xi);
+
+
+/**
+ * @brief Return the inverse of the right Jacobian of SE(3).
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] xi  The twist [rho; phi].
+ * 
+ * @return The 6x6 inverse of right Jacobian.
+ */
+template<typename Scalar>
+Eigen::Matrix<Scalar, 6, 6> rightJacobianInvSE3(
+        const Eigen::Vector<Scalar, 6>& xi);
+
+} // mmath
+#endif // LIB_MATH_LIE_H_LF
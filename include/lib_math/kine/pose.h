@@ -22,6 +22,10 @@
  * --------------------------------------------------------------------
  * Change History:                
  * 
+ * 2026/10/16 Add reentrant info() and binary record.
+ * 2026/10/16 Template this class on the scalar type, keep Pose as alias.
+ * 2026/10/16 Add bulk transform of point clouds.
+ * 2026/10/16 Add boxplus() and boxminus() on the manifold SE(3).
  * 2022/12/06 Add a function check the orthogonalization of rotation matrix.
  * 2022/06/27 Consider the usage of this class are not sensitive to precision,
  * remove the templated-class-type, then controlling the precesion by
@@ -33,6 +37,7 @@
 #define LIB_MATH_POSE_H_LF
 #include <Eigen/Dense>
 #include <iostream>
+#include <cstddef>
 #include "../math_precision.h"
 
 
@@ -46,8 +51,14 @@ namespace mmath{
  * There are two members include in this class:
  *   R	--  denotes the rotation or orientation.
  *   t  --  denotes the translation or position.
+ * 
+ * mmath::Pose is the alias of PoseT<kfloat>, and both PoseT<float> and 
+ * PoseT<double> are explicitly instantiated in the library.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
  */
-class Pose
+template<typename Scalar>
+class PoseT
 {
 public:
     /**
@@ -58,10 +69,10 @@ public:
      * @param R  The rotation matrix.
      * @param t  The translation vector.
      */
-    template<typename Tp1 = kfloat, typename Tp2 = kfloat>
-    explicit Pose(const Eigen::Matrix<Tp1, 3, 3>& R =
+    template<typename Tp1 = Scalar, typename Tp2 = Scalar>
+    explicit PoseT(const Eigen::Matrix<Tp1, 3, 3>& R =
             Eigen::Matrix<Tp1, 3, 3>::Identity(),
-                  const Eigen::Vector<Tp2, 3>& t = {0, 0, 0});
+                   const Eigen::Vector<Tp2, 3>& t = {0, 0, 0});
     
 
     /**
@@ -72,8 +83,8 @@ public:
      * @tparam Tp1 The arithmetic class type of input matrix.
      * @param T    The transformation matrix.
      */
-    template<typename Tp1 = kfloat>
-    explicit Pose(const Eigen::Matrix<Tp1, 4, 4>& T);
+    template<typename Tp1 = Scalar>
+    explicit PoseT(const Eigen::Matrix<Tp1, 4, 4>& T);
     
 
     /**
@@ -86,8 +97,8 @@ public:
      * @param ty  The y value of translation vector.
      * @param tz  The z value of translation vector.
      */
-    template<typename Tp1 = kfloat>
-    explicit Pose(Tp1 tx, Tp1 ty, Tp1 tz);
+    template<typename Tp1 = Scalar>
+    explicit PoseT(Tp1 tx, Tp1 ty, Tp1 tz);
     
     
     /**
@@ -102,8 +113,8 @@ public:
      *                      row first arrar whereas false/0 specifies column
      *                      first.
      */
-    template<typename Tp1 = kfloat>
-    explicit Pose(Tp1 data[16], bool is_row_fisrt = true);
+    template<typename Tp1 = Scalar>
+    explicit PoseT(Tp1 data[16], bool is_row_fisrt = true);
 
 
     /**
@@ -128,10 +139,10 @@ public:
      * @note The last row of an transformation matrix is no needed, since it 
      * is always a [0, 0, 0, 1] row-vector for a transformation matrix.
      */
-    template<typename Tp1 = kfloat>
-    explicit Pose(Tp1 m11, Tp1 m12, Tp1 m13, Tp1 m14,
-                  Tp1 m21, Tp1 m22, Tp1 m23, Tp1 m24,
-                  Tp1 m31, Tp1 m32, Tp1 m33, Tp1 m34);
+    template<typename Tp1 = Scalar>
+    explicit PoseT(Tp1 m11, Tp1 m12, Tp1 m13, Tp1 m14,
+                   Tp1 m21, Tp1 m22, Tp1 m23, Tp1 m24,
+                   Tp1 m31, Tp1 m32, Tp1 m33, Tp1 m34);
 
 
     /**
@@ -142,8 +153,8 @@ public:
      * 
      * @return This object.
      */
-    template<typename Tp1 = kfloat>
-    Pose& operator= (const Eigen::Matrix<Tp1, 4, 4>& pose);
+    template<typename Tp1 = Scalar>
+    PoseT& operator= (const Eigen::Matrix<Tp1, 4, 4>& pose);
 
 
     /**
@@ -153,7 +164,7 @@ public:
      * 
      * @return This object.
      */
-    Pose& operator= (const Pose& pose);
+    PoseT& operator= (const PoseT& pose);
 
 
     /**
@@ -166,7 +177,7 @@ public:
      * 
      * @return A new Pose object.
      */
-    Pose  operator* (const Pose& pose) const;
+    PoseT  operator* (const PoseT& pose) const;
     
 
     /**
@@ -179,7 +190,7 @@ public:
      * 
      * @return This object.
      */
-    Pose& operator*= (const Pose& pose);
+    PoseT& operator*= (const PoseT& pose);
 
 
     /**
@@ -190,38 +201,88 @@ public:
      * 
      * @param [in] p 
      * 
-     * @return A new point/vector, an object of class Eigen::Vector<kfloat, 3>.
+     * @return A new point/vector, an object of class Eigen::Vector<Scalar, 3>.
+     * 
+     * @see mmath::Pose::transform() for transforming a point cloud.
      */
-    Eigen::Vector<kfloat, 3> operator*(const Eigen::Vector<kfloat, 3>& p);
+    Eigen::Vector<Scalar, 3> operator*(const Eigen::Vector<Scalar, 3>& p) const;
+
+
+    /** 
+     * A writable view of a 3xN point cloud, which accepts Eigen::Matrix3X and
+     * Eigen::Map with any outer stride, e.g., xyz-padded buffers [x y z w ...]
+     * mapped by Eigen::Map<Eigen::Matrix3Xf, 0, Eigen::OuterStride<4>>.
+     */
+    using PointsRef = Eigen::Ref<Eigen::Matrix<Scalar, 3, Eigen::Dynamic>, 0,
+                                 Eigen::OuterStride<>>;
+    /** A read-only view of a 3xN point cloud, see PointsRef. */
+    using ConstPointsRef = Eigen::Ref<
+        const Eigen::Matrix<Scalar, 3, Eigen::Dynamic>, 0, Eigen::OuterStride<>>;
 
 
     /**
-     * @brief For std::cout operation to print the member information.
+     * @brief Transform a point cloud, i.e., dst.col(i) = R * src.col(i) + t.
+     * 
+     * @details By default, the points are transformed block by block with the
+     * vectorized matrix product of Eigen, without any heap allocation. If 
+     * is_deterministic is true, each point is transformed by operator*(), so 
+     * the results are bit-identical to transforming the points one by one, for
+     * any thread_num.
+     * 
+     * @remark This is the base of overloaded functions.
+     * 
+     * @param [in] src  The points to be transformed.
+     * @param [out] dst The transformed points, with the same size as src. It
+     *                  should not overlap with src, see transformInPlace().
+     * @param [in] thread_num  The number of threads. Large clouds are split
+     *                         into thread_num contiguous ranges, and each range
+     *                         is transformed by a std::thread.
+     * @param [in] is_deterministic  Whether to use the scalar path.
+     */
+    void transform(ConstPointsRef src, PointsRef dst, int thread_num = 1,
+                   bool is_deterministic = false) const;
+
+
+    /**
+     * @brief Transform a point cloud in place, i.e., 
+     * pts.col(i) = R * pts.col(i) + t.
+     * 
+     * @remark This is an overloaded function, provided for convenience. It 
+     * differs from the base function only in what argument(s) it accepts.
      * 
-     * @note This function is a friend function of class Pose.
+     * @param [in,out] pts  The points to be transformed.
+     * @param [in] thread_num  The number of threads.
+     * @param [in] is_deterministic  Whether to use the scalar path.
+     */
+    void transformInPlace(PointsRef pts, int thread_num = 1,
+                          bool is_deterministic = false) const;
+
+
+    /**
+     * @brief Cast the Pose to another scalar type.
      * 
-     * @param [in] os The std::ostream object.
-     * @param [in] pose The Pose opject.
+     * @tparam Tp1  The scalar type of the returned Pose.
      * 
-     * @return The std::ostream object.
+     * @return A new PoseT<Tp1> object.
      */
-    friend std::ostream& operator<< (std::ostream& os, const Pose& pose);
+    template<typename Tp1>
+    PoseT<Tp1> cast() const;
 
 
     /**
      * @brief Return a rotation represented by a quaternion.
      * 
-     * @return A quaternion, an object of class Eigen::Quaternion<kfloat>.
+     * @return A quaternion, an object of class Eigen::Quaternion<Scalar>.
      */
-    Eigen::Quaternion<kfloat> q() const;
+    Eigen::Quaternion<Scalar> q() const;
 
 
     /**
      * @brief Return the transform matrix.
      * 
-     * @return A transform, an object of class Eigen::Matrix<kfloat, 4, 4>.
+     * @return A transform, an object of class Eigen::Matrix<Scalar, 4, 4>.
      */
-    Eigen::Matrix<kfloat, 4, 4> T() const;
+    Eigen::Matrix<Scalar, 4, 4> T() const;
 
 
 	/**
@@ -229,7 +290,7 @@ public:
 	 * 
      * @return A new Pose object.
 	 */
-    Pose inverse() const;
+    PoseT inverse() const;
 
 
     /**
@@ -256,10 +317,13 @@ public:
      * @param [in] dq  The increment of rotation/orientation.
      * @param [in] dt  The increament of translation/position.
      * 
-     * @sa mmath::Pose::decrease().
+     * @note The quaternion coefficients are added and normalized, which is
+     * not a retraction on SO(3). Use boxplus() in optimizers.
+     * 
+     * @sa mmath::Pose::decrease(), mmath::Pose::boxplus().
      */
-    void increase(const Eigen::Quaternion<kfloat>& dq,
-                  const Eigen::Vector<kfloat, 3>& dt);
+    void increase(const Eigen::Quaternion<Scalar>& dq,
+                  const Eigen::Vector<Scalar, 3>& dt);
 
 
     /**
@@ -270,20 +334,99 @@ public:
      * 
      * @sa mmath::Pose::increase().
      */
-    void decrease(const Eigen::Quaternion<kfloat>& dq,
-                  const Eigen::Vector<kfloat, 3>& dt);
+    void decrease(const Eigen::Quaternion<Scalar>& dq,
+                  const Eigen::Vector<Scalar, 3>& dt);
+
+
+    /**
+     * @brief Apply a local increment on the manifold SE(3), which is
+     * "new_pose = (*this) * exp(xi^)".
+     * 
+     * @param [in] xi  The twist [rho; phi], expressed in the frame of this
+     *                 pose, see mmath::expSE3().
+     * 
+     * @return A new Pose object.
+     * 
+     * @sa mmath::Pose::boxminus().
+     */
+    PoseT boxplus(const Eigen::Vector<Scalar, 6>& xi) const;
+
+
+    /**
+     * @brief Return the local difference to another pose on the manifold
+     * SE(3), which is "xi = log(pose^-1 * (*this))".
+     * 
+     * @details It is the inverse of boxplus(), i.e., 
+     * "pose.boxplus(this->boxminus(pose)) == (*this)".
+     * 
+     * @param [in] pose  The reference pose.
+     * 
+     * @return The twist [rho; phi].
+     * 
+     * @sa mmath::Pose::boxplus().
+     */
+    Eigen::Vector<Scalar, 6> boxminus(const PoseT& pose) const;
 
 
 	/**
      * @brief Return the Pose info for print/std::out.
 	 * 
+     * @note The returned array is a thread-local buffer, which is valid until
+     * the next call of this function in the same thread.
+     * 
 	 * @return A character array that stores current member function.
 	 */
     char *info() const;
 
 
-    Eigen::Matrix<kfloat, 3, 3> R; //!< The rotation/orientation matrix
-    Eigen::Vector<kfloat, 3>    t; //!< The translation/position vector
+    /**
+     * @brief Write the Pose info into a caller-provided buffer.
+     * 
+     * @details This function uses neither static nor heap memory, and formats
+     * the values by mmath::formatFixed() instead of sprintf, thus it is safe
+     * and cheap to be called from many threads at the same time.
+     * 
+     * @param [out] buf   The buffer, 200 bytes are enough for a pose.
+     * @param [in] size   The size of the buffer.
+     * @param [in] precision  The number of digits after the decimal point.
+     * 
+     * @return The length of the info, the info is truncated if the returned 
+     * value is not less than size.
+     */
+    int info(char *buf, std::size_t size, int precision = 6) const;
+
+
+    /** The size of a binary record of a Pose in bytes. */
+    static constexpr std::size_t RECORD_SIZE = 12 * sizeof(Scalar);
+
+
+    /**
+     * @brief Write the Pose as a binary record, for high-rate logging.
+     * 
+     * @details The record contains the column-major R followed by t, i.e., 
+     * 12 Scalar values without any padding.
+     * 
+     * @param [out] record  The buffer with at least RECORD_SIZE bytes.
+     * 
+     * @return The number of bytes written, i.e., RECORD_SIZE.
+     * 
+     * @sa mmath::Pose::fromRecord().
+     */
+    std::size_t toRecord(void *record) const;
+
+
+    /**
+     * @brief Read the Pose from a binary record.
+     * 
+     * @param [in] record  The buffer with at least RECORD_SIZE bytes.
+     * 
+     * @sa mmath::Pose::toRecord().
+     */
+    void fromRecord(const void *record);
+
+
+    Eigen::Matrix<Scalar, 3, 3> R; //!< The rotation/orientation matrix
+    Eigen::Vector<Scalar, 3>    t; //!< The translation/position vector
 };
 
 
@@ -292,62 +435,100 @@ public:
 /* ------------------------------------------------------------------- */
 
 
+template<typename Scalar>
 template<typename Tp1, typename Tp2>
-Pose::Pose(const Eigen::Matrix<Tp1, 3, 3> &R, const Eigen::Vector<Tp2, 3> &t)
-    : t(Eigen::Vector<kfloat, 3>(t(0), t(1), t(2))) {
+PoseT<Scalar>::PoseT(const Eigen::Matrix<Tp1, 3, 3> &R,
+                     const Eigen::Vector<Tp2, 3> &t)
+    : t(Eigen::Vector<Scalar, 3>(t(0), t(1), t(2))) {
     this->R << R(0, 0), R(0, 1), R(0, 2),
             R(1, 0), R(1, 1), R(1, 2),
             R(2, 0), R(2, 1), R(2, 2);
 }
 
 
+template<typename Scalar>
 template<typename Tp1>
-Pose::Pose(const Eigen::Matrix<Tp1, 4, 4> &T)
-    : t(Eigen::Vector<kfloat, 3>(T(0, 3), T(1, 3), T(2, 3))) {
+PoseT<Scalar>::PoseT(const Eigen::Matrix<Tp1, 4, 4> &T)
+    : t(Eigen::Vector<Scalar, 3>(T(0, 3), T(1, 3), T(2, 3))) {
     R << T(0, 0), T(0, 1), T(0, 2),
             T(1, 0), T(1, 1), T(1, 2),
             T(2, 0), T(2, 1), T(2, 2);
 }
 
 
+template<typename Scalar>
 template<typename Tp1>
-Pose::Pose(Tp1 tx, Tp1 ty, Tp1 tz)
-    : R(Eigen::Matrix<kfloat, 3, 3>::Identity())
-    , t(Eigen::Vector<kfloat, 3>(tx, ty, tz)) {
+PoseT<Scalar>::PoseT(Tp1 tx, Tp1 ty, Tp1 tz)
+    : R(Eigen::Matrix<Scalar, 3, 3>::Identity())
+    , t(Eigen::Vector<Scalar, 3>(tx, ty, tz)) {
 }
 
 
+template<typename Scalar>
 template<typename Tp1>
-Pose::Pose(Tp1 data[16], bool is_row_fisrt) {
+PoseT<Scalar>::PoseT(Tp1 data[16], bool is_row_fisrt) {
     if (is_row_fisrt) {
         R << data[0], data[1], data[2],
                 data[4], data[5], data[6],
                 data[8], data[9], data[10];
-        t = Eigen::Vector<kfloat, 3>(data[3], data[7], data[11]);
+        t = Eigen::Vector<Scalar, 3>(data[3], data[7], data[11]);
     }
     else{
         R << data[0], data[4], data[8],
                 data[1], data[5], data[9],
                 data[2], data[6], data[10];
-        t = Eigen::Vector<kfloat, 3>(data[12], data[13], data[14]);
+        t = Eigen::Vector<Scalar, 3>(data[12], data[13], data[14]);
     }
 }
 
 
+template<typename Scalar>
 template<typename Tp1>
-Pose::Pose(Tp1 m11, Tp1 m12, Tp1 m13, Tp1 m14,
-           Tp1 m21, Tp1 m22, Tp1 m23, Tp1 m24,
-           Tp1 m31, Tp1 m32, Tp1 m33, Tp1 m34) {
+PoseT<Scalar>::PoseT(Tp1 m11, Tp1 m12, Tp1 m13, Tp1 m14,
+                     Tp1 m21, Tp1 m22, Tp1 m23, Tp1 m24,
+                     Tp1 m31, Tp1 m32, Tp1 m33, Tp1 m34) {
     this->R << m11, m12, m13, m21, m22, m23, m31, m32, m33;
-    this->t = Eigen::Vector<kfloat, 3>(m14, m24, m34);
+    this->t = Eigen::Vector<Scalar, 3>(m14, m24, m34);
 }
 
 
+template<typename Scalar>
 template<typename Tp1>
-Pose& Pose::operator=(const Eigen::Matrix<Tp1, 4, 4>& pose) {
-    *this = Pose(pose);
+PoseT<Scalar>& PoseT<Scalar>::operator=(const Eigen::Matrix<Tp1, 4, 4>& pose) {
+    *this = PoseT(pose);
     return *this;
 }
 
+
+template<typename Scalar>
+template<typename Tp1>
+PoseT<Tp1> PoseT<Scalar>::cast() const {
+    PoseT<Tp1> pose;
+    pose.R = R.template cast<Tp1>();
+    pose.t = t.template cast<Tp1>();
+    return pose;
+}
+
+
+/**
+ * @brief For std::cout operation to print the member information.
+ * 
+ * @param [in] os The std::ostream object.
+ * @param [in] pose The Pose opject.
+ * 
+ * @return The std::ostream object.
+ */
+template<typename Scalar>
+std::ostream& operator<< (std::ostream& os, const PoseT<Scalar>& pose);
+
+
+extern template class PoseT<float>;
+extern template class PoseT<double>;
+extern template std::ostream& operator<< (std::ostream&, const PoseT<float>&);
+extern template std::ostream& operator<< (std::ostream&, const PoseT<double>&);
+
+/** The Pose with the precision controlled by LIB_MATH_USE_DOUBLE. */
+using Pose = PoseT<kfloat>;
+
 } // mmath
 #endif // LIB_MATH_RT_H_LF
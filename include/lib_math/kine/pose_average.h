@@ -0,0 +1,87 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		pose_average.h
+ * 
+ * @brief 		Design the averaging and the statistics of pose arrays.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_POSE_AVERAGE_H_LF
+#define LIB_MATH_POSE_AVERAGE_H_LF
+#include <Eigen/Dense>
+#include <cstddef>
+#include "pose.h"
+
+namespace mmath{
+
+/** The robust losses of mmath::averagePoses(). */
+enum class RobustLoss
+{
+    NONE,       //!< The least squares, i.e., the chordal L2 mean.
+    WEISZFELD,  //!< The L1 loss, i.e., the Weiszfeld iteration of median.
+    HUBER       //!< The Huber loss.
+};
+
+
+/** The options of mmath::averagePoses(). */
+struct AverageOptions
+{
+    RobustLoss loss = RobustLoss::NONE; //!< The robust loss.
+    double huber_rotation = 0.05;       //!< The Huber threshold of angle, rad.
+    double huber_translation = 0.01;    //!< The Huber threshold of distance.
+    int    max_iteration = 20;          //!< The max robust iterations.
+    double tolerance = 1e-9;            //!< The convergence of the mean.
+    int    thread_num = 1;              //!< The number of threads.
+};
+
+
+/**
+ * @brief Return the mean of an array of poses.
+ * 
+ * @details The mean rotation is the chordal L2 mean, i.e., it minimizes
+ * sum(|R - R_i|_F^2), which is the eigenvector of the largest eigenvalue of
+ * sum(q_i * q_i^T), where q_i is the quaternion of R_i. The mean translation
+ * is the arithmetic mean. The sums are accumulated in double by a parallel
+ * reduction over the poses, which reads the given array directly without
+ * any temporary copy.
+ * 
+ * With a robust loss, the mean is refined by the iteratively reweighted 
+ * least squares, where the rotations are weighted by their angles to the 
+ * mean rotation and the translations by their distances to the mean 
+ * translation.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] poses  The poses with unit orthogonal R.
+ * @param [in] num    The number of poses, at least 1.
+ * @param [out] covariance  If not nullptr, the sample covariance of the 
+ *                          residuals [t_i - t; log(R^T * R_i)] around the
+ *                          mean (R, t), with unit weights.
+ * @param [in] options  The options.
+ * 
+ * @return The mean pose.
+ */
+template<typename Scalar>
+PoseT<Scalar> averagePoses(
+        const PoseT<Scalar> *poses, std::size_t num,
+        NonDeduced<Eigen::Matrix<Scalar, 6, 6>> *covariance = nullptr,
+        const AverageOptions& options = AverageOptions());
+
+} // mmath
+#endif // LIB_MATH_POSE_AVERAGE_H_LF
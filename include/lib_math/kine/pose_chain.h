@@ -0,0 +1,196 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		pose_chain.h
+ * 
+ * @brief 		Design a drift-aware accumulator of pose compositions, and the
+ *          	re-orthonormalization kernels of rotation matrices.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_POSE_CHAIN_H_LF
+#define LIB_MATH_POSE_CHAIN_H_LF
+#include <Eigen/Dense>
+#include <cstddef>
+#include "pose.h"
+
+namespace mmath{
+
+/**
+ * @brief Return the orthogonality error of a rotation matrix, i.e., the 
+ * max-abs entry of "R^T * R - I".
+ * 
+ * @details Only the 6 distinct dot products of the columns are computed, 
+ * i.e., 18 multiply-adds instead of the 27 of the full product R^T * R.
+ * mmath::Pose::isUnitOrthogonal() is based on this function.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in] R  The rotation matrix.
+ * 
+ * @return The orthogonality error.
+ */
+template<typename Scalar>
+Scalar orthogonalityError(const Eigen::Matrix<Scalar, 3, 3>& R);
+
+
+/**
+ * @brief Re-orthonormalize a rotation matrix in place.
+ * 
+ * @details The Newton-Schulz iteration of the polar decomposition, 
+ * "R = R * (3I - R^T * R) / 2", is used, which converges quadratically to 
+ * the closest rotation matrix, i.e., one iteration is enough for the drift 
+ * of float compositions. If the error is too large for the iteration to 
+ * converge, i.e., larger than 0.1, the columns are Gram-Schmidt 
+ * orthonormalized first.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in,out] R  The rotation matrix.
+ * @param [in] iterations  The number of Newton-Schulz iterations.
+ */
+template<typename Scalar>
+void orthonormalize(Eigen::Matrix<Scalar, 3, 3>& R, int iterations = 1);
+
+
+/**
+ * @brief Re-orthonormalize an array of rotation matrices in place.
+ * 
+ * @remark This is the base of overloaded functions.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in,out] R  The column-major rotation matrices, 9 * num values, the
+ *                    same layout as mmath::continuum::calcSingleSegmentPoseBatch().
+ * @param [in] num  The number of rotation matrices.
+ * @param [in] iterations  The number of Newton-Schulz iterations.
+ */
+template<typename Scalar>
+void orthonormalizeBatch(Scalar *R, std::size_t num, int iterations = 1);
+
+
+/**
+ * @brief Re-orthonormalize the rotation matrices of an array of poses.
+ * 
+ * @remark This is an overloaded function, provided for convenience. It 
+ * differs from the base function only in what argument(s) it accepts.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ * @param [in,out] poses  The poses.
+ * @param [in] num  The number of poses.
+ * @param [in] iterations  The number of Newton-Schulz iterations.
+ */
+template<typename Scalar>
+void orthonormalizeBatch(PoseT<Scalar> *poses, std::size_t num,
+                         int iterations = 1);
+
+
+/**
+ * @brief A class designed to accumulate long compositions of poses, e.g., 
+ * odometry, without drifting off SO(3).
+ * 
+ * @details Instead of checking the orthogonality after each composition, an
+ * upper bound of the orthogonality error is propagated, i.e., 
+ * "e = e1 + e2 + e1 * e2 + u" for each product, where e1 and e2 are the 
+ * errors of the operands and u is the rounding error of a 3x3 product. The 
+ * rotation is re-orthonormalized by mmath::orthonormalize() only when the 
+ * bound exceeds the threshold.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ */
+template<typename Scalar>
+class PoseChainT
+{
+public:
+    /**
+     * @brief Construct a new PoseChain object.
+     * 
+     * @param pose  The initial pose, which should be unit orthogonal.
+     * @param threshold  The threshold of the error bound, the default value
+     *                   is 1024 * epsilon of Scalar if threshold <= 0.
+     */
+    explicit PoseChainT(const PoseT<Scalar>& pose = PoseT<Scalar>(),
+                        Scalar threshold = 0);
+
+
+    /**
+     * @brief Reset the chain to a pose.
+     * 
+     * @param pose  The pose, which should be unit orthogonal.
+     */
+    void reset(const PoseT<Scalar>& pose = PoseT<Scalar>());
+
+
+    /**
+     * @brief Compose a pose on the right, "pose_chain = pose_chain * pose".
+     * 
+     * @param [in] pose  The pose to be composed.
+     * @param [in] pose_error  The orthogonality error of the given pose, 
+     *                         which is 0 for the exact rotation matrices.
+     */
+    void multiply(const PoseT<Scalar>& pose, Scalar pose_error = 0);
+
+
+    /**
+     * @brief Compose a pose on the right, the same as multiply(pose).
+     * 
+     * @param [in] pose  The pose to be composed.
+     * 
+     * @return This object.
+     */
+    PoseChainT& operator*= (const PoseT<Scalar>& pose);
+
+
+    /**
+     * @brief Re-orthonormalize the rotation now, and reset the bound.
+     */
+    void reorthonormalize();
+
+
+    /**
+     * @brief Return the accumulated pose.
+     */
+    const PoseT<Scalar>& pose() const;
+
+
+    /**
+     * @brief Return the current upper bound of the orthogonality error.
+     */
+    Scalar errorBound() const;
+
+
+    /**
+     * @brief Return the number of re-orthonormalizations since reset().
+     */
+    std::size_t reorthonormalizeCount() const;
+
+
+private:
+    PoseT<Scalar> _pose;       //!< The accumulated pose.
+    Scalar        _threshold;  //!< The threshold of the error bound.
+    Scalar        _bound;      //!< The upper bound of the error.
+    std::size_t   _count;      //!< The number of re-orthonormalizations.
+};
+
+
+extern template class PoseChainT<float>;
+extern template class PoseChainT<double>;
+
+/** The PoseChain with the precision controlled by LIB_MATH_USE_DOUBLE. */
+using PoseChain = PoseChainT<kfloat>;
+
+} // mmath
+#endif // LIB_MATH_POSE_CHAIN_H_LF
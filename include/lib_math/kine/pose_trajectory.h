@@ -0,0 +1,234 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		pose_trajectory.h
+ * 
+ * @brief 		Design a timestamped pose sequence with interpolation and resampling.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_POSE_TRAJECTORY_H_LF
+#define LIB_MATH_POSE_TRAJECTORY_H_LF
+#include <Eigen/Dense>
+#include <vector>
+#include <cstddef>
+#include "pose.h"
+
+namespace mmath{
+
+/** The interpolation modes of mmath::PoseTrajectory. */
+enum class InterpMode
+{
+    SLERP,  //!< SLERP of rotation and linear interpolation of translation.
+    SCLERP, //!< Screw linear interpolation, i.e., constant twist on SE(3).
+    CUBIC   //!< SQUAD of rotation and cubic Hermite of translation.
+};
+
+
+/**
+ * @brief A class designed to store a timestamped pose sequence and resample
+ * it at arbitrary times.
+ * 
+ * @details The rotations are stored as quaternions with continuous signs, so
+ * no conversion is required at query time. Everything needed by the 
+ * interpolation modes, i.e., the twist of each interval for SCLERP and the
+ * control points for CUBIC, is updated in O(1) by push(), thus all the 
+ * queries are const, allocation-free and can be run from many threads.
+ * 
+ * The queries outside [startTime(), endTime()] are clamped to the first or
+ * the last pose.
+ * 
+ * @tparam Scalar  The floating-point type of poses, float or double. The 
+ *                 timestamps are always double.
+ */
+template<typename Scalar>
+class PoseTrajectoryT
+{
+public:
+    using Quaternion = Eigen::Quaternion<Scalar>;
+    using Vector3 = Eigen::Vector<Scalar, 3>;
+    using Vector6 = Eigen::Vector<Scalar, 6>;
+
+
+    /**
+     * @brief Construct a new empty PoseTrajectory object.
+     */
+    PoseTrajectoryT() = default;
+
+
+    /**
+     * @brief Reserve the memory for num poses.
+     * 
+     * @param [in] num  The number of poses.
+     */
+    void reserve(std::size_t num);
+
+
+    /**
+     * @brief Remove all the poses.
+     */
+    void clear();
+
+
+    /**
+     * @brief Append a pose at the end of the trajectory.
+     * 
+     * @param [in] time  The timestamp, which should be larger than endTime().
+     * @param [in] pose  The pose with a unit orthogonal R.
+     * 
+     * @return Whether the pose is appended, false if the time is not
+     * strictly increasing.
+     */
+    bool push(double time, const PoseT<Scalar>& pose);
+
+
+    /**
+     * @brief Return the number of poses.
+     */
+    std::size_t size() const;
+
+
+    /**
+     * @brief Return the timestamp of the i-th pose.
+     */
+    double time(std::size_t i) const;
+
+
+    /**
+     * @brief Return the i-th pose.
+     */
+    PoseT<Scalar> pose(std::size_t i) const;
+
+
+    /**
+     * @brief Return the timestamp of the first pose.
+     */
+    double startTime() const;
+
+
+    /**
+     * @brief Return the timestamp of the last pose.
+     */
+    double endTime() const;
+
+
+    /**
+     * @brief Return the index i of the interval [time(i), time(i + 1)] which
+     * contains the given time.
+     * 
+     * @details The search starts from hint and walks forward, which is O(1) 
+     * for monotone queries. A binary search is used if the time is before 
+     * the hint interval.
+     * 
+     * @param [in] time  The query time.
+     * @param [in] hint  The index of the interval of a previous query.
+     * 
+     * @return The index in [0, size() - 2], the trajectory should have at
+     * least two poses.
+     */
+    std::size_t findInterval(double time, std::size_t hint = 0) const;
+
+
+    /**
+     * @brief Return the interpolated pose at the given time.
+     * 
+     * @remark This is the base of overloaded functions.
+     * 
+     * @param [in] time  The query time.
+     * @param [in] mode  The interpolation mode.
+     * 
+     * @return A new Pose object.
+     */
+    PoseT<Scalar> at(double time, InterpMode mode = InterpMode::SLERP) const;
+
+
+    /**
+     * @brief Resample the trajectory at the given times.
+     * 
+     * @remark This is the base of overloaded functions.
+     * 
+     * @param [in] times  The query times, the interval lookup is incremental
+     *                    if they are ascending.
+     * @param [in] num    The number of query times.
+     * @param [out] poses The interpolated poses, num Pose objects.
+     * @param [in] mode   The interpolation mode.
+     */
+    void resample(const double *times, std::size_t num, PoseT<Scalar> *poses,
+                  InterpMode mode = InterpMode::SLERP) const;
+
+
+    /**
+     * @brief Resample the trajectory at 'num' times between 'start' and 
+     * 'end', which are the same as mmath::linspaceN() but generated on the
+     * fly without a vector.
+     * 
+     * @remark This is an overloaded function, provided for convenience. It 
+     * differs from the base function only in what argument(s) it accepts.
+     * 
+     * @param [in] start  The start time.
+     * @param [in] end    The end time.
+     * @param [in] num    The number of query times.
+     * @param [out] poses The interpolated poses, num Pose objects.
+     * @param [in] mode   The interpolation mode.
+     */
+    void resample(double start, double end, int num, PoseT<Scalar> *poses,
+                  InterpMode mode = InterpMode::SLERP) const;
+
+
+    /**
+     * @brief Resample the trajectory at the given times.
+     * 
+     * @remark This is an overloaded function, provided for convenience. It 
+     * differs from the base function only in what argument(s) it accepts.
+     * 
+     * @param [in] times  The query times.
+     * @param [out] poses The interpolated poses, resized to times.size().
+     * @param [in] mode   The interpolation mode.
+     */
+    void resample(const std::vector<double>& times,
+                  std::vector<PoseT<Scalar>>& poses,
+                  InterpMode mode = InterpMode::SLERP) const;
+
+
+private:
+    /** Return the pose in the interval i at time. */
+    PoseT<Scalar> interpolate(std::size_t i, double time, InterpMode mode) const;
+
+
+    /** Update the cubic control point and tangent of the i-th pose. */
+    void updateControl(std::size_t i);
+
+
+    std::vector<double>     _times; //!< The timestamps.
+    std::vector<Quaternion> _qs;    //!< The rotations with continuous signs.
+    std::vector<Vector3>    _ts;    //!< The translations.
+    std::vector<Vector6>    _xis;   //!< The twist of each interval.
+    std::vector<Quaternion> _ss;    //!< The SQUAD control quaternions.
+    std::vector<Vector3>    _ms;    //!< The tangents of translations.
+};
+
+
+extern template class PoseTrajectoryT<float>;
+extern template class PoseTrajectoryT<double>;
+
+/** The PoseTrajectory with the precision controlled by LIB_MATH_USE_DOUBLE. */
+using PoseTrajectory = PoseTrajectoryT<kfloat>;
+
+} // mmath
+#endif // LIB_MATH_POSE_TRAJECTORY_H_LF
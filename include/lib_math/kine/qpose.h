@@ -0,0 +1,231 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		qpose.h
+ * 
+ * @brief 		Define a compact pose stored as a quaternion and a translation.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_QPOSE_H_LF
+#define LIB_MATH_QPOSE_H_LF
+#include <Eigen/Dense>
+#include "pose.h"
+
+namespace mmath{
+
+/** 
+ * @brief A class designed to describe the transformation with 7 scalars.
+ * 
+ * @details There are two members include in this class:
+ *   q  --  denotes the rotation or orientation by a unit quaternion.
+ *   t  --  denotes the translation or position.
+ * The members are not aligned, so a QPoseT<float> takes 28 bytes and the 
+ * objects can be packed contiguously in large buffers, e.g., std::vector.
+ * 
+ * The composition, inversion and point transform are computed on the 
+ * quaternion directly. Compared with mmath::Pose, no conversion between the 
+ * rotation matrix and the quaternion is required in filters.
+ * 
+ * @tparam Scalar  The floating-point type, float or double.
+ */
+template<typename Scalar>
+class QPoseT
+{
+public:
+    using Quaternion = Eigen::Quaternion<Scalar, Eigen::DontAlign>;
+    using Vector3 = Eigen::Matrix<Scalar, 3, 1, Eigen::DontAlign>;
+
+
+    /**
+     * @brief Construct a new QPose object, which is identity by default.
+     * 
+     * @param q  The rotation, which should be a unit quaternion.
+     * @param t  The translation vector.
+     */
+    QPoseT(const Quaternion& q = Quaternion::Identity(),
+           const Vector3& t = Vector3::Zero())
+        : q(q), t(t)
+    {}
+
+
+    /**
+     * @brief Construct a new QPose object from a Pose.
+     * 
+     * @param pose  The Pose object, whose R should be unit orthogonal.
+     */
+    explicit QPoseT(const PoseT<Scalar>& pose)
+        : q(pose.R), t(pose.t)
+    {}
+
+
+    /**
+     * @brief Convert to a Pose object.
+     * 
+     * @note The conversion between a unit orthogonal R and a unit quaternion 
+     * does not lose any information, i.e., a round trip only introduces 
+     * rounding errors.
+     * 
+     * @return A new Pose object.
+     */
+    PoseT<Scalar> toPose() const
+    {
+        PoseT<Scalar> pose;
+        pose.R = q.toRotationMatrix();
+        pose.t = t;
+        return pose;
+    }
+
+
+    /**
+     * @brief Multiplication with another pose, "new_pose = (*this) * pose".
+     * 
+     * @param [in] pose The another QPose object.
+     * 
+     * @return A new QPose object.
+     */
+    QPoseT operator* (const QPoseT& pose) const
+    {
+        return QPoseT(q * pose.q, q * pose.t + t);
+    }
+
+
+    /**
+     * @brief Multiplication with another pose, "(*this) = (*this) * pose".
+     * 
+     * @param [in] pose The another QPose object.
+     * 
+     * @return This object.
+     */
+    QPoseT& operator*= (const QPoseT& pose)
+    {
+        t += q * pose.t;
+        q *= pose.q;
+        return *this;
+    }
+
+
+    /**
+     * @brief Transform a given point, which is "ret = q * p + t".
+     * 
+     * @param [in] p  The point.
+     * 
+     * @return A new point, an object of class Eigen::Vector<Scalar, 3>.
+     */
+    Eigen::Vector<Scalar, 3> operator* (const Eigen::Vector<Scalar, 3>& p) const
+    {
+        return q * p + t;
+    }
+
+
+    /**
+     * @brief Return the inverse of the pose.
+     * 
+     * @return A new QPose object.
+     */
+    QPoseT inverse() const
+    {
+        Quaternion q_inv = q.conjugate();
+        return QPoseT(q_inv, -(q_inv * t));
+    }
+
+
+    /**
+     * @brief Normalize the quaternion, e.g., after many compositions.
+     */
+    void normalize()
+    {
+        q.normalize();
+    }
+
+
+    /**
+     * @brief Flip the sign of q to the one converted from the rotation
+     * matrix, i.e., mmath::Pose::q(), where w > 0 if trace(R) > 0, otherwise
+     * the component of x, y, z with the largest magnitude is positive.
+     */
+    void canonicalize()
+    {
+        // trace(R)*|q|^2 = 3w^2 - x^2 - y^2 - z^2, and the largest diagonal
+        // entry of R is the one of the largest component of x, y, z
+        const Scalar w2 = q.w() * q.w();
+        const Eigen::Array<Scalar, 3, 1> v2 = q.vec().array().square();
+        int i = 0;
+        if(3 * w2 - v2.sum() > 0) {
+            i = 3;
+        }
+        else {
+            if(v2[1] > v2[0]) i = 1;
+            if(v2[2] > v2[i]) i = 2;
+        }
+        if(q.coeffs()[i] < 0) {
+            q.coeffs() = -q.coeffs();
+        }
+    }
+
+
+    /**
+     * @brief Add a increment to current pose object, which is the same as
+     * mmath::Pose::increase() but without the matrix conversion. The sign of
+     * q is canonicalized first, as Pose::q() does.
+     * 
+     * @param [in] dq  The increment of rotation/orientation.
+     * @param [in] dt  The increament of translation/position.
+     */
+    void increase(const Eigen::Quaternion<Scalar>& dq,
+                  const Eigen::Vector<Scalar, 3>& dt)
+    {
+        canonicalize();
+        q.coeffs() += dq.coeffs();
+        q.normalize();
+        t += dt;
+    }
+
+
+    /**
+     * @brief Minus a increment to current pose object, which is the same as
+     * mmath::Pose::decrease() but without the matrix conversion. The sign of
+     * q is canonicalized first, as Pose::q() does.
+     * 
+     * @param [in] dq  The increment of rotation/orientation.
+     * @param [in] dt  The increament of translation/position.
+     */
+    void decrease(const Eigen::Quaternion<Scalar>& dq,
+                  const Eigen::Vector<Scalar, 3>& dt)
+    {
+        canonicalize();
+        q.coeffs() -= dq.coeffs();
+        q.normalize();
+        t -= dt;
+    }
+
+
+    Quaternion q; //!< The rotation/orientation quaternion
+    Vector3    t; //!< The translation/position vector
+};
+
+static_assert(sizeof(QPoseT<float>) == 7 * sizeof(float), "Unexpected size");
+static_assert(sizeof(QPoseT<double>) == 7 * sizeof(double), "Unexpected size");
+
+
+/** The QPose with the precision controlled by LIB_MATH_USE_DOUBLE. */
+using QPose = QPoseT<kfloat>;
+
+} // mmath
+#endif // LIB_MATH_QPOSE_H_LF
@@ -0,0 +1,220 @@
+/**--------------------------------------------------------------------
+ *
+ *   				   Mathematics extension library
+ *
+ * Description:
+ * This file is part of lib_math. You can redistribute it and or modify
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ *
+ * @file 		singularity_monitor.h
+ *
+ * @brief 		Design the streaming monitor of the manipulability and the
+ *              singularity of Jacobians, for the control loops.
+ *
+ * @author		Longfei Wang
+ *
+ * @date		2026/10/16
+ *
+ * @license		MIT
+ *
+ * Copyright (C) 2019-Now Longfei Wang.
+ *
+ * --------------------------------------------------------------------
+ * Change History:
+ *
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_SINGULARITY_MONITOR_H_LF
+#define LIB_MATH_SINGULARITY_MONITOR_H_LF
+#include <Eigen/Dense>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "../math_precision.h"
+
+namespace mmath{
+
+/**
+ * @brief The measures of a Jacobian J, which are taken from the singular
+ * values of J, i.e., the square roots of the eigenvalues of the smaller one of
+ * J*J^T and J^T*J.
+ */
+template<typename Scalar>
+struct SingularityMeasureT
+{
+    Scalar manipulability = 0;  //!< sqrt(det(J*J^T)), the product of sigma.
+    Scalar sigma_min = 0;       //!< The minimum singular value.
+    Scalar sigma_max = 0;       //!< The maximum singular value.
+    Scalar condition = 0;       //!< sigma_max/sigma_min, inf if singular.
+};
+
+
+/**
+ * @brief Calculate the measures of a Jacobian with at most 6 rows or 6
+ * columns.
+ *
+ * @details The Gram matrix of the smaller side is formed in fixed-capacity
+ * storage, so no memory is allocated. Its eigenvalues are taken in closed form
+ * for the sizes of 1, 2 and 3, which cover the Jacobians of a single segment,
+ * e.g., calcSingleSegmentJacobian() and calcVariableLengthSegmentJacobian(),
+ * and by the fixed-capacity self-adjoint solver for the sizes up to 6.
+ * The Gram matrix squares the condition number, thus it is formed and solved
+ * in double for a float J too, otherwise sigma_min of a nearly straight
+ * segment would be lost in the float rounding.
+ *
+ * @note The rows of Velocity and Angular-Velocity have different units, so a
+ * 6xN Jacobian may be scaled by a characteristic length by the caller first.
+ *
+ * @param [in] J  The Jacobian, where min(rows, cols) should be in [1, 6]. A
+ *                column-major matrix or block is referred without a copy.
+ *
+ * @return The measures.
+ */
+template<typename Scalar>
+SingularityMeasureT<Scalar> calcSingularityMeasure(
+        const Eigen::Ref<const Eigen::Matrix<Scalar, Eigen::Dynamic,
+        Eigen::Dynamic>>& J);
+
+
+/**
+ * @brief A class designed to monitor the singularity of a stream of
+ * Jacobians at control rate.
+ *
+ * @details Each update() calculates the measures of a Jacobian, pushes them
+ * into a ring buffer of the last window samples for the rolling statistics,
+ * and compares them with the thresholds. The callback is invoked when the set
+ * of the violated thresholds changes, i.e., on entering, changing and leaving
+ * the near-singular state. A violated threshold is released only after the
+ * measure passes the threshold by the hysteresis ratio, so a measure hovering
+ * around the threshold does not flood the callback.
+ *
+ * The buffer is allocated in the constructor, and update() never allocates
+ * memory except by the callback itself.
+ *
+ * @tparam Scalar  The floating-point type, float or double.
+ */
+template<typename Scalar>
+class SingularityMonitorT
+{
+public:
+    using Measure = SingularityMeasureT<Scalar>;
+
+    /** The flags of the violated thresholds. */
+    enum Flag : uint32_t
+    {
+        LOW_MANIPULABILITY  = 1u << 0,  //!< manipulability < threshold.
+        LOW_SIGMA_MIN       = 1u << 1,  //!< sigma_min < threshold.
+        HIGH_CONDITION      = 1u << 2   //!< condition > threshold.
+    };
+
+    /**
+     * @brief The callback with the current measure and flags, where flags is
+     * 0 when leaving the near-singular state.
+     */
+    using Callback = std::function<void(const Measure& measure,
+                                        uint32_t flags)>;
+
+    /** The rolling statistics over the window. */
+    struct Stats
+    {
+        std::size_t count = 0;              //!< The number of samples.
+        Scalar manipulability_mean = 0;     //!< The mean of manipulability.
+        Scalar manipulability_min = 0;      //!< The min of manipulability.
+        Scalar sigma_min_mean = 0;          //!< The mean of sigma_min.
+        Scalar sigma_min_min = 0;           //!< The min of sigma_min.
+        Scalar condition_max = 0;           //!< The max of condition.
+    };
+
+
+    /**
+     * @brief Construct a new SingularityMonitor object.
+     *
+     * @param window  The number of the latest samples in the statistics.
+     */
+    explicit SingularityMonitorT(std::size_t window = 100);
+
+
+    /**
+     * @brief Set the thresholds, where a non-positive value disables a
+     * threshold. All the thresholds are disabled by default.
+     *
+     * @param min_manipulability  The threshold of the manipulability.
+     * @param min_sigma           The threshold of the minimum singular value.
+     * @param max_condition       The threshold of the condition number.
+     * @param hysteresis          The ratio that a measure should pass its
+     *                            threshold by to release the flag.
+     */
+    void setThresholds(Scalar min_manipulability, Scalar min_sigma,
+                       Scalar max_condition, Scalar hysteresis = Scalar(0.1));
+
+
+    /**
+     * @brief Set the callback, which is invoked in update().
+     */
+    void setCallback(Callback callback);
+
+
+    /**
+     * @brief Update the monitor with a Jacobian.
+     *
+     * @param [in] J  The Jacobian, see calcSingularityMeasure().
+     *
+     * @return The measure of J.
+     *
+     * @see mmath::calcSingularityMeasure().
+     */
+    const Measure& update(
+            const Eigen::Ref<const Eigen::Matrix<Scalar, Eigen::Dynamic,
+            Eigen::Dynamic>>& J);
+
+
+    /**
+     * @brief Return the measure of the latest update().
+     */
+    const Measure& measure() const;
+
+
+    /**
+     * @brief Return the flags of the violated thresholds.
+     */
+    uint32_t flags() const;
+
+
+    /**
+     * @brief Return the rolling statistics over the window, which scans the
+     * buffer, thus it is not necessary to be called at control rate.
+     */
+    Stats stats() const;
+
+
+    /**
+     * @brief Clear the samples and the flags, and keep the thresholds and the
+     * callback.
+     */
+    void reset();
+
+private:
+    uint32_t checkFlags(const Measure& measure) const;
+
+    std::vector<Measure> _samples;          //!< The ring buffer.
+    std::size_t          _next;             //!< The next slot of the buffer.
+    std::size_t          _count;            //!< The number of samples.
+    Measure              _measure;
+    uint32_t             _flags;
+    Scalar               _min_manipulability;
+    Scalar               _min_sigma;
+    Scalar               _max_condition;
+    Scalar               _hysteresis;
+    Callback             _callback;
+};
+
+
+extern template class SingularityMonitorT<float>;
+extern template class SingularityMonitorT<double>;
+
+/** The SingularityMonitor with the precision controlled by LIB_MATH_USE_DOUBLE. */
+using SingularityMonitor = SingularityMonitorT<kfloat>;
+
+} // mmath
+#endif // LIB_MATH_SINGULARITY_MONITOR_H_LF
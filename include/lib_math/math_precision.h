@@ -21,6 +21,7 @@
  *
  * --------------------------------------------------------------------
  * Change History:
+ * 2026/10/16 Add NonDeduced for the scalar-templated kinematics.
  *
  * -------------------------------------------------------------------*/
 #ifndef LIB_MATH_PRECISION_H_LF
@@ -38,5 +39,21 @@ using kfloat = double;
 using kfloat = float;
 #endif
 
+
+/** 
+ * The kinematics-related interfaces are templated on the scalar type, e.g.,
+ * PoseT<float> and PoseT<double>, which can be used together in one process.
+ * The non-templated names, e.g., Pose, are the aliases of the kfloat version.
+ *
+ * NonDeduced<T> is used for the scalar arguments of the templated functions,
+ * so that the scalar type is only deduced from the Pose/ConfigSpc/Eigen 
+ * arguments, and literals such as 0 or 1.0 can still be passed.
+ */
+template<typename T>
+struct TypeIdentity { using type = T; };
+
+template<typename T>
+using NonDeduced = typename TypeIdentity<T>::type;
+
 } //namespace::mmath
 #endif // LIB_MATH_KINE_PRECISION_H_LF
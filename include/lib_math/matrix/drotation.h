@@ -23,6 +23,7 @@
  * Change History:                        
  * 
  * 2022/06/27  Complete the file.
+ * 2026/10/16  Support the AD scalar types.
  * 
  * -------------------------------------------------------------------*/
 #ifndef LIB_MATH_DROTATION_H_LF
@@ -47,9 +48,6 @@ namespace mmath{
  */
 template<typename T = double, typename T1 = double>
 Eigen::Matrix<T, 3, 3> dRotByX(const T1 radian){
-	if (!std::is_arithmetic<T1>::value) {
-		std::abort();
-    }
     Eigen::Vector3d x(1, 0, 0);
     return skewSymmetric<T>(x) * rotByX<T>(radian);
 }
@@ -86,9 +84,6 @@ Eigen::Matrix3f dRotByXf(const T1 radian) {
  */
 template<typename T = double, typename T1 = double>
 Eigen::Matrix<T, 3, 3> dRotByY(const T1 radian) {
-	if (!std::is_arithmetic<T1>::value) {
-        std::abort();
-    }
     Eigen::Vector3d y(0, 1, 0);
     return skewSymmetric<T>(y) * rotByY<T>(radian);
 }
@@ -125,9 +120,6 @@ Eigen::Matrix3f dRotByYf(const T1 radian) {
  */
 template<typename T = double, typename T1 = double>
 Eigen::Matrix<T, 3, 3> dRotByZ(const T1 radian) {
-	if (!std::is_arithmetic<T1>::value) {
-		std::abort();
-    }
     Eigen::Vector3d z(0, 0, 1);
     return skewSymmetric<T>(z) * rotByZ<T>(radian);
 }
@@ -24,6 +24,7 @@
  * 
  * 2021/07/29 Complete the doxygen comments.
  * 2022/06/06  Complete the doxygen comments.
+ * 2026/10/16  Support the AD scalar types by ADL of sin/cos.
  * 
  * -------------------------------------------------------------------*/
 #ifndef LIB_MATH_ROTATION_H_LF
@@ -46,9 +47,8 @@ namespace mmath{
  */
 template<typename T = double, typename T1 = double>
 Eigen::Matrix<T, 3, 3> rotByX(const T1 radian) {
-	if (!std::is_arithmetic<T1>::value){
-		std::abort();
-	}
+	using std::cos;
+	using std::sin;
 	Eigen::Matrix<T, 3, 3> rot;
 	rot << static_cast<T>(1), static_cast<T>(0), static_cast<T>(0),
 		static_cast<T>(0), static_cast<T>(cos(radian)), static_cast<T>(-sin(radian)),
@@ -86,9 +86,8 @@ Eigen::Matrix3f rotByXf(const T1 radian) {
  */
 template<typename T = double, typename T1 = double>
 Eigen::Matrix<T, 3, 3> rotByY(const T1 radian) {
-	if (!std::is_arithmetic<T1>::value){
-		std::abort();
-	}
+	using std::cos;
+	using std::sin;
 	Eigen::Matrix<T, 3, 3> rot;
 	rot << static_cast<T>(cos(radian)), static_cast<T>(0), static_cast<T>(sin(radian)),
 		static_cast<T>(0), static_cast<T>(1), static_cast<T>(0),
@@ -126,9 +125,8 @@ Eigen::Matrix3f rotByYf(const T1 radian) {
  */
 template<typename T = double, typename T1 = double>
 Eigen::Matrix<T, 3, 3> rotByZ(const T1 radian) {
-	if (!std::is_arithmetic<T1>::value){
-		std::abort();
-	}
+	using std::cos;
+	using std::sin;
 	Eigen::Matrix<T, 3, 3> rot;
 	rot << static_cast<T>(cos(radian)), static_cast<T>(-sin(radian)), static_cast<T>(0),
 		static_cast<T>(sin(radian)), static_cast<T>(cos(radian)), static_cast<T>(0),
@@ -0,0 +1,167 @@
+/**--------------------------------------------------------------------
+ *																		
+ *   				   Mathematics extension library 					
+ *																		
+ * Description:													
+ * This file is part of lib_math. You can redistribute it and or modify 
+ * it to construct your own project. It is wellcome to use this library
+ * in your scientific research work.
+ * 
+ * @file 		format.h
+ * 
+ * @brief 		Reentrant and allocation-free formatting of numbers into
+ *          	caller-provided buffers.
+ * 
+ * @author		Longfei Wang
+ * 
+ * @date		2026/10/16
+ * 
+ * @license		MIT
+ * 
+ * Copyright (C) 2019-Now Longfei Wang.
+ * 
+ * --------------------------------------------------------------------
+ * Change History:                        
+ * 
+ * -------------------------------------------------------------------*/
+#ifndef LIB_MATH_FORMAT_H_LF
+#define LIB_MATH_FORMAT_H_LF
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+
+namespace mmath{
+
+/**
+ * @brief Format a floating-point value in fixed-point notation, the same as 
+ * "%.*f" of printf, into a caller-provided buffer.
+ *
+ * @details The value is formatted by integer arithmetic, which is much faster
+ * than printf and uses no locale, static or heap memory, thus it is safe to
+ * be called from many threads at the same time. Values whose magnitude is not
+ * less than 1e18 fall back to snprintf().
+ *
+ * @param [out] buf    The buffer. The output is always null-terminated if 
+ *                     size > 0, and is truncated if the buffer is too small.
+ * @param [in] size    The size of the buffer.
+ * @param [in] value   The value to be formatted.
+ * @param [in] precision  The number of digits after the decimal point, which
+ *                        should be in [0, 9].
+ *
+ * @return The length of the formatted string (excluding the null character),
+ * the output is truncated if the returned value is not less than size.
+ */
+inline int formatFixed(char *buf, std::size_t size, double value,
+                       int precision = 6) {
+    if (precision < 0) precision = 0;
+    if (precision > 9) precision = 9;
+
+    if (std::isnan(value) || std::isinf(value) || std::fabs(value) >= 1e18) {
+        return snprintf(buf, size, "%.*f", precision, value);
+    }
+
+    static constexpr uint64_t POW10[10] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+        1000000000
+    };
+    bool is_negative = std::signbit(value);
+    double v = std::fabs(value);
+    uint64_t ipart = static_cast<uint64_t>(v);
+    uint64_t fpart = static_cast<uint64_t>(
+                std::llround((v - static_cast<double>(ipart)) * POW10[precision]));
+    if (fpart >= POW10[precision]) {
+        ipart += 1;
+        fpart -= POW10[precision];
+    }
+
+    // Compose from the end of a local buffer
+    char tmp[40];
+    int pos = sizeof(tmp);
+    for (int i = 0; i < precision; i++) {
+        tmp[--pos] = static_cast<char>('0' + fpart % 10);
+        fpart /= 10;
+    }
+    if (precision > 0) tmp[--pos] = '.';
+    do {
+        tmp[--pos] = static_cast<char>('0' + ipart % 10);
+        ipart /= 10;
+    } while (ipart > 0);
+    if (is_negative) tmp[--pos] = '-';
+
+    int len = static_cast<int>(sizeof(tmp)) - pos;
+    if (size > 0) {
+        std::size_t n = static_cast<std::size_t>(len) < size ? len : size - 1;
+        for (std::size_t i = 0; i < n; i++) buf[i] = tmp[pos + i];
+        buf[n] = '\0';
+    }
+    return len;
+}
+
+
+/**
+ * @brief A tiny writer that appends strings and numbers into a caller-provided
+ * buffer, which is designed to compose the info of an object without any 
+ * static or heap memory.
+ */
+class FormatWriter
+{
+public:
+    /**
+     * @brief Construct a new FormatWriter object.
+     *
+     * @param buf   The buffer.
+     * @param size  The size of the buffer.
+     */
+    FormatWriter(char *buf, std::size_t size) : _buf(buf), _size(size), _len(0)
+    {
+        if (_size > 0) _buf[0] = '\0';
+    }
+
+    /**
+     * @brief Append a null-terminated string.
+     */
+    FormatWriter& append(const char *str) {
+        for (; *str; str++) {
+            if (static_cast<std::size_t>(_len) + 1 < _size) {
+                _buf[_len] = *str;
+                _buf[_len + 1] = '\0';
+            }
+            _len++;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Append a value in fixed-point notation.
+     *
+     * @see mmath::formatFixed().
+     */
+    FormatWriter& append(double value, int precision) {
+        std::size_t left = static_cast<std::size_t>(_len) < _size ?
+                    _size - _len : 0;
+        _len += formatFixed(_buf + (left ? _len : 0), left, value, precision);
+        return *this;
+    }
+
+    /**
+     * @brief Append an integer.
+     */
+    FormatWriter& append(int value) {
+        return append(static_cast<double>(value), 0);
+    }
+
+    /**
+     * @brief Return the length of the composed string, the output is 
+     * truncated if the returned value is not less than the buffer size.
+     */
+    int length() const { return _len; }
+
+private:
+    char        *_buf;
+    std::size_t _size;
+    int         _len;
+};
+
+} // mmath
+#endif // LIB_MATH_FORMAT_H_LF
@@ -0,0 +1,194 @@
+#include "../include/lib_math/kine/continuum_actuation.h"
+#include "../include/lib_math/kine/continuum_terms.h"
+#include "../include/lib_math/util/angle.h"
+#include <cassert>
+#include <cmath>
+
+namespace mmath{
+namespace continuum{
+
+template<typename Scalar>
+SegmentActuationT<Scalar>::SegmentActuationT(int backbone_num,
+                                             Scalar pitch_radius, Scalar phase)
+    : _backbone_num(backbone_num)
+    , _pitch_radius(pitch_radius)
+    , _phase(phase)
+    , _cos(backbone_num)
+    , _sin(backbone_num)
+{
+    assert(backbone_num >= 3 && pitch_radius > 0);
+    for(int i = 0; i < backbone_num; i++) {
+        double sigma = _phase + 2 * PI * i / backbone_num;
+        _cos[i] = static_cast<Scalar>(std::cos(sigma));
+        _sin[i] = static_cast<Scalar>(std::sin(sigma));
+    }
+}
+
+
+template<typename Scalar>
+int SegmentActuationT<Scalar>::backboneNum() const
+{
+    return _backbone_num;
+}
+
+
+template<typename Scalar>
+Scalar SegmentActuationT<Scalar>::pitchRadius() const
+{
+    return _pitch_radius;
+}
+
+
+template<typename Scalar>
+Scalar SegmentActuationT<Scalar>::backboneAngle(int i) const
+{
+    return static_cast<Scalar>(_phase + 2 * PI * i / _backbone_num);
+}
+
+
+template<typename Scalar>
+void SegmentActuationT<Scalar>::calcLengths(const ConfigSpcT<Scalar> &q,
+                                            Scalar *lengths) const
+{
+    if(!q.is_bend) {
+        for(int i = 0; i < _backbone_num; i++) {
+            lengths[i] = q.length;
+        }
+        return;
+    }
+
+    // l_i = L - r*theta*(cos(delta)*cos(sigma_i) + sin(delta)*sin(sigma_i))
+    const Scalar rc = _pitch_radius * q.theta * std::cos(q.delta);
+    const Scalar rs = _pitch_radius * q.theta * std::sin(q.delta);
+    for(int i = 0; i < _backbone_num; i++) {
+        lengths[i] = q.length - rc * _cos[i] - rs * _sin[i];
+    }
+}
+
+
+template<typename Scalar>
+void SegmentActuationT<Scalar>::calcLengthsBatch(const ConfigSpcT<Scalar> *qs,
+                                                 std::size_t num,
+                                                 Scalar *lengths) const
+{
+    for(std::size_t k = 0; k < num; k++) {
+        calcLengths(qs[k], lengths + k * _backbone_num);
+    }
+}
+
+
+template<typename Scalar>
+void SegmentActuationT<Scalar>::calcConfig(const Scalar *lengths,
+                                           ConfigSpcT<Scalar> &q) const
+{
+    Scalar sum = 0, a = 0, b = 0;
+    for(int i = 0; i < _backbone_num; i++) {
+        sum += lengths[i];
+        a += lengths[i] * _cos[i];
+        b += lengths[i] * _sin[i];
+    }
+    // The sums of cos(sigma_i) and sin(sigma_i) are zero, so L cancels out
+    const Scalar k = Scalar(-2) / _backbone_num;
+    a *= k;
+    b *= k;
+    q.theta = std::sqrt(a * a + b * b) / _pitch_radius;
+    q.delta = std::atan2(b, a);
+    q.length = sum / _backbone_num;
+    q.is_bend = true;
+}
+
+
+template<typename Scalar>
+ConfigSpcT<Scalar> SegmentActuationT<Scalar>::calcConfig(
+        const Scalar *lengths) const
+{
+    ConfigSpcT<Scalar> q;
+    calcConfig(lengths, q);
+    return q;
+}
+
+
+template<typename Scalar>
+void SegmentActuationT<Scalar>::calcConfigBatch(const Scalar *lengths,
+                                                std::size_t num,
+                                                ConfigSpcT<Scalar> *qs) const
+{
+    for(std::size_t k = 0; k < num; k++) {
+        calcConfig(lengths + k * _backbone_num, qs[k]);
+    }
+}
+
+
+template<typename Scalar>
+void SegmentActuationT<Scalar>::calcLengthJacobian(
+        const ConfigSpcT<Scalar> &q,
+        Eigen::Ref<Eigen::Matrix<Scalar, Eigen::Dynamic, 3>> Jl) const
+{
+    assert(Jl.rows() == _backbone_num);
+    if(!q.is_bend) {
+        Jl.setZero();
+        Jl.col(2).setOnes();
+        return;
+    }
+
+    const Scalar r = _pitch_radius;
+    const Scalar sd = std::sin(q.delta), cd = std::cos(q.delta);
+    for(int i = 0; i < _backbone_num; i++) {
+        // cos(delta - sigma_i) and sin(delta - sigma_i)
+        const Scalar c = cd * _cos[i] + sd * _sin[i];
+        const Scalar s = sd * _cos[i] - cd * _sin[i];
+        Jl(i, 0) = -r * c;
+        Jl(i, 1) = r * q.theta * s;
+        Jl(i, 2) = 1;
+    }
+}
+
+
+template<typename Scalar>
+void SegmentActuationT<Scalar>::calcActuationJacobian(
+        const ConfigSpcT<Scalar> &q, Scalar Lr,
+        Eigen::Ref<Eigen::Matrix<Scalar, 3, Eigen::Dynamic>> Jv,
+        Eigen::Ref<Eigen::Matrix<Scalar, 3, Eigen::Dynamic>> Jw) const
+{
+    assert(Jv.cols() == _backbone_num && Jw.cols() == _backbone_num);
+    const Scalar inv_n = Scalar(1) / _backbone_num;
+    if(!q.is_bend) {
+        Jv.setZero();
+        Jv.row(2).setConstant(inv_n);
+        Jw.setZero();
+        return;
+    }
+
+    const Scalar L = q.length;
+    SegmentThetaTerms<Scalar> t;
+    calcSegmentThetaTerms<Scalar>(q.theta, t);
+    const Scalar sd = std::sin(q.delta), cd = std::cos(q.delta);
+
+    // The columns w.r.t theta, delta/theta and L of the segment Jacobian
+    const Eigen::Vector<Scalar, 3> Jv_theta(L*cd*t.df1 + Lr*cd*t.c,
+                                            L*sd*t.df1 + Lr*sd*t.c,
+                                            L*t.df2 - Lr*t.s);
+    const Scalar k = L*t.f1_theta + Lr*t.f2;
+    const Eigen::Vector<Scalar, 3> Jv_delta(-k*sd, k*cd, 0);
+    const Eigen::Vector<Scalar, 3> Jv_L(cd*t.f1, sd*t.f1, t.f2);
+    const Eigen::Vector<Scalar, 3> Jw_theta(-sd, cd, 0);
+    const Eigen::Vector<Scalar, 3> Jw_delta(-t.f2*cd, -t.f2*sd, t.f1);
+
+    // dtheta/dl_i = -2/(N*r)*cos(delta - sigma_i),
+    // theta*ddelta/dl_i = 2/(N*r)*sin(delta - sigma_i), dL/dl_i = 1/N
+    const Scalar k2 = 2 * inv_n / _pitch_radius;
+    for(int i = 0; i < _backbone_num; i++) {
+        const Scalar c = cd * _cos[i] + sd * _sin[i];
+        const Scalar s = sd * _cos[i] - cd * _sin[i];
+        const Scalar dtheta = -k2 * c, ddelta = k2 * s;
+        Jv.col(i) = dtheta * Jv_theta + ddelta * Jv_delta + inv_n * Jv_L;
+        Jw.col(i) = dtheta * Jw_theta + ddelta * Jw_delta;
+    }
+}
+
+
+/* Explicit instantiations for float and double */
+template class SegmentActuationT<float>;
+template class SegmentActuationT<double>;
+
+}} // mmath::continuum
@@ -0,0 +1,368 @@
+#include "../include/lib_math/kine/continuum_approx.h"
+#include "../include/lib_math/kine/continuum_pose.h"
+#include "../include/lib_math/kine/continuum_terms.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace mmath{
+namespace continuum{
+
+namespace {
+/** The max degree of the polynomials. */
+constexpr int MAX_DEGREE = 8;
+
+/** The number of the samples in each piece to measure the term error. */
+constexpr int ERROR_SAMPLE_NUM = 32;
+
+
+/** The exact [sin, cos, f1, f2, df1, df2] of theta, in double. */
+void exactThetaTerms(double theta, double *terms)
+{
+    SegmentThetaTerms<double> exact;
+    calcSegmentThetaTerms(theta, exact);
+    terms[0] = exact.s;
+    terms[1] = exact.c;
+    terms[2] = exact.f1;
+    terms[3] = exact.f2;
+    terms[4] = exact.df1;
+    terms[5] = exact.df2;
+}
+
+
+/** The exact [sin, cos] of delta, in double. */
+void exactDeltaTerms(double delta, double *terms)
+{
+    terms[0] = std::sin(delta);
+    terms[1] = std::cos(delta);
+}
+
+
+/**
+ * Fit M functions in [lo, hi] by interval_num pieces of the Chebyshev
+ * interpolants, and store them in the power basis of u in [-1, 1].
+ */
+template<typename Scalar, int M, typename Func>
+void fitPiecewise(double lo, double hi, int interval_num, int degree,
+                  Func func, std::vector<Scalar> &coeffs)
+{
+    const int n = degree + 1;
+    const double h = (hi - lo) / interval_num;
+    coeffs.assign(static_cast<std::size_t>(interval_num) * n * M, 0);
+
+    // The power coefficients of the Chebyshev polynomials T_0, ..., T_degree
+    std::vector<double> T(n * n, 0);
+    T[0] = 1;
+    if(n > 1) T[n + 1] = 1;
+    for(int k = 2; k < n; k++) {
+        for(int p = 0; p < n; p++) {
+            double v = -T[(k - 2)*n + p];
+            if(p > 0) v += 2 * T[(k - 1)*n + p - 1];
+            T[k*n + p] = v;
+        }
+    }
+
+    std::vector<double> f(n * M), c(n);
+    for(int i = 0; i < interval_num; i++) {
+        const double mid = lo + (i + 0.5) * h;
+        for(int j = 0; j < n; j++) {
+            double u = std::cos(PI * (j + 0.5) / n);
+            func(mid + 0.5 * h * u, &f[j * M]);
+        }
+        for(int m = 0; m < M; m++) {
+            for(int k = 0; k < n; k++) {
+                double sum = 0;
+                for(int j = 0; j < n; j++) {
+                    sum += f[j*M + m] * std::cos(PI * k * (j + 0.5) / n);
+                }
+                c[k] = (k == 0 ? 1.0 : 2.0) * sum / n;
+            }
+            for(int p = 0; p < n; p++) {
+                double v = 0;
+                for(int k = p; k < n; k++) {
+                    v += c[k] * T[k*n + p];
+                }
+                coeffs[(static_cast<std::size_t>(i)*n + p)*M + m] =
+                        static_cast<Scalar>(v);
+            }
+        }
+    }
+}
+
+
+/** Evaluate the M functions at x in [0, interval_num] by Horner's rule. */
+template<typename Scalar, int M, int D>
+void evalPiecewise(const Scalar *coeffs, int interval_num, Scalar x,
+                   Scalar *terms)
+{
+    // x >= 0 is kept by the callers, so only the upper end is clamped
+    const int i = std::min(static_cast<int>(x), interval_num - 1);
+    const Scalar u = 2 * (x - i) - 1;
+    const Scalar *c = coeffs + (static_cast<std::size_t>(i)*(D + 1) + D) * M;
+
+    // The local sums stay in registers, as terms may alias coeffs
+    Scalar sum[M];
+    for(int m = 0; m < M; m++) {
+        sum[m] = c[m];
+    }
+    for(int p = D - 1; p >= 0; p--) {
+        c -= M;
+        for(int m = 0; m < M; m++) {
+            sum[m] = sum[m] * u + c[m];
+        }
+    }
+    for(int m = 0; m < M; m++) {
+        terms[m] = sum[m];
+    }
+}
+}
+
+
+template<typename Scalar>
+SegmentApproxT<Scalar>::SegmentApproxT(Scalar theta_min, Scalar theta_max,
+                                       int interval_num, int degree)
+    : _theta_min(theta_min)
+    , _theta_max(theta_max)
+    , _interval_num(std::max(interval_num, 1))
+    , _degree(std::min(std::max(degree, 1), MAX_DEGREE))
+    , _theta_scale(_interval_num / (theta_max - theta_min))
+    , _delta_scale(static_cast<Scalar>(_interval_num / (2 * PI)))
+    , _term_error(0)
+{
+    assert(theta_min < theta_max);
+    fitPiecewise<Scalar, THETA_TERM_NUM>(theta_min, theta_max, _interval_num,
+                                         _degree, exactThetaTerms, _theta_coeffs);
+    fitPiecewise<Scalar, DELTA_TERM_NUM>(-PI, PI, _interval_num, _degree,
+                                         exactDeltaTerms, _delta_coeffs);
+
+    // Measure the error of the terms on a dense grid of each piece
+    const int num = _interval_num * ERROR_SAMPLE_NUM;
+    double exact[THETA_TERM_NUM];
+    Scalar approx[THETA_TERM_NUM], approx_delta[DELTA_TERM_NUM];
+    double error = 0;
+    for(int i = 0; i <= num; i++) {
+        double s = static_cast<double>(i) / num;
+        double theta = theta_min + s * (double(theta_max) - theta_min);
+        double delta = -PI + s * 2 * PI;
+        calcTerms(static_cast<Scalar>(theta), static_cast<Scalar>(delta),
+                  approx, approx_delta);
+        exactThetaTerms(theta, exact);
+        for(int m = 0; m < THETA_TERM_NUM; m++) {
+            error = std::max(error, std::abs(approx[m] - exact[m]));
+        }
+        exactDeltaTerms(delta, exact);
+        for(int m = 0; m < DELTA_TERM_NUM; m++) {
+            error = std::max(error, std::abs(approx_delta[m] - exact[m]));
+        }
+    }
+    _term_error = static_cast<Scalar>(error);
+}
+
+
+template<typename Scalar>
+Scalar SegmentApproxT<Scalar>::thetaMin() const
+{
+    return _theta_min;
+}
+
+
+template<typename Scalar>
+Scalar SegmentApproxT<Scalar>::thetaMax() const
+{
+    return _theta_max;
+}
+
+
+template<typename Scalar>
+Scalar SegmentApproxT<Scalar>::termError() const
+{
+    return _term_error;
+}
+
+
+template<typename Scalar>
+template<int D>
+void SegmentApproxT<Scalar>::calcTerms(Scalar theta, Scalar delta,
+                                       Scalar *t, Scalar *d) const
+{
+    if(theta >= _theta_min && theta <= _theta_max) {
+        evalPiecewise<Scalar, THETA_TERM_NUM, D>(_theta_coeffs.data(),
+                _interval_num, (theta - _theta_min) * _theta_scale, t);
+    }
+    else {
+        double exact[THETA_TERM_NUM];
+        exactThetaTerms(theta, exact);
+        for(int m = 0; m < THETA_TERM_NUM; m++) {
+            t[m] = static_cast<Scalar>(exact[m]);
+        }
+    }
+
+    const Scalar pi = static_cast<Scalar>(PI);
+    if(!(delta >= -pi && delta <= pi)) {
+        delta -= 2 * pi * std::floor(delta / (2 * pi) + Scalar(0.5));
+    }
+    Scalar x = (delta + pi) * _delta_scale;
+    evalPiecewise<Scalar, DELTA_TERM_NUM, D>(_delta_coeffs.data(),
+            _interval_num, std::max(x, Scalar(0)), d);
+}
+
+
+template<typename Scalar>
+void SegmentApproxT<Scalar>::calcTerms(Scalar theta, Scalar delta,
+                                       Scalar *t, Scalar *d) const
+{
+    // The degree is dispatched once for both tables
+    switch(_degree) {
+    case 1: return calcTerms<1>(theta, delta, t, d);
+    case 2: return calcTerms<2>(theta, delta, t, d);
+    case 3: return calcTerms<3>(theta, delta, t, d);
+    case 4: return calcTerms<4>(theta, delta, t, d);
+    case 5: return calcTerms<5>(theta, delta, t, d);
+    case 6: return calcTerms<6>(theta, delta, t, d);
+    case 7: return calcTerms<7>(theta, delta, t, d);
+    default: return calcTerms<8>(theta, delta, t, d);
+    }
+}
+
+
+template<typename Scalar>
+void SegmentApproxT<Scalar>::calcSingleSegmentPose(
+        Scalar L, Scalar theta, Scalar delta, PoseT<Scalar> &pose) const
+{
+    calcSingleWithRigidSegmentPose(L, theta, delta, 0, pose);
+}
+
+
+template<typename Scalar>
+void SegmentApproxT<Scalar>::calcSingleWithRigidSegmentPose(
+        Scalar L, Scalar theta, Scalar delta, Scalar Lr,
+        PoseT<Scalar> &pose) const
+{
+    Scalar t[THETA_TERM_NUM], d[DELTA_TERM_NUM];
+    calcTerms(theta, delta, t, d);
+    poseFromTerms(t, d, L, Lr, pose);
+}
+
+
+template<typename Scalar>
+void SegmentApproxT<Scalar>::calcSingleSegmentJacobian(
+        Scalar L, Scalar theta, Scalar delta, Eigen::Matrix<Scalar, 3, 2> &Jv,
+        Eigen::Matrix<Scalar, 3, 2> &Jw) const
+{
+    Scalar t[THETA_TERM_NUM], d[DELTA_TERM_NUM];
+    calcTerms(theta, delta, t, d);
+    jacobianFromTerms(t, d, L, Jv, Jw);
+}
+
+
+template<typename Scalar>
+void SegmentApproxT<Scalar>::calcSingleSegmentPoseAndJacobian(
+        Scalar L, Scalar theta, Scalar delta, PoseT<Scalar> &pose,
+        Eigen::Matrix<Scalar, 3, 2> &Jv, Eigen::Matrix<Scalar, 3, 2> &Jw) const
+{
+    Scalar t[THETA_TERM_NUM], d[DELTA_TERM_NUM];
+    calcTerms(theta, delta, t, d);
+    poseFromTerms(t, d, L, 0, pose);
+    jacobianFromTerms(t, d, L, Jv, Jw);
+}
+
+
+template<typename Scalar>
+void SegmentApproxT<Scalar>::poseFromTerms(
+        const Scalar *t, const Scalar *d, Scalar L, Scalar Lr,
+        PoseT<Scalar> &pose)
+{
+    const Scalar st = t[0], ct = t[1], sd = d[0], cd = d[1];
+    const Scalar omc = 1 - ct, sdcd = sd * cd;
+    pose.R << 1 - cd*cd*omc, -sdcd*omc, cd*st,
+            -sdcd*omc, 1 - sd*sd*omc, sd*st,
+            -cd*st, -sd*st, ct;
+    const Scalar k = L*t[2] + Lr*st;
+    pose.t << cd*k, sd*k, L*t[3] + Lr*ct;
+}
+
+
+template<typename Scalar>
+void SegmentApproxT<Scalar>::jacobianFromTerms(
+        const Scalar *t, const Scalar *d, Scalar L,
+        Eigen::Matrix<Scalar, 3, 2> &Jv, Eigen::Matrix<Scalar, 3, 2> &Jw)
+{
+    const Scalar st = t[0], ct = t[1], sd = d[0], cd = d[1];
+    Jv << L*cd*t[4], -L*sd*t[2],
+            L*sd*t[4], L*cd*t[2],
+            L*t[5], 0;
+    Jw << -sd, -st*cd,
+            cd, -st*sd,
+            0, 1 - ct;
+}
+
+
+template<typename Scalar>
+SegmentApproxError SegmentApproxT<Scalar>::errorReport(int sample_num) const
+{
+    SegmentApproxError error;
+    sample_num = std::max(sample_num, 2);
+
+    double exact[THETA_TERM_NUM];
+    Scalar approx[THETA_TERM_NUM], approx_delta[DELTA_TERM_NUM];
+    PoseT<Scalar> pose;
+    Eigen::Matrix<Scalar, 3, 2> Jv, Jw;
+    for(int i = 0; i < sample_num; i++) {
+        double theta = _theta_min + (double(_theta_max) - _theta_min) * i /
+                (sample_num - 1);
+        exactThetaTerms(theta, exact);
+        calcTerms(static_cast<Scalar>(theta), 0, approx, approx_delta);
+        for(int m = 0; m < THETA_TERM_NUM; m++) {
+            error.theta_terms = std::max(error.theta_terms,
+                                         std::abs(approx[m] - exact[m]));
+        }
+
+        for(int j = 0; j < sample_num; j++) {
+            double delta = -PI + 2 * PI * j / (sample_num - 1);
+            if(i == 0) {
+                exactDeltaTerms(delta, exact);
+                calcTerms(_theta_min, static_cast<Scalar>(delta), approx,
+                          approx_delta);
+                for(int m = 0; m < DELTA_TERM_NUM; m++) {
+                    error.delta_terms = std::max(error.delta_terms,
+                            std::abs(approx_delta[m] - exact[m]));
+                }
+            }
+
+            // The exact path in double with unit L, where the Jacobian is
+            // built from the exact terms, which are smooth near zero
+            PoseT<double> pose0 = continuum::calcSingleSegmentPose<double>(
+                        1, theta, delta);
+            exactThetaTerms(theta, exact);
+            const double sd = std::sin(delta), cd = std::cos(delta);
+            Eigen::Matrix<double, 3, 2> Jv0, Jw0;
+            Jv0 << cd*exact[4], -sd*exact[2],
+                    sd*exact[4], cd*exact[2],
+                    exact[5], 0;
+            Jw0 << -sd, -exact[0]*cd,
+                    cd, -exact[0]*sd,
+                    0, 1 - exact[1];
+
+            calcSingleSegmentPose(1, static_cast<Scalar>(theta),
+                                  static_cast<Scalar>(delta), pose);
+            calcSingleSegmentJacobian(1, static_cast<Scalar>(theta),
+                                      static_cast<Scalar>(delta), Jv, Jw);
+            error.rotation = std::max(error.rotation, (pose.R.template
+                    cast<double>() - pose0.R).cwiseAbs().maxCoeff());
+            error.position = std::max(error.position, (pose.t.template
+                    cast<double>() - pose0.t).cwiseAbs().maxCoeff());
+            error.jacobian_v = std::max(error.jacobian_v, (Jv.template
+                    cast<double>() - Jv0).cwiseAbs().maxCoeff());
+            error.jacobian_w = std::max(error.jacobian_w, (Jw.template
+                    cast<double>() - Jw0).cwiseAbs().maxCoeff());
+        }
+    }
+    return error;
+}
+
+
+/* Explicit instantiations for float and double */
+template class SegmentApproxT<float>;
+template class SegmentApproxT<double>;
+
+}} // mmath::continuum
@@ -0,0 +1,218 @@
+#include "../include/lib_math/kine/continuum_ik.h"
+#include "../include/lib_math/util/angle.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace mmath{
+namespace continuum{
+
+ContinuumIkSolver::ContinuumIkSolver(ContinuumRobot &robot,
+                                     bool is_variable_length)
+    : _robot(robot)
+    , _is_variable_length(is_variable_length)
+    , _is_valid(robot.jacobianCols(is_variable_length) <= MAX_DOF)
+    , _theta_min(robot.segmentNum(), -PI)
+    , _theta_max(robot.segmentNum(), PI)
+    , _L_min(robot.segmentNum(), 0)
+    , _L_max(robot.segmentNum(), 1e9)
+    , _q_backup(robot.segmentNum())
+    , _tol_position(1e-3)
+    , _tol_orientation(1e-3)
+    , _max_iteration(100)
+    , _max_time_ms(0)
+    , _lambda_init(1e-2)
+    , _lambda_min(1e-6)
+    , _lambda_max(1e4)
+    , _w_orientation(1)
+    , _iterations(0)
+    , _err_position(0)
+    , _err_orientation(0)
+{
+    // A chain beyond the fixed capacity is rejected by solve(), the check is
+    // not left to the asserts of Eigen, which are gone in a release build
+    if(_is_valid) {
+        _J.resize(6, robot.jacobianCols(is_variable_length));
+    }
+}
+
+
+void ContinuumIkSolver::setLimits(std::size_t i, kfloat theta_min,
+                                  kfloat theta_max, kfloat L_min, kfloat L_max)
+{
+    assert(i < _theta_min.size() && theta_min <= theta_max && L_min <= L_max);
+    _theta_min[i] = theta_min;
+    _theta_max[i] = theta_max;
+    _L_min[i] = L_min;
+    _L_max[i] = L_max;
+}
+
+
+void ContinuumIkSolver::setTolerance(kfloat position, kfloat orientation)
+{
+    _tol_position = position;
+    _tol_orientation = orientation;
+}
+
+
+void ContinuumIkSolver::setBudget(int max_iteration, float max_time_ms)
+{
+    _max_iteration = max_iteration;
+    _max_time_ms = max_time_ms;
+}
+
+
+void ContinuumIkSolver::setDamping(kfloat init, kfloat min, kfloat max)
+{
+    assert(min <= init && init <= max);
+    _lambda_init = init;
+    _lambda_min = min;
+    _lambda_max = max;
+}
+
+
+bool ContinuumIkSolver::setOrientationWeight(kfloat weight)
+{
+    if(!(weight >= 0)) return false;
+    _w_orientation = weight;
+    return true;
+}
+
+
+bool ContinuumIkSolver::isValid() const
+{
+    return _is_valid;
+}
+
+
+IkStatus ContinuumIkSolver::solve(const Pose &target)
+{
+    _iterations = 0;
+    if(!_is_valid) return IkStatus::INVALID;
+
+    auto start = std::chrono::steady_clock::now();
+    auto isTimeout = [&]() -> bool {
+        if(_max_time_ms <= 0) return false;
+        std::chrono::duration<float, std::milli> ms =
+                std::chrono::steady_clock::now() - start;
+        return ms.count() >= _max_time_ms;
+    };
+
+    // The costs and the steps take the weighted error, while the tolerances
+    // take the unweighted one
+    auto calcCost = [this](const Vector6 &e) -> kfloat {
+        return e.head<3>().squaredNorm() +
+                _w_orientation * _w_orientation * e.tail<3>().squaredNorm();
+    };
+
+    Vector6 e, e_new;
+    _robot.calcForwardKinematics();
+    calcError(target, e);
+    kfloat cost = calcCost(e);
+    kfloat lambda = _lambda_init;
+
+    IkStatus status;
+    for(_iterations = 0; ; _iterations++) {
+        _err_position = e.head<3>().norm();
+        _err_orientation = e.tail<3>().norm();
+        if(_err_position <= _tol_position && (_w_orientation == 0 ||
+                _err_orientation <= _tol_orientation)) {
+            status = IkStatus::CONVERGED;
+            break;
+        }
+        if(_iterations >= _max_iteration) {
+            status = IkStatus::MAX_ITERATION;
+            break;
+        }
+        if(isTimeout()) {
+            status = IkStatus::TIMEOUT;
+            break;
+        }
+
+        // dq = J^T * (J*J^T + lambda^2*I)^-1 * e
+        _robot.calcJacobian(_J, _is_variable_length);
+        _J.bottomRows<3>() *= _w_orientation;
+        Eigen::Matrix<kfloat, 6, 6> A;
+        A.noalias() = _J.lazyProduct(_J.transpose());
+        A.diagonal().array() += lambda * lambda;
+        Vector6 e_weighted;
+        e_weighted << e.head<3>(), _w_orientation * e.tail<3>();
+        VectorQ dq = _J.transpose() * A.ldlt().solve(e_weighted);
+
+        for(std::size_t i = 0; i < _q_backup.size(); i++) {
+            _q_backup[i] = _robot.config(i);
+        }
+        applyStep(dq);
+        _robot.calcForwardKinematics();
+        calcError(target, e_new);
+
+        kfloat cost_new = calcCost(e_new);
+        if(cost_new < cost) {
+            e = e_new;
+            cost = cost_new;
+            lambda = std::max(lambda * kfloat(0.5), _lambda_min);
+        }
+        else {
+            for(std::size_t i = 0; i < _q_backup.size(); i++) {
+                _robot.setConfig(i, _q_backup[i]);
+            }
+            _robot.calcForwardKinematics();
+            lambda *= 10;
+            if(lambda > _lambda_max) {
+                status = IkStatus::STALLED;
+                break;
+            }
+        }
+    }
+    return status;
+}
+
+
+int ContinuumIkSolver::iterations() const
+{
+    return _iterations;
+}
+
+
+kfloat ContinuumIkSolver::positionError() const
+{
+    return _err_position;
+}
+
+
+kfloat ContinuumIkSolver::orientationError() const
+{
+    return _err_orientation;
+}
+
+
+void ContinuumIkSolver::calcError(const Pose &target, Vector6 &e) const
+{
+    const Pose& pose = _robot.endPose();
+    e.head<3>() = target.t - pose.t;
+
+    // The rotation vector of target.R * pose.R^T, w.r.t the world
+    Eigen::Matrix<kfloat, 3, 3> dR = target.R * pose.R.transpose();
+    Eigen::AngleAxis<kfloat> aa(dR);
+    e.tail<3>() = aa.angle() * aa.axis();
+}
+
+
+void ContinuumIkSolver::applyStep(const VectorQ &dq)
+{
+    const int cols = _is_variable_length ? 3 : 2;
+    for(std::size_t i = 0; i < _q_backup.size(); i++) {
+        ConfigSpc q = _robot.config(i);
+        int c = static_cast<int>(i) * cols;
+        if(q.is_bend) {
+            q.theta = std::clamp(q.theta + dq[c], _theta_min[i], _theta_max[i]);
+        }
+        q.delta += dq[c + 1];
+        if(_is_variable_length) {
+            q.length = std::clamp(q.length + dq[c + 2], _L_min[i], _L_max[i]);
+        }
+        _robot.setConfig(i, q);
+    }
+}
+
+}} // mmath::continuum
@@ -1,81 +1,114 @@
 #include "../include/lib_math/kine/continuum_pose.h"
+#include "../include/lib_math/kine/continuum_terms.h"
+#include <cmath>
 #include <iostream>
+
 namespace mmath{
 namespace continuum{
 
-void calcSingleSegmentPose(kfloat L, kfloat theta, kfloat delta, Pose &pose)
+template<typename Scalar>
+void calcSingleSegmentPose(NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+                           NonDeduced<Scalar> delta, PoseT<Scalar> &pose)
 {
-    Eigen::Matrix<kfloat, 3, 3> R_t1_2_tb =
-            rotByZ<kfloat>(-PI / 2 + delta)*rotByY<kfloat>(-PI / 2);
-    pose.R = R_t1_2_tb * rotByZ<kfloat>(theta) * R_t1_2_tb.transpose();
-    if (abs(theta) < 1e-5) {
-        pose.t = Eigen::Vector<kfloat, 3>(0, 0, L);
-    }
-    else {
-        kfloat rc = L / theta;
-        pose.t = rc * R_t1_2_tb *
-                Eigen::Vector<kfloat, 3>(sin(theta), 1 - cos(theta), 0);
-    }
+    SegmentThetaTerms<Scalar> t;
+    calcSegmentThetaTerms<Scalar>(theta, t);
+    const Scalar sd = std::sin(delta), cd = std::cos(delta), sdcd = sd * cd;
+    pose.R << 1 - cd*cd*t.omc, -sdcd*t.omc, cd*t.s,
+            -sdcd*t.omc, 1 - sd*sd*t.omc, sd*t.s,
+            -cd*t.s, -sd*t.s, t.c;
+    pose.t << L*cd*t.f1, L*sd*t.f1, L*t.f2;
 }
 
 
-Pose calcSingleSegmentPose(kfloat L, kfloat theta, kfloat delta)
+template<typename Scalar>
+PoseT<Scalar> calcSingleSegmentPose(NonDeduced<Scalar> L,
+                                    NonDeduced<Scalar> theta,
+                                    NonDeduced<Scalar> delta)
 {
-    Pose pose;
+    PoseT<Scalar> pose;
     calcSingleSegmentPose(L, theta, delta, pose);
     return pose;
 }
 
 
-void calcSingleSegmentPose(const ConfigSpc &q, Pose &pose)
+template<typename Scalar>
+void calcSingleSegmentPose(const ConfigSpcT<Scalar> &q, PoseT<Scalar> &pose)
 {
     if(q.is_bend){
         calcSingleSegmentPose(q.length, q.theta, q.delta, pose);
     }
     else{
-        pose.R = rotByZ<kfloat>(q.delta);
-        pose.t = Eigen::Vector<kfloat, 3>(0, 0, q.length);
+        pose.R = rotByZ<Scalar>(q.delta);
+        pose.t = Eigen::Vector<Scalar, 3>(0, 0, q.length);
     }
 }
 
 
-Pose calcSingleSegmentPose(const ConfigSpc& q)
+template<typename Scalar>
+PoseT<Scalar> calcSingleSegmentPose(const ConfigSpcT<Scalar>& q)
 {
-    Pose pose;
+    PoseT<Scalar> pose;
     calcSingleSegmentPose(q, pose);
     return pose;
 }
 
 
-void calcSingleWithRigidSegmentPose(kfloat L, kfloat theta, kfloat delta,
-                                    kfloat Lr, Pose &pose)
+template<typename Scalar>
+void calcSingleWithRigidSegmentPose(NonDeduced<Scalar> L,
+                                    NonDeduced<Scalar> theta,
+                                    NonDeduced<Scalar> delta,
+                                    NonDeduced<Scalar> Lr, PoseT<Scalar> &pose)
 {
-    pose = calcSingleSegmentPose(L, theta, delta);
+    pose = calcSingleSegmentPose<Scalar>(L, theta, delta);
     pose.t += Lr * pose.R.rightCols(1);
 }
 
 
-Pose calcSingleWithRigidSegmentPose(kfloat L, kfloat theta, kfloat delta,
-                                    kfloat Lr)
+template<typename Scalar>
+PoseT<Scalar> calcSingleWithRigidSegmentPose(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr)
 {
-    Pose pose;
+    PoseT<Scalar> pose;
     calcSingleWithRigidSegmentPose(L, theta, delta, Lr, pose);
     return pose;
 }
 
 
-void calcSingleWithRigidSegmentPose(const ConfigSpc &q, kfloat Lr, Pose &pose)
+template<typename Scalar>
+void calcSingleWithRigidSegmentPose(const ConfigSpcT<Scalar> &q,
+                                    NonDeduced<Scalar> Lr, PoseT<Scalar> &pose)
 {
     calcSingleSegmentPose(q, pose);
     pose.t += Lr * pose.R.rightCols(1);
 }
 
 
-Pose calcSingleWithRigidSegmentPose(const ConfigSpc &q, kfloat Lr)
+template<typename Scalar>
+PoseT<Scalar> calcSingleWithRigidSegmentPose(
+        const ConfigSpcT<Scalar> &q, NonDeduced<Scalar> Lr)
 {
-    Pose pose;
+    PoseT<Scalar> pose;
     calcSingleWithRigidSegmentPose(q, Lr, pose);
     return pose;
 }
 
+
+/* Explicit instantiations for float and double */
+#define INSTANTIATE_CONTINUUM_POSE(T)                                         \
+    template void calcSingleSegmentPose<T>(T, T, T, PoseT<T>&);               \
+    template PoseT<T> calcSingleSegmentPose<T>(T, T, T);                      \
+    template void calcSingleSegmentPose<T>(const ConfigSpcT<T>&, PoseT<T>&);  \
+    template PoseT<T> calcSingleSegmentPose<T>(const ConfigSpcT<T>&);         \
+    template void calcSingleWithRigidSegmentPose<T>(T, T, T, T, PoseT<T>&);   \
+    template PoseT<T> calcSingleWithRigidSegmentPose<T>(T, T, T, T);          \
+    template void calcSingleWithRigidSegmentPose<T>(const ConfigSpcT<T>&, T,  \
+            PoseT<T>&);                                                       \
+    template PoseT<T> calcSingleWithRigidSegmentPose<T>(const ConfigSpcT<T>&, \
+            T);
+
+INSTANTIATE_CONTINUUM_POSE(float)
+INSTANTIATE_CONTINUUM_POSE(double)
+#undef INSTANTIATE_CONTINUUM_POSE
+
 }} // mmath::continuum
\ No newline at end of file
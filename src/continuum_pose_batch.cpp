@@ -0,0 +1,102 @@
+#include "../include/lib_math/kine/continuum_pose_batch.h"
+#include "../include/lib_math/kine/continuum_terms.h"
+#include <Eigen/Dense>
+#include <algorithm>
+
+namespace mmath{
+namespace continuum{
+
+namespace {
+/** The number of segments evaluated together in one block. */
+constexpr int BATCH_BLOCK = 64;
+
+template<typename Scalar>
+using BlockArray = Eigen::Array<Scalar, Eigen::Dynamic, 1, 0, BATCH_BLOCK, 1>;
+template<typename Scalar>
+using ConstArrayMap = Eigen::Map<const Eigen::Array<Scalar, Eigen::Dynamic, 1>>;
+
+
+template<typename Scalar>
+void calcPoseBlock(const Scalar *L, const Scalar *theta, const Scalar *delta,
+                   const Scalar *Lr, int n, Scalar *R, Scalar *t)
+{
+    using Array = BlockArray<Scalar>;
+    ConstArrayMap<Scalar> l(L, n), th(theta, n), de(delta, n);
+
+    // The terms are selected per lane, so a mixed batch has no branch
+    SegmentThetaTerms<Array> terms;
+    calcSegmentThetaTerms<Array>(th, terms);
+    const Array &st = terms.s, &ct = terms.c, &omc = terms.omc;
+    Array sd = de.sin(), cd = de.cos();
+
+    Array tx = l * cd * terms.f1;
+    Array ty = l * sd * terms.f1;
+    Array tz = l * terms.f2;
+    if(Lr) {
+        ConstArrayMap<Scalar> lr(Lr, n);
+        tx += lr * cd * st;
+        ty += lr * sd * st;
+        tz += lr * ct;
+    }
+
+    Array r00 = 1 - cd * cd * omc;
+    Array r01 = -sd * cd * omc;
+    Array r11 = 1 - sd * sd * omc;
+
+    for(int i = 0; i < n; i++) {
+        Scalar *Ri = R + 9 * i;
+        Ri[0] = r00[i];         Ri[3] = r01[i];         Ri[6] = cd[i] * st[i];
+        Ri[1] = r01[i];         Ri[4] = r11[i];         Ri[7] = sd[i] * st[i];
+        Ri[2] = -cd[i] * st[i]; Ri[5] = -sd[i] * st[i]; Ri[8] = ct[i];
+
+        Scalar *ti = t + 3 * i;
+        ti[0] = tx[i];
+        ti[1] = ty[i];
+        ti[2] = tz[i];
+    }
+}
+
+
+template<typename Scalar>
+void calcPoseBatch(const Scalar *L, const Scalar *theta, const Scalar *delta,
+                   const Scalar *Lr, std::size_t num, Scalar *R, Scalar *t)
+{
+    for(std::size_t i = 0; i < num; i += BATCH_BLOCK) {
+        int n = static_cast<int>(std::min<std::size_t>(BATCH_BLOCK, num - i));
+        calcPoseBlock(L + i, theta + i, delta + i, Lr ? Lr + i : nullptr, n,
+                      R + 9 * i, t + 3 * i);
+    }
+}
+}
+
+
+template<typename Scalar>
+void calcSingleSegmentPoseBatch(const Scalar *L, const Scalar *theta,
+                                const Scalar *delta, std::size_t num,
+                                Scalar *R, Scalar *t)
+{
+    calcPoseBatch<Scalar>(L, theta, delta, nullptr, num, R, t);
+}
+
+
+template<typename Scalar>
+void calcSingleWithRigidSegmentPoseBatch(const Scalar *L, const Scalar *theta,
+                                         const Scalar *delta, const Scalar *Lr,
+                                         std::size_t num, Scalar *R, Scalar *t)
+{
+    calcPoseBatch(L, theta, delta, Lr, num, R, t);
+}
+
+
+/* Explicit instantiations for float and double */
+template void calcSingleSegmentPoseBatch<float>(const float*, const float*,
+        const float*, std::size_t, float*, float*);
+template void calcSingleSegmentPoseBatch<double>(const double*, const double*,
+        const double*, std::size_t, double*, double*);
+template void calcSingleWithRigidSegmentPoseBatch<float>(const float*,
+        const float*, const float*, const float*, std::size_t, float*, float*);
+template void calcSingleWithRigidSegmentPoseBatch<double>(const double*,
+        const double*, const double*, const double*, std::size_t, double*,
+        double*);
+
+}} // mmath::continuum
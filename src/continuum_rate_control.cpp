@@ -0,0 +1,184 @@
+#include "../include/lib_math/kine/continuum_rate_control.h"
+#include "../include/lib_math/kine/dcontinuum_pose.h"
+#include "../include/lib_math/util/angle.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace mmath{
+namespace continuum{
+
+template<typename Scalar>
+ResolvedRateControllerT<Scalar>::ResolvedRateControllerT(
+        Scalar Lr, bool is_variable_length)
+    : _Lr(Lr)
+    , _is_variable_length(is_variable_length)
+    , _lambda_max(Scalar(0.05))
+    , _epsilon(Scalar(0.1))
+    , _w_orientation(1)
+    , _rate_limit{0, 0, 0}
+    , _theta_min(Scalar(-PI))
+    , _theta_max(Scalar(PI))
+    , _L_min(0)
+    , _L_max(Scalar(1e9))
+    , _lambda(0)
+    , _saturation(1)
+{}
+
+
+template<typename Scalar>
+void ResolvedRateControllerT<Scalar>::setDamping(Scalar lambda_max,
+                                                 Scalar epsilon)
+{
+    assert(lambda_max >= 0 && epsilon >= 0);
+    _lambda_max = lambda_max;
+    _epsilon = epsilon;
+}
+
+
+template<typename Scalar>
+void ResolvedRateControllerT<Scalar>::setOrientationWeight(Scalar weight)
+{
+    assert(weight >= 0);
+    _w_orientation = weight;
+}
+
+
+template<typename Scalar>
+void ResolvedRateControllerT<Scalar>::setRateLimits(
+        Scalar theta_rate, Scalar delta_rate, Scalar length_rate)
+{
+    _rate_limit[0] = theta_rate;
+    _rate_limit[1] = delta_rate;
+    _rate_limit[2] = length_rate;
+}
+
+
+template<typename Scalar>
+void ResolvedRateControllerT<Scalar>::setJointLimits(
+        Scalar theta_min, Scalar theta_max, Scalar L_min, Scalar L_max)
+{
+    assert(theta_min <= theta_max && L_min <= L_max);
+    _theta_min = theta_min;
+    _theta_max = theta_max;
+    _L_min = L_min;
+    _L_max = L_max;
+}
+
+
+template<typename Scalar>
+template<int N>
+void ResolvedRateControllerT<Scalar>::solve(
+        const ConfigSpcT<Scalar>& q, const Vector6& twist,
+        Eigen::Vector<Scalar, N>& dq)
+{
+    Eigen::Matrix<Scalar, 3, N> Jv, Jw;
+    if constexpr(N == 2) {
+        calcSingleWithRigidSegmentJacobian(q, _Lr, Jv, Jw);
+    }
+    else {
+        calcVariableLengthWithRigidSegmentJacobian(q, _Lr, Jv, Jw);
+        if(!q.is_bend) {
+            // The length of a rigid segment moves the end along z
+            Jv(2, 2) = 1;
+        }
+    }
+    Eigen::Matrix<Scalar, 6, N> J;
+    J << Jv, _w_orientation * Jw;
+    Vector6 x;
+    x << twist.template head<3>(), _w_orientation * twist.template tail<3>();
+
+    // The damping only applies near the singularity
+    _measure = calcSingularityMeasure<Scalar>(J);
+    const Scalar ratio = _epsilon > 0 ? _measure.sigma_min / _epsilon : Scalar(1);
+    const Scalar lambda2 = ratio < 1 ?
+                _lambda_max * _lambda_max * (1 - ratio * ratio) : Scalar(0);
+    _lambda = std::sqrt(lambda2);
+
+    // The NxN normal equation, N <= 3, has a fixed cost
+    Eigen::Matrix<Scalar, N, N> A = J.transpose().lazyProduct(J);
+    A.diagonal().array() += lambda2;
+    dq = A.ldlt().solve(J.transpose().lazyProduct(x));
+}
+
+
+template<typename Scalar>
+void ResolvedRateControllerT<Scalar>::calcRate(
+        const ConfigSpcT<Scalar>& q, const Vector6& twist, Scalar dt,
+        ConfigSpcT<Scalar>& rate)
+{
+    Eigen::Vector<Scalar, 3> dq(0, 0, 0);
+    if(_is_variable_length) {
+        solve<3>(q, twist, dq);
+    }
+    else {
+        Eigen::Vector<Scalar, 2> dq2;
+        solve<2>(q, twist, dq2);
+        dq.template head<2>() = dq2;
+    }
+
+    // The rates are cut to stop at the joint limits after dt
+    if(dt > 0) {
+        dq[0] = std::clamp(dq[0], (_theta_min - q.theta) / dt,
+                           (_theta_max - q.theta) / dt);
+        if(_is_variable_length) {
+            dq[2] = std::clamp(dq[2], (_L_min - q.length) / dt,
+                               (_L_max - q.length) / dt);
+        }
+    }
+
+    // Scale the rates uniformly to keep the direction
+    Scalar scale = 1;
+    for(int i = 0; i < 3; i++) {
+        if(_rate_limit[i] > 0 && std::abs(dq[i]) * scale > _rate_limit[i]) {
+            scale = _rate_limit[i] / std::abs(dq[i]);
+        }
+    }
+    _saturation = scale;
+
+    rate.theta = scale * dq[0];
+    rate.delta = scale * dq[1];
+    rate.length = scale * dq[2];
+    rate.is_bend = q.is_bend;
+}
+
+
+template<typename Scalar>
+void ResolvedRateControllerT<Scalar>::step(
+        ConfigSpcT<Scalar>& q, const Vector6& twist, Scalar dt)
+{
+    ConfigSpcT<Scalar> rate;
+    calcRate(q, twist, dt, rate);
+    q.theta += rate.theta * dt;
+    q.delta += rate.delta * dt;
+    q.length += rate.length * dt;
+}
+
+
+template<typename Scalar>
+const SingularityMeasureT<Scalar>&
+ResolvedRateControllerT<Scalar>::measure() const
+{
+    return _measure;
+}
+
+
+template<typename Scalar>
+Scalar ResolvedRateControllerT<Scalar>::damping() const
+{
+    return _lambda;
+}
+
+
+template<typename Scalar>
+Scalar ResolvedRateControllerT<Scalar>::saturation() const
+{
+    return _saturation;
+}
+
+
+/* Explicit instantiations for float and double */
+template class ResolvedRateControllerT<float>;
+template class ResolvedRateControllerT<double>;
+
+}} // mmath::continuum
@@ -0,0 +1,262 @@
+#include "../include/lib_math/kine/continuum_robot.h"
+#include "../include/lib_math/kine/continuum_pose.h"
+#include "../include/lib_math/kine/dcontinuum_pose.h"
+#include <algorithm>
+#include <cassert>
+
+namespace mmath{
+namespace continuum{
+
+ContinuumRobot::ContinuumRobot(const std::vector<ConfigSpc> &qs,
+                               const std::vector<kfloat> &Lrs,
+                               const Pose &base)
+    : _qs(qs)
+    , _Lrs(Lrs.empty() ? std::vector<kfloat>(qs.size(), 0) : Lrs)
+    , _segment_poses(qs.size())
+    , _frames(qs.size() + 1)
+    , _is_dirty(qs.size(), 1)
+    , _first_dirty_frame(0)
+    , _is_jacobian_cached(false)
+{
+    assert(_Lrs.size() == _qs.size());
+    _frames[0] = base;
+    calcForwardKinematics();
+}
+
+
+std::size_t ContinuumRobot::segmentNum() const
+{
+    return _qs.size();
+}
+
+
+void ContinuumRobot::setConfig(std::size_t i, const ConfigSpc &q)
+{
+    assert(i < _qs.size());
+    if(_qs[i] != q) {
+        _qs[i] = q;
+        markDirty(i);
+    }
+}
+
+
+void ContinuumRobot::setConfig(const std::vector<ConfigSpc> &qs)
+{
+    assert(qs.size() == _qs.size());
+    for(std::size_t i = 0; i < qs.size(); i++) {
+        setConfig(i, qs[i]);
+    }
+}
+
+
+const ConfigSpc& ContinuumRobot::config(std::size_t i) const
+{
+    assert(i < _qs.size());
+    return _qs[i];
+}
+
+
+void ContinuumRobot::setRigidLength(std::size_t i, kfloat Lr)
+{
+    assert(i < _Lrs.size());
+    if(_Lrs[i] != Lr) {
+        _Lrs[i] = Lr;
+        markDirty(i);
+    }
+}
+
+
+kfloat ContinuumRobot::rigidLength(std::size_t i) const
+{
+    assert(i < _Lrs.size());
+    return _Lrs[i];
+}
+
+
+void ContinuumRobot::setBasePose(const Pose &base)
+{
+    _frames[0] = base;
+    _first_dirty_frame = 0;
+}
+
+
+void ContinuumRobot::enableJacobianCache(bool enable)
+{
+    if(enable && !_is_jacobian_cached) {
+        _Jvs.resize(_qs.size());
+        _Jws.resize(_qs.size());
+        invalidate();
+    }
+    _is_jacobian_cached = enable;
+}
+
+
+bool ContinuumRobot::isJacobianCacheEnabled() const
+{
+    return _is_jacobian_cached;
+}
+
+
+void ContinuumRobot::invalidate()
+{
+    std::fill(_is_dirty.begin(), _is_dirty.end(), 1);
+    _first_dirty_frame = 0;
+}
+
+
+void ContinuumRobot::calcForwardKinematics()
+{
+    for(std::size_t i = _first_dirty_frame; i < _qs.size(); i++) {
+        Pose& seg = _segment_poses[i];
+        if(_is_dirty[i]) {
+            if(_is_jacobian_cached) {
+                calcVariableLengthWithRigidSegmentPoseAndJacobian(
+                            _qs[i], _Lrs[i], seg, _Jvs[i], _Jws[i]);
+            }
+            else {
+                calcSingleWithRigidSegmentPose(_qs[i], _Lrs[i], seg);
+            }
+            _is_dirty[i] = 0;
+        }
+
+        // frame(i+1) = frame(i) * seg, composed in place
+        const Pose& prev = _frames[i];
+        Pose& next = _frames[i + 1];
+        next.t.noalias() = prev.R * seg.t;
+        next.t += prev.t;
+        next.R.noalias() = prev.R * seg.R;
+    }
+    _first_dirty_frame = _qs.size();
+}
+
+
+const Pose& ContinuumRobot::segmentPose(std::size_t i) const
+{
+    assert(i < _segment_poses.size());
+    return _segment_poses[i];
+}
+
+
+std::size_t ContinuumRobot::jacobianCols(bool is_variable_length) const
+{
+    return _qs.size() * (is_variable_length ? 3 : 2);
+}
+
+
+void ContinuumRobot::calcJacobian(
+        Eigen::Ref<Eigen::Matrix<kfloat, 6, Eigen::Dynamic>> J,
+        bool is_variable_length)
+{
+    assert(static_cast<std::size_t>(J.cols()) == jacobianCols(is_variable_length));
+    calcForwardKinematics();
+
+    const int cols = is_variable_length ? 3 : 2;
+    const Eigen::Vector<kfloat, 3>& p_end = _frames.back().t;
+    Eigen::Matrix<kfloat, 3, 3> Jv, Jw, W;
+    for(std::size_t i = 0; i < _qs.size(); i++) {
+        if(_is_jacobian_cached) {
+            Jv = _Jvs[i];
+            Jw = _Jws[i];
+        }
+        else {
+            calcVariableLengthWithRigidSegmentJacobian(_qs[i], _Lrs[i], Jv, Jw);
+        }
+
+        // w = R_i * Jw, v = R_i * Jv + w x (p_end - p_{i+1})
+        const Eigen::Matrix<kfloat, 3, 3>& R = _frames[i].R;
+        Eigen::Vector<kfloat, 3> arm = p_end - _frames[i + 1].t;
+        W.noalias() = R * Jw;
+        auto block = J.middleCols(i * cols, cols);
+        block.template bottomRows<3>() = W.leftCols(cols);
+        block.template topRows<3>().noalias() = R * Jv.leftCols(cols);
+        for(int c = 0; c < cols; c++) {
+            block.col(c).template head<3>() += W.col(c).cross(arm);
+        }
+    }
+}
+
+
+std::size_t ContinuumRobot::actuationCols(
+        const std::vector<SegmentActuation> &actuations) const
+{
+    std::size_t cols = 0;
+    for(const auto& actuation : actuations) {
+        cols += actuation.backboneNum();
+    }
+    return cols;
+}
+
+
+void ContinuumRobot::calcActuationJacobian(
+        const std::vector<SegmentActuation> &actuations,
+        Eigen::Ref<Eigen::Matrix<kfloat, 6, Eigen::Dynamic>> J)
+{
+    assert(actuations.size() == _qs.size());
+    assert(static_cast<std::size_t>(J.cols()) == actuationCols(actuations));
+    calcForwardKinematics();
+
+    const Eigen::Vector<kfloat, 3>& p_end = _frames.back().t;
+    Eigen::Index col = 0;
+    for(std::size_t i = 0; i < _qs.size(); i++) {
+        const int cols = actuations[i].backboneNum();
+        auto block = J.middleCols(col, cols);
+        actuations[i].calcActuationJacobian(_qs[i], _Lrs[i],
+                                            block.template topRows<3>(),
+                                            block.template bottomRows<3>());
+
+        // w = R_i * Jw, v = R_i * Jv + w x (p_end - p_{i+1})
+        const Eigen::Matrix<kfloat, 3, 3>& R = _frames[i].R;
+        Eigen::Vector<kfloat, 3> arm = p_end - _frames[i + 1].t;
+        for(int c = 0; c < cols; c++) {
+            Eigen::Vector<kfloat, 3> w = R * block.col(c).template tail<3>();
+            Eigen::Vector<kfloat, 3> v = R * block.col(c).template head<3>();
+            block.col(c).template head<3>() = v + w.cross(arm);
+            block.col(c).template tail<3>() = w;
+        }
+        col += cols;
+    }
+}
+
+
+const Eigen::Matrix<kfloat, 3, 3>& ContinuumRobot::segmentJv(std::size_t i) const
+{
+    assert(_is_jacobian_cached && i < _Jvs.size());
+    return _Jvs[i];
+}
+
+
+const Eigen::Matrix<kfloat, 3, 3>& ContinuumRobot::segmentJw(std::size_t i) const
+{
+    assert(_is_jacobian_cached && i < _Jws.size());
+    return _Jws[i];
+}
+
+
+const Pose& ContinuumRobot::frame(std::size_t i) const
+{
+    assert(i < _frames.size());
+    return _frames[i];
+}
+
+
+const std::vector<Pose>& ContinuumRobot::frames() const
+{
+    return _frames;
+}
+
+
+const Pose& ContinuumRobot::endPose() const
+{
+    return _frames.back();
+}
+
+
+void ContinuumRobot::markDirty(std::size_t i)
+{
+    _is_dirty[i] = 1;
+    if(i < _first_dirty_frame) {
+        _first_dirty_frame = i;
+    }
+}
+
+}} // mmath::continuum
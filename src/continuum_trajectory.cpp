@@ -0,0 +1,245 @@
+#include "../include/lib_math/kine/continuum_trajectory.h"
+#include <cassert>
+#include <cstring>
+#if defined _WIN32 | defined _WIN64
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mmath{
+namespace continuum{
+
+namespace {
+constexpr char MAGIC[8] = {'L', 'M', 'T', 'R', 'A', 'J', '\0', '\0'};
+
+/** The size of the stream buffer of TrajectoryWriter. */
+constexpr std::size_t IO_BUFFER_SIZE = 1 << 16;
+}
+
+
+TrajectoryWriter::TrajectoryWriter(const char *filename,
+                                   std::size_t segment_num)
+    : _file(nullptr)
+    , _segment_num(segment_num)
+    , _record_num(0)
+    , _record(TrajectoryHeader::recordSize(segment_num))
+    , _io_buffer(IO_BUFFER_SIZE)
+{
+    _file = fopen(filename, "wb");
+    if(!_file) return;
+    setvbuf(_file, _io_buffer.data(), _IOFBF, _io_buffer.size());
+
+    TrajectoryHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = TrajectoryHeader::VERSION;
+    header.scalar_size = sizeof(kfloat);
+    header.segment_num = static_cast<uint32_t>(segment_num);
+    header.record_size = static_cast<uint32_t>(_record.size());
+    header.reserved = 0;
+    if(fwrite(&header, sizeof(header), 1, _file) != 1) {
+        close();
+    }
+}
+
+
+TrajectoryWriter::~TrajectoryWriter()
+{
+    close();
+}
+
+
+bool TrajectoryWriter::isOpen() const
+{
+    return _file != nullptr;
+}
+
+
+bool TrajectoryWriter::write(double time, const ConfigSpc *qs,
+                             const Pose &pose)
+{
+    if(!_file) return false;
+
+    char *p = _record.data();
+    std::memcpy(p, &time, sizeof(time));
+    p += sizeof(time);
+    for(std::size_t i = 0; i < _segment_num; i++) {
+        p += qs[i].toRecord(p);
+    }
+    pose.toRecord(p);
+
+    if(fwrite(_record.data(), _record.size(), 1, _file) != 1) {
+        return false;
+    }
+    _record_num++;
+    return true;
+}
+
+
+bool TrajectoryWriter::write(double time, const std::vector<ConfigSpc> &qs,
+                             const Pose &pose)
+{
+    assert(qs.size() == _segment_num);
+    return write(time, qs.data(), pose);
+}
+
+
+void TrajectoryWriter::flush()
+{
+    if(_file) fflush(_file);
+}
+
+
+void TrajectoryWriter::close()
+{
+    if(_file) {
+        fclose(_file);
+        _file = nullptr;
+    }
+}
+
+
+std::size_t TrajectoryWriter::segmentNum() const
+{
+    return _segment_num;
+}
+
+
+std::size_t TrajectoryWriter::recordNum() const
+{
+    return _record_num;
+}
+
+
+
+TrajectoryReader::TrajectoryReader(const char *filename)
+    : _data(nullptr)
+    , _size(0)
+    , _segment_num(0)
+    , _record_size(0)
+    , _record_num(0)
+{
+#if defined _WIN32 | defined _WIN64
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(file == INVALID_HANDLE_VALUE) return;
+    LARGE_INTEGER size;
+    if(GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if(mapping) {
+            _data = static_cast<const char*>(
+                        MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            _size = _data ? static_cast<std::size_t>(size.QuadPart) : 0;
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0) return;
+    struct stat st;
+    if(fstat(fd, &st) == 0 && st.st_size > 0) {
+        void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data != MAP_FAILED) {
+            _data = static_cast<const char*>(data);
+            _size = static_cast<std::size_t>(st.st_size);
+        }
+    }
+    ::close(fd);
+#endif
+
+    // Check the header
+    TrajectoryHeader header;
+    if(_size < sizeof(header)) return;
+    std::memcpy(&header, _data, sizeof(header));
+    if(std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            header.version != TrajectoryHeader::VERSION ||
+            header.scalar_size != sizeof(kfloat) ||
+            header.record_size !=
+                TrajectoryHeader::recordSize(header.segment_num)) {
+        return;
+    }
+    _segment_num = header.segment_num;
+    _record_size = header.record_size;
+    _record_num = (_size - sizeof(header)) / _record_size;
+}
+
+
+TrajectoryReader::~TrajectoryReader()
+{
+    if(!_data) return;
+#if defined _WIN32 | defined _WIN64
+    UnmapViewOfFile(_data);
+#else
+    munmap(const_cast<char*>(_data), _size);
+#endif
+}
+
+
+bool TrajectoryReader::isOpen() const
+{
+    return _record_size > 0;
+}
+
+
+std::size_t TrajectoryReader::segmentNum() const
+{
+    return _segment_num;
+}
+
+
+std::size_t TrajectoryReader::recordNum() const
+{
+    return _record_num;
+}
+
+
+double TrajectoryReader::time(std::size_t i) const
+{
+    double time;
+    std::memcpy(&time, record(i), sizeof(time));
+    return time;
+}
+
+
+ConfigSpc TrajectoryReader::config(std::size_t i, std::size_t j) const
+{
+    assert(j < _segment_num);
+    ConfigSpc q;
+    q.fromRecord(record(i) + sizeof(double) + j * ConfigSpc::RECORD_SIZE);
+    return q;
+}
+
+
+TrajectoryReader::RotationMap TrajectoryReader::R(std::size_t i) const
+{
+    const char *p = record(i) + _record_size - Pose::RECORD_SIZE;
+    return RotationMap(reinterpret_cast<const kfloat*>(p));
+}
+
+
+TrajectoryReader::TranslationMap TrajectoryReader::t(std::size_t i) const
+{
+    const char *p = record(i) + _record_size - 3 * sizeof(kfloat);
+    return TranslationMap(reinterpret_cast<const kfloat*>(p));
+}
+
+
+Pose TrajectoryReader::pose(std::size_t i) const
+{
+    Pose pose;
+    pose.fromRecord(record(i) + _record_size - Pose::RECORD_SIZE);
+    return pose;
+}
+
+
+const char* TrajectoryReader::record(std::size_t i) const
+{
+    assert(i < _record_num);
+    return _data + sizeof(TrajectoryHeader) + i * _record_size;
+}
+
+}} // mmath::continuum
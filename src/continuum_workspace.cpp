@@ -0,0 +1,351 @@
+#include "../include/lib_math/kine/continuum_workspace.h"
+#include "../include/lib_math/kine/continuum_pose.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+namespace mmath{
+namespace continuum{
+
+namespace {
+constexpr char MAGIC[8] = {'L', 'M', 'V', 'O', 'X', 'E', 'L', '\0'};
+
+/** The number of grid points taken by a thread at a time. */
+constexpr std::size_t CHUNK_SIZE = 1024;
+
+/** The bits and the offset of each index component in a key. */
+constexpr int KEY_BITS = 21;
+constexpr int64_t KEY_OFFSET = int64_t(1) << (KEY_BITS - 1);
+constexpr uint64_t KEY_MASK = (uint64_t(1) << KEY_BITS) - 1;
+
+
+/** Whether each component fits in the KEY_BITS of a key. */
+template<typename Derived>
+bool isKeyInRange(const Eigen::MatrixBase<Derived> &index)
+{
+    for(int i = 0; i < 3; i++) {
+        if(!(index[i] >= -KEY_OFFSET && index[i] < KEY_OFFSET)) return false;
+    }
+    return true;
+}
+
+
+/** Pack an index, which should be checked by isKeyInRange() first. */
+uint64_t packIndex(const VoxelMap::Index &index)
+{
+    assert(isKeyInRange(index));
+    uint64_t key = 0;
+    for(int i = 0; i < 3; i++) {
+        key |= (uint64_t(index[i] + KEY_OFFSET) & KEY_MASK) << (KEY_BITS * i);
+    }
+    return key;
+}
+
+
+VoxelMap::Index unpackIndex(uint64_t key)
+{
+    VoxelMap::Index index;
+    for(int i = 0; i < 3; i++) {
+        index[i] = static_cast<int>(
+                    int64_t((key >> (KEY_BITS * i)) & KEY_MASK) - KEY_OFFSET);
+    }
+    return index;
+}
+}
+
+
+ConfigGrid::ConfigGrid(const std::vector<GridAxis> &axes)
+    : _axes(axes)
+    , _size(axes.empty() ? 0 : 1)
+{
+    for(const auto& axis : _axes) {
+        assert(axis.num > 0);
+        _size *= axis.num;
+    }
+}
+
+
+std::size_t ConfigGrid::dim() const
+{
+    return _axes.size();
+}
+
+
+std::size_t ConfigGrid::size() const
+{
+    return _size;
+}
+
+
+const GridAxis& ConfigGrid::axis(std::size_t i) const
+{
+    return _axes[i];
+}
+
+
+void ConfigGrid::at(std::size_t index, kfloat *q) const
+{
+    assert(index < _size);
+    for(std::size_t i = 0; i < _axes.size(); i++) {
+        q[i] = static_cast<kfloat>(_axes[i].value(index % _axes[i].num));
+        index /= _axes[i].num;
+    }
+}
+
+
+
+void VoxelStats::add(const Eigen::Vector3f &z)
+{
+    if(count == 0) {
+        z_min = z;
+        z_max = z;
+    }
+    else {
+        z_min = z_min.cwiseMin(z);
+        z_max = z_max.cwiseMax(z);
+    }
+    count++;
+}
+
+
+void VoxelStats::merge(const VoxelStats &other)
+{
+    if(other.count == 0) return;
+    if(count == 0) {
+        *this = other;
+        return;
+    }
+    z_min = z_min.cwiseMin(other.z_min);
+    z_max = z_max.cwiseMax(other.z_max);
+    count += other.count;
+}
+
+
+
+VoxelMap::VoxelMap(double voxel_size)
+    : _voxel_size(voxel_size)
+{
+    assert(voxel_size > 0);
+}
+
+
+double VoxelMap::voxelSize() const
+{
+    return _voxel_size;
+}
+
+
+std::size_t VoxelMap::size() const
+{
+    return _voxels.size();
+}
+
+
+void VoxelMap::clear()
+{
+    _voxels.clear();
+}
+
+
+VoxelMap::Index VoxelMap::index(const Eigen::Vector3d &p) const
+{
+    return (p / _voxel_size).array().floor().cast<int>();
+}
+
+
+Eigen::Vector3d VoxelMap::center(const Index &index) const
+{
+    return (index.cast<double>().array() + 0.5) * _voxel_size;
+}
+
+
+bool VoxelMap::add(const Pose &pose)
+{
+    // The range is checked before the cast, which would overflow otherwise
+    Eigen::Vector3d i = (pose.t.cast<double>() / _voxel_size).array().floor();
+    if(!isKeyInRange(i)) return false;
+    _voxels[packIndex(i.cast<int>())].add(pose.R.col(2).cast<float>());
+    return true;
+}
+
+
+void VoxelMap::merge(const VoxelMap &other)
+{
+    assert(other._voxel_size == _voxel_size);
+    if(_voxels.empty()) {
+        _voxels = other._voxels;
+        return;
+    }
+    for(const auto& voxel : other._voxels) {
+        _voxels[voxel.first].merge(voxel.second);
+    }
+}
+
+
+const VoxelStats* VoxelMap::find(const Index &index) const
+{
+    if(!isKeyInRange(index)) return nullptr;
+    auto it = _voxels.find(packIndex(index));
+    return it == _voxels.end() ? nullptr : &it->second;
+}
+
+
+bool VoxelMap::isOccupied(const Eigen::Vector3d &p) const
+{
+    Eigen::Vector3d i = (p / _voxel_size).array().floor();
+    return isKeyInRange(i) && find(i.cast<int>()) != nullptr;
+}
+
+
+void VoxelMap::forEach(
+        const std::function<void(const Index&, const VoxelStats&)> &func) const
+{
+    for(const auto& voxel : _voxels) {
+        func(unpackIndex(voxel.first), voxel.second);
+    }
+}
+
+
+bool VoxelMap::save(const char *filename) const
+{
+    FILE *file = fopen(filename, "wb");
+    if(!file) return false;
+
+    VoxelMapHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VoxelMapHeader::VERSION;
+    header.record_size = VoxelMapHeader::RECORD_SIZE;
+    header.voxel_num = _voxels.size();
+    header.voxel_size = _voxel_size;
+
+    std::vector<char> buffer(sizeof(header) +
+                             _voxels.size() * VoxelMapHeader::RECORD_SIZE);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    char *p = buffer.data() + sizeof(header);
+    for(const auto& voxel : _voxels) {
+        Eigen::Matrix<int32_t, 3, 1> index = unpackIndex(voxel.first);
+        std::memcpy(p, index.data(), 3 * sizeof(int32_t));
+        std::memcpy(p + 12, &voxel.second.count, sizeof(uint32_t));
+        std::memcpy(p + 16, voxel.second.z_min.data(), 3 * sizeof(float));
+        std::memcpy(p + 28, voxel.second.z_max.data(), 3 * sizeof(float));
+        p += VoxelMapHeader::RECORD_SIZE;
+    }
+
+    bool is_written = fwrite(buffer.data(), buffer.size(), 1, file) == 1;
+    return fclose(file) == 0 && is_written;
+}
+
+
+bool VoxelMap::load(const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    if(!file) return false;
+
+    VoxelMapHeader header;
+    std::vector<char> buffer;
+    bool is_valid = fread(&header, sizeof(header), 1, file) == 1 &&
+            std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+            header.version == VoxelMapHeader::VERSION &&
+            header.record_size == VoxelMapHeader::RECORD_SIZE &&
+            header.voxel_size > 0;
+
+    // The records should fit in the rest of the file before the allocation,
+    // so a corrupt voxel_num can neither overflow nor exhaust the memory
+    if(is_valid) {
+        long end = -1;
+        if(fseek(file, 0, SEEK_END) == 0) end = ftell(file);
+        is_valid = end >= long(sizeof(header)) &&
+                header.voxel_num <= uint64_t(end - long(sizeof(header))) /
+                VoxelMapHeader::RECORD_SIZE &&
+                fseek(file, long(sizeof(header)), SEEK_SET) == 0;
+    }
+    if(is_valid) {
+        buffer.resize(header.voxel_num * VoxelMapHeader::RECORD_SIZE);
+        is_valid = buffer.empty() ||
+                fread(buffer.data(), buffer.size(), 1, file) == 1;
+    }
+    fclose(file);
+
+    // An index out of the range of a key would collide with other voxels
+    for(uint64_t i = 0; is_valid && i < header.voxel_num; i++) {
+        Eigen::Matrix<int32_t, 3, 1> index;
+        std::memcpy(index.data(), buffer.data() +
+                    i * VoxelMapHeader::RECORD_SIZE, 3 * sizeof(int32_t));
+        is_valid = isKeyInRange(index);
+    }
+    if(!is_valid) return false;
+
+    _voxel_size = header.voxel_size;
+    _voxels.clear();
+    _voxels.reserve(header.voxel_num);
+    const char *p = buffer.data();
+    for(uint64_t i = 0; i < header.voxel_num; i++) {
+        Eigen::Matrix<int32_t, 3, 1> index;
+        VoxelStats stats;
+        std::memcpy(index.data(), p, 3 * sizeof(int32_t));
+        std::memcpy(&stats.count, p + 12, sizeof(uint32_t));
+        std::memcpy(stats.z_min.data(), p + 16, 3 * sizeof(float));
+        std::memcpy(stats.z_max.data(), p + 28, 3 * sizeof(float));
+        _voxels.emplace(packIndex(index), stats);
+        p += VoxelMapHeader::RECORD_SIZE;
+    }
+    return true;
+}
+
+
+
+void sampleWorkspace(const ConfigGrid &grid, const WorkspaceFK &fk,
+                     VoxelMap &map, int thread_num)
+{
+    const std::size_t num = grid.size();
+    const std::size_t chunk_num = (num + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    thread_num = static_cast<int>(std::min<std::size_t>(
+                std::max(thread_num, 1), std::max<std::size_t>(chunk_num, 1)));
+
+    std::atomic<std::size_t> next_chunk(0);
+    std::vector<VoxelMap> maps(thread_num, VoxelMap(map.voxelSize()));
+    auto run = [&](VoxelMap &local) {
+        std::vector<kfloat> q(grid.dim());
+        Pose pose;
+        for(std::size_t chunk = next_chunk++; chunk < chunk_num;
+            chunk = next_chunk++) {
+            std::size_t end = std::min(num, (chunk + 1) * CHUNK_SIZE);
+            for(std::size_t i = chunk * CHUNK_SIZE; i < end; i++) {
+                grid.at(i, q.data());
+                fk(q.data(), pose);
+                local.add(pose);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_num - 1);
+    for(int k = 1; k < thread_num; k++) {
+        threads.emplace_back(run, std::ref(maps[k]));
+    }
+    run(maps[0]);
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    for(const auto& local : maps) {
+        map.merge(local);
+    }
+}
+
+
+void sampleSingleWithRigidSegmentWorkspace(
+        const GridAxis &theta, const GridAxis &delta, const GridAxis &L,
+        kfloat Lr, VoxelMap &map, int thread_num)
+{
+    ConfigGrid grid({theta, delta, L});
+    sampleWorkspace(grid, [Lr](const kfloat *q, Pose &pose) {
+        calcSingleWithRigidSegmentPose<kfloat>(q[2], q[0], q[1], Lr, pose);
+    }, map, thread_num);
+}
+
+}} // mmath::continuum
@@ -1,140 +1,145 @@
 #include "../include/lib_math/kine/dcontinuum_pose.h"
+#include "../include/lib_math/kine/continuum_terms.h"
+#include <cmath>
 
 namespace mmath{
 namespace continuum{
 
-void dSingleSegmentPose2theta(kfloat L, kfloat theta, kfloat delta, Pose &dpose)
+template<typename Scalar>
+void dSingleSegmentPose2theta(NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+                              NonDeduced<Scalar> delta, PoseT<Scalar> &dpose)
 {
-    Eigen::Matrix<kfloat, 3, 3> R_t1_2_tb =
-            rotByZ<kfloat>(-PI / 2 + delta)*rotByY<kfloat>(-PI / 2);
-    dpose.R = R_t1_2_tb * dRotByZ<kfloat>(theta) * R_t1_2_tb.transpose();
-    if (abs(theta) < 1e-5) {
-        dpose.t = { 0, 0, 0 };
-    }
-    else {
-        dpose.t = L * R_t1_2_tb * Eigen::Vector<kfloat, 3>(
-                    (theta*cos(theta) - sin(theta)) / (theta*theta),
-                    (theta*sin(theta) - 1 + cos(theta)) / (theta*theta),
-                    0);
-    }
+    SegmentThetaTerms<Scalar> t;
+    calcSegmentThetaTerms<Scalar>(theta, t);
+    const Scalar sd = std::sin(delta), cd = std::cos(delta), sdcd = sd * cd;
+    dpose.R << -cd*cd*t.s, -sdcd*t.s, cd*t.c,
+            -sdcd*t.s, -sd*sd*t.s, sd*t.c,
+            -cd*t.c, -sd*t.c, -t.s;
+    dpose.t << L*cd*t.df1, L*sd*t.df1, L*t.df2;
 }
 
 
-Pose dSingleSegmentPose2theta(kfloat L, kfloat theta, kfloat delta)
+template<typename Scalar>
+PoseT<Scalar> dSingleSegmentPose2theta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta)
 {
-    Pose pose;
+    PoseT<Scalar> pose;
     dSingleSegmentPose2theta(L, theta, delta, pose);
     return pose;
 }
 
 
-void dSingleSegmentPose2delta(kfloat L, kfloat theta, kfloat delta, Pose &dpose)
+template<typename Scalar>
+void dSingleSegmentPose2delta(NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+                              NonDeduced<Scalar> delta, PoseT<Scalar> &dpose)
 {
-    Eigen::Matrix<kfloat, 3, 3> R_t1_2_tb =
-            rotByZ<kfloat>(-PI / 2 + delta)*rotByY<kfloat>(-PI / 2);
-    Eigen::Matrix<kfloat, 3, 3> dR_t1_2_tb =
-            rotByZ<kfloat>(-PI / 2)*dRotByZ<kfloat>(delta)*rotByY<kfloat>(-PI / 2);
-
-    dpose.R = dR_t1_2_tb * rotByZ<kfloat>(theta) * R_t1_2_tb.transpose() +
-            R_t1_2_tb * rotByZ<kfloat>(theta) * dR_t1_2_tb.transpose();
-    if (abs(theta) < 1e-5) {
-        dpose.t = { 0, 0, 0 };
-    }
-    else {
-        kfloat rc = L / theta;
-        dpose.t = rc * dR_t1_2_tb *
-                Eigen::Vector<kfloat, 3>(sin(theta), 1 - cos(theta), 0);
-    }
+    SegmentThetaTerms<Scalar> t;
+    calcSegmentThetaTerms<Scalar>(theta, t);
+    const Scalar sd = std::sin(delta), cd = std::cos(delta), sdcd = sd * cd;
+    const Scalar c2d = cd*cd - sd*sd;
+    dpose.R << 2*sdcd*t.omc, -c2d*t.omc, -sd*t.s,
+            -c2d*t.omc, -2*sdcd*t.omc, cd*t.s,
+            sd*t.s, -cd*t.s, 0;
+    dpose.t << -L*sd*t.f1, L*cd*t.f1, 0;
 }
 
 
-Pose dSingleSegmentPose2delta(kfloat L, kfloat theta, kfloat delta)
+template<typename Scalar>
+PoseT<Scalar> dSingleSegmentPose2delta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta)
 {
-    Pose pose;
+    PoseT<Scalar> pose;
     dSingleSegmentPose2delta(L, theta, delta, pose);
     return pose;
 }
 
 
-void dSingleSegmentPose2L(kfloat L, kfloat theta, kfloat delta, Pose &dpose)
+template<typename Scalar>
+void dSingleSegmentPose2L(NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+                          NonDeduced<Scalar> delta, PoseT<Scalar> &dpose)
 {
-    Eigen::Matrix<kfloat, 3, 3> R_t1_2_tb =
-            rotByZ<kfloat>(-PI / 2 + delta)*rotByY<kfloat>(-PI / 2);
-    dpose.R = Eigen::Matrix<kfloat, 3, 3>::Zero();
-    if (abs(theta) < 1e-5) {
-        dpose.t = Eigen::Vector<kfloat, 3>(0, 0, 1);
-    }
-    else {
-        kfloat rc = 1.0 / theta;
-        dpose.t = rc * R_t1_2_tb *
-                Eigen::Vector<kfloat, 3>(sin(theta), 1 - cos(theta), 0);
-    }
+    SegmentThetaTerms<Scalar> t;
+    calcSegmentThetaTerms<Scalar>(theta, t);
+    const Scalar sd = std::sin(delta), cd = std::cos(delta);
+    dpose.R = Eigen::Matrix<Scalar, 3, 3>::Zero();
+    dpose.t << cd*t.f1, sd*t.f1, t.f2;
 }
 
 
-Pose dSingleSegmentPose2L(kfloat L, kfloat theta, kfloat delta)
+template<typename Scalar>
+PoseT<Scalar> dSingleSegmentPose2L(NonDeduced<Scalar> L,
+                                   NonDeduced<Scalar> theta,
+                                   NonDeduced<Scalar> delta)
 {
-    Pose pose;
+    PoseT<Scalar> pose;
     dSingleSegmentPose2L(L, theta, delta, pose);
     return pose;
 }
 
 
-void dSingleWithRigidSegmentPose2theta(kfloat L, kfloat theta, kfloat delta,
-                                       kfloat Lr, Pose &dpose)
+template<typename Scalar>
+void dSingleWithRigidSegmentPose2theta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr, PoseT<Scalar> &dpose)
 {
     dSingleSegmentPose2theta(L, theta, delta, dpose);
-    if (abs(theta) > 1e-5) {
-        dpose.t += Lr * Eigen::Vector<kfloat, 3>(
-                    cos(delta)*cos(theta), sin(delta)*cos(theta), -sin(theta));
-    }
+    dpose.t += Lr * dpose.R.col(2);
 }
 
 
-Pose dSingleWithRigidSegmentPose2theta(kfloat L, kfloat theta, kfloat delta,
-                                       kfloat Lr)
+template<typename Scalar>
+PoseT<Scalar> dSingleWithRigidSegmentPose2theta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr)
 {
-    Pose pose;
+    PoseT<Scalar> pose;
     dSingleWithRigidSegmentPose2theta(L, theta, delta, Lr, pose);
     return pose;
 }
 
 
-void dSingleWithRigidSegmentPose2delta(kfloat L, kfloat theta, kfloat delta,
-                                       kfloat Lr, Pose &dpose)
+template<typename Scalar>
+void dSingleWithRigidSegmentPose2delta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr, PoseT<Scalar> &dpose)
 {
     dSingleSegmentPose2delta(L, theta, delta, dpose);
-    if (abs(theta) > 1e-5) {
-        dpose.t += Lr * Eigen::Vector<kfloat, 3>(
-                    -sin(delta)*sin(theta), cos(delta)*sin(theta), 0);
-    }
+    dpose.t += Lr * dpose.R.col(2);
 }
 
 
-Pose dSingleWithRigidSegmentPose2delta(kfloat L, kfloat theta, kfloat delta,
-                                       kfloat Lr)
+template<typename Scalar>
+PoseT<Scalar> dSingleWithRigidSegmentPose2delta(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr)
 {
-    Pose pose;
+    PoseT<Scalar> pose;
     dSingleWithRigidSegmentPose2delta(L, theta, delta, Lr, pose);
     return pose;
 }
 
 
-void dSingleWithRigidSegmentPose2L(kfloat L, kfloat theta, kfloat delta,
-                                   kfloat Lr, Pose &dpose)
+template<typename Scalar>
+void dSingleWithRigidSegmentPose2L(NonDeduced<Scalar> L,
+                                   NonDeduced<Scalar> theta,
+                                   NonDeduced<Scalar> delta,
+                                   NonDeduced<Scalar> Lr, PoseT<Scalar> &dpose)
 {
     dSingleSegmentPose2L(L, theta, delta, dpose);
-    if (abs(theta) > 1e-5) {
-        dpose.t += Lr * Eigen::Vector<kfloat, 3>(
-                    cos(delta)*sin(theta), sin(delta)*sin(theta), cos(theta));
-    }
+    dpose.t += Lr * Eigen::Vector<Scalar, 3>(
+                std::cos(delta)*std::sin(theta),
+                std::sin(delta)*std::sin(theta), std::cos(theta));
 }
 
 
-Pose dSingleWithRigidSegmentPose2L(kfloat L, kfloat theta, kfloat delta,
-                                   kfloat Lr)
+template<typename Scalar>
+PoseT<Scalar> dSingleWithRigidSegmentPose2L(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr)
 {
-    Pose pose;
+    PoseT<Scalar> pose;
     dSingleWithRigidSegmentPose2L(L, theta, delta, Lr, pose);
     return pose;
 }
@@ -145,149 +150,607 @@ Pose dSingleWithRigidSegmentPose2L(kfloat L, kfloat theta, kfloat delta,
 /*---------------------------------------------------------------------------*/
 
 
-void calcSingleSegmentJacobian(
-        kfloat L, kfloat theta, kfloat delta,
-        Eigen::Matrix<kfloat, 3, 2>& Jv, Eigen::Matrix<kfloat, 3, 2>& Jw)
+template<typename Scalar>
+void calcSingleSegmentJacobian(NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+                               NonDeduced<Scalar> delta,
+                               Eigen::Matrix<Scalar, 3, 2>& Jv,
+                               Eigen::Matrix<Scalar, 3, 2>& Jw)
 {
-    if(abs(theta) <= 1e-5) {
-        Jv << L * cos(delta) * 0.5, 0,
-                L * sin(delta) * 0.5, 0,
-                0, 0;
-        Jw << -sin(delta), 0,
-                cos(delta), 0,
-                0, 0;
-    }
-    else {
-        Jv(0, 0) = L*cos(delta) * (theta*sin(theta) + cos(theta) - 1) /
-                powf(theta, 2);
-        Jv(0, 1) = L*sin(delta) * (cos(theta) - 1)/theta;
-        Jv(1, 0) = L*sin(delta) * (theta*sin(theta) + cos(theta) - 1) /
-                powf(theta, 2);
-        Jv(1, 1) = -L*cos(delta) * (cos(theta) - 1) / theta;
-        Jv(2, 0) = L*(theta*cos(theta) - sin(theta)) / powf(theta, 2);
-        Jv(2, 1) = 0;
-
-        Jw << -sin(delta), -sin(theta)*cos(delta),
-                cos(delta), -sin(theta)*sin(delta),
-                0, 1 - cos(theta);
-    }
+    SegmentThetaTerms<Scalar> t;
+    calcSegmentThetaTerms<Scalar>(theta, t);
+    const Scalar sd = std::sin(delta), cd = std::cos(delta);
+    Jv << L*cd*t.df1, -L*sd*t.f1,
+            L*sd*t.df1, L*cd*t.f1,
+            L*t.df2, 0;
+    Jw << -sd, -t.s*cd,
+            cd, -t.s*sd,
+            0, t.omc;
 }
 
 
-void calcSingleSegmentJacobian(const ConfigSpc &q,
-        Eigen::Matrix<kfloat, 3, 2>& Jv, Eigen::Matrix<kfloat, 3, 2>& Jw)
+template<typename Scalar>
+void calcSingleSegmentJacobian(const ConfigSpcT<Scalar> &q,
+                               Eigen::Matrix<Scalar, 3, 2>& Jv,
+                               Eigen::Matrix<Scalar, 3, 2>& Jw)
 {
     if(q.is_bend) {
         calcSingleSegmentJacobian(q.length, q.theta, q.delta, Jv, Jw);
     }
     else {
-        Jv = Eigen::Matrix<kfloat, 3, 2>::Zero();
-        Jw = Eigen::Matrix<kfloat, 3, 2>::Zero();
+        Jv = Eigen::Matrix<Scalar, 3, 2>::Zero();
+        Jw = Eigen::Matrix<Scalar, 3, 2>::Zero();
     }
 }
 
 
 namespace {
-Eigen::Vector<kfloat, 3> calcJv2L(kfloat theta, kfloat delta)
+template<typename Scalar>
+Eigen::Vector<Scalar, 3> calcJv2L(Scalar theta, Scalar delta)
 {
-    if(abs(theta) <= 1e-5) {
-        return Eigen::Vector<kfloat, 3>(0, 0, 1);
-    }
-    else {
-        return Eigen::Vector<kfloat, 3>(
-                    cos(delta)*(1 - cos(theta)) / theta,
-                    sin(delta)*(1 - cos(theta)) / theta,
-                    sin(theta) / theta);
-    }
+    SegmentThetaTerms<Scalar> t;
+    calcSegmentThetaTerms<Scalar>(theta, t);
+    return Eigen::Vector<Scalar, 3>(std::cos(delta)*t.f1,
+                                    std::sin(delta)*t.f1, t.f2);
 }
 }
 
 
+template<typename Scalar>
 void calcVariableLengthSegmentJacobian(
-        kfloat L, kfloat theta, kfloat delta,
-        Eigen::Matrix<kfloat, 3, 3>& Jv, Eigen::Matrix<kfloat, 3, 3>& Jw)
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, Eigen::Matrix<Scalar, 3, 3>& Jv,
+        Eigen::Matrix<Scalar, 3, 3>& Jw)
 {
-    Eigen::Matrix<kfloat, 3, 2> Jv1, Jw1;
+    Eigen::Matrix<Scalar, 3, 2> Jv1, Jw1;
     calcSingleSegmentJacobian(L, theta, delta, Jv1, Jw1);
     Jv.block(0, 0, 3, 2) = Jv1;
     Jw.block(0, 0, 3, 2) = Jw1;
-    Jw.col(2) = Eigen::Vector<kfloat, 3>(0, 0, 0);
-    Jv.col(2) = calcJv2L(theta, delta);
+    Jw.col(2) = Eigen::Vector<Scalar, 3>(0, 0, 0);
+    Jv.col(2) = calcJv2L<Scalar>(theta, delta);
 }
 
 
-void calcVariableLengthSegmentJacobian(const ConfigSpc &q,
-        Eigen::Matrix<kfloat, 3, 3>& Jv, Eigen::Matrix<kfloat, 3, 3>& Jw)
+template<typename Scalar>
+void calcVariableLengthSegmentJacobian(
+        const ConfigSpcT<Scalar> &q, Eigen::Matrix<Scalar, 3, 3>& Jv,
+        Eigen::Matrix<Scalar, 3, 3>& Jw)
 {
     if(q.is_bend) {
         calcVariableLengthSegmentJacobian(q.length, q.theta, q.delta, Jv, Jw);
     }
     else {
-        Jv = Eigen::Matrix<kfloat, 3, 3>::Zero();
+        Jv = Eigen::Matrix<Scalar, 3, 3>::Zero();
         Jv(2, 2) = 1;
-        Jw = Eigen::Matrix<kfloat, 3, 3>::Zero();
+        Jw = Eigen::Matrix<Scalar, 3, 3>::Zero();
     }
 }
 
 
+template<typename Scalar>
 void calcSingleWithRigidSegmentJacobian(
-        kfloat L, kfloat theta, kfloat delta, kfloat Lr,
-        Eigen::Matrix<kfloat, 3, 2>& Jv, Eigen::Matrix<kfloat, 3, 2>& Jw)
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr,
+        Eigen::Matrix<Scalar, 3, 2>& Jv, Eigen::Matrix<Scalar, 3, 2>& Jw)
 {
     calcSingleSegmentJacobian(L, theta, delta, Jv, Jw);
-    if(abs(theta) <= 1e-5) {
-        Jv(0, 0) += Lr*cos(delta);
-        Jv(1, 0) += Lr*sin(delta);
-    }
-    else {
-        Jv(0, 0) += Lr*cos(theta)*cos(delta);
-        Jv(0, 1) += -Lr*sin(theta)*sin(delta);
-        Jv(1, 0) += Lr*cos(theta)*sin(delta);
-        Jv(1, 1) += Lr*sin(theta)*cos(delta);
-        Jv(2, 0) += -Lr*sin(theta);
-    }
+    const Scalar st = std::sin(theta), ct = std::cos(theta);
+    const Scalar sd = std::sin(delta), cd = std::cos(delta);
+    Jv(0, 0) += Lr*ct*cd;
+    Jv(0, 1) += -Lr*st*sd;
+    Jv(1, 0) += Lr*ct*sd;
+    Jv(1, 1) += Lr*st*cd;
+    Jv(2, 0) += -Lr*st;
 }
 
 
-void calcSingleWithRigidSegmentJacobian(const ConfigSpc &q, kfloat Lr,
-        Eigen::Matrix<kfloat, 3, 2>& Jv, Eigen::Matrix<kfloat, 3, 2>& Jw)
+template<typename Scalar>
+void calcSingleWithRigidSegmentJacobian(
+        const ConfigSpcT<Scalar> &q, NonDeduced<Scalar> Lr,
+        Eigen::Matrix<Scalar, 3, 2>& Jv, Eigen::Matrix<Scalar, 3, 2>& Jw)
 {
     if(q.is_bend) {
         calcSingleWithRigidSegmentJacobian(
                     q.length, q.theta, q.delta, Lr, Jv, Jw);
     }
     else {
-        Jv = Eigen::Matrix<kfloat, 3, 2>::Zero();
-        Jw = Eigen::Matrix<kfloat, 3, 2>::Zero();
+        Jv = Eigen::Matrix<Scalar, 3, 2>::Zero();
+        Jw = Eigen::Matrix<Scalar, 3, 2>::Zero();
     }
 }
 
 
+template<typename Scalar>
 void calcVariableLengthWithRigidSegmentJacobian(
-        kfloat L, kfloat theta, kfloat delta, kfloat Lr,
-        Eigen::Matrix<kfloat, 3, 3>& Jv, Eigen::Matrix<kfloat, 3, 3>& Jw)
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr,
+        Eigen::Matrix<Scalar, 3, 3>& Jv, Eigen::Matrix<Scalar, 3, 3>& Jw)
 {
-    Eigen::Matrix<kfloat, 3, 2> Jv1, Jw1;
+    Eigen::Matrix<Scalar, 3, 2> Jv1, Jw1;
     calcSingleWithRigidSegmentJacobian(L, theta, delta, Lr, Jv1, Jw1);
     Jv.block(0, 0, 3, 2) = Jv1;
     Jw.block(0, 0, 3, 2) = Jw1;
-    Jw.col(2) = Eigen::Vector<kfloat, 3>(0, 0, 0);
-    Jv.col(2) = calcJv2L(theta, delta);
+    Jw.col(2) = Eigen::Vector<Scalar, 3>(0, 0, 0);
+    Jv.col(2) = calcJv2L<Scalar>(theta, delta);
 }
 
 
-void calcVariableLengthWithRigidSegmentJacobian(const ConfigSpc &q, kfloat Lr,
-        Eigen::Matrix<kfloat, 3, 3>& Jv, Eigen::Matrix<kfloat, 3, 3>& Jw)
+template<typename Scalar>
+void calcVariableLengthWithRigidSegmentJacobian(
+        const ConfigSpcT<Scalar> &q, NonDeduced<Scalar> Lr,
+        Eigen::Matrix<Scalar, 3, 3>& Jv, Eigen::Matrix<Scalar, 3, 3>& Jw)
 {
     if(q.is_bend) {
         calcVariableLengthWithRigidSegmentJacobian(
                     q.length, q.theta, q.delta, Lr, Jv, Jw);
     }
     else {
-        Jv = Eigen::Matrix<kfloat, 3, 3>::Zero();
+        Jv = Eigen::Matrix<Scalar, 3, 3>::Zero();
         Jv(2, 2) = 1;
-        Jw = Eigen::Matrix<kfloat, 3, 3>::Zero();
+        Jw = Eigen::Matrix<Scalar, 3, 3>::Zero();
     }
 }
 
+
+/*---------------------------------------------------------------------------*/
+/*            Calculate the Pose and the Jacobian in a fused kernel          */
+/*---------------------------------------------------------------------------*/
+
+
+namespace {
+/**
+ * The fused kernel, where N = 2 gives [theta, delta] columns and N = 3 gives
+ * [theta, delta, L] columns. With f1 = (1 - cos(theta))/theta and
+ * f2 = sin(theta)/theta, the position is
+ *   t = L*[cos(delta)*f1, sin(delta)*f1, f2] + Lr*R.col(2).
+ */
+template<typename Scalar, int N>
+void calcPoseAndJacobian(NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+                         NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr,
+                         PoseT<Scalar>& pose, Eigen::Matrix<Scalar, 3, N>& Jv,
+                         Eigen::Matrix<Scalar, 3, N>& Jw,
+                         PoseT<Scalar> *dpose2theta, PoseT<Scalar> *dpose2delta,
+                         PoseT<Scalar> *dpose2L)
+{
+    // f1, f2 and their derivatives to theta, without branches near zero
+    SegmentThetaTerms<Scalar> terms;
+    calcSegmentThetaTerms<Scalar>(theta, terms);
+    const Scalar st = terms.s, ct = terms.c, omc = terms.omc;
+    const Scalar f1 = terms.f1, f2 = terms.f2;
+    const Scalar df1 = terms.df1, df2 = terms.df2;
+    const Scalar sd = std::sin(delta), cd = std::cos(delta);
+
+    const Scalar sdcd = sd * cd;
+    pose.R << 1 - cd*cd*omc, -sdcd*omc, cd*st,
+            -sdcd*omc, 1 - sd*sd*omc, sd*st,
+            -cd*st, -sd*st, ct;
+    pose.t << L*cd*f1 + Lr*cd*st, L*sd*f1 + Lr*sd*st, L*f2 + Lr*ct;
+
+    const Scalar k = L*f1 + Lr*st;
+    Jv(0, 0) = L*cd*df1 + Lr*cd*ct;
+    Jv(1, 0) = L*sd*df1 + Lr*sd*ct;
+    Jv(2, 0) = L*df2 - Lr*st;
+    Jv(0, 1) = -k*sd;
+    Jv(1, 1) = k*cd;
+    Jv(2, 1) = 0;
+
+    Jw.template leftCols<2>() << -sd, -st*cd,
+            cd, -st*sd,
+            0, omc;
+    if constexpr (N == 3) {
+        Jv.col(2) = Eigen::Vector<Scalar, 3>(cd*f1, sd*f1, f2);
+        Jw.col(2) = Eigen::Vector<Scalar, 3>(0, 0, 0);
+    }
+
+    if(dpose2theta) {
+        dpose2theta->R << -cd*cd*st, -sdcd*st, cd*ct,
+                -sdcd*st, -sd*sd*st, sd*ct,
+                -cd*ct, -sd*ct, -st;
+        dpose2theta->t = Jv.col(0);
+    }
+    if(dpose2delta) {
+        Scalar c2d = cd*cd - sd*sd;
+        dpose2delta->R << 2*sdcd*omc, -c2d*omc, -sd*st,
+                -c2d*omc, -2*sdcd*omc, cd*st,
+                sd*st, -cd*st, 0;
+        dpose2delta->t = Jv.col(1);
+    }
+    if(dpose2L) {
+        dpose2L->R = Eigen::Matrix<Scalar, 3, 3>::Zero();
+        dpose2L->t = Eigen::Vector<Scalar, 3>(cd*f1, sd*f1, f2);
+    }
+}
+
+
+/** The fused kernel of a rigid segment, which only rotates along z by delta. */
+template<typename Scalar, int N>
+void calcRigidPoseAndJacobian(NonDeduced<Scalar> L, NonDeduced<Scalar> delta,
+                              NonDeduced<Scalar> Lr, PoseT<Scalar>& pose,
+                              Eigen::Matrix<Scalar, 3, N>& Jv,
+                              Eigen::Matrix<Scalar, 3, N>& Jw,
+                              PoseT<Scalar> *dpose2theta,
+                              PoseT<Scalar> *dpose2delta,
+                              PoseT<Scalar> *dpose2L)
+{
+    const Scalar sd = std::sin(delta), cd = std::cos(delta);
+    pose.R << cd, -sd, 0,
+            sd, cd, 0,
+            0, 0, 1;
+    pose.t = Eigen::Vector<Scalar, 3>(0, 0, L + Lr);
+
+    Jv = Eigen::Matrix<Scalar, 3, N>::Zero();
+    Jw = Eigen::Matrix<Scalar, 3, N>::Zero();
+    if constexpr (N == 3) {
+        Jv(2, 2) = 1;
+    }
+
+    if(dpose2theta) {
+        dpose2theta->R = Eigen::Matrix<Scalar, 3, 3>::Zero();
+        dpose2theta->t = Eigen::Vector<Scalar, 3>(0, 0, 0);
+    }
+    if(dpose2delta) {
+        dpose2delta->R << -sd, -cd, 0,
+                cd, -sd, 0,
+                0, 0, 0;
+        dpose2delta->t = Eigen::Vector<Scalar, 3>(0, 0, 0);
+    }
+    if(dpose2L) {
+        dpose2L->R = Eigen::Matrix<Scalar, 3, 3>::Zero();
+        dpose2L->t = Eigen::Vector<Scalar, 3>(0, 0, 1);
+    }
+}
+}
+
+
+template<typename Scalar>
+void calcSingleSegmentPoseAndJacobian(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, PoseT<Scalar>& pose,
+        Eigen::Matrix<Scalar, 3, 2>& Jv, Eigen::Matrix<Scalar, 3, 2>& Jw,
+        PoseT<Scalar> *dpose2theta, PoseT<Scalar> *dpose2delta,
+        PoseT<Scalar> *dpose2L)
+{
+    calcPoseAndJacobian<Scalar>(L, theta, delta, 0, pose, Jv, Jw,
+                        dpose2theta, dpose2delta, dpose2L);
+}
+
+
+template<typename Scalar>
+void calcSingleSegmentPoseAndJacobian(
+        const ConfigSpcT<Scalar> &q, PoseT<Scalar>& pose,
+        Eigen::Matrix<Scalar, 3, 2>& Jv, Eigen::Matrix<Scalar, 3, 2>& Jw,
+        PoseT<Scalar> *dpose2theta, PoseT<Scalar> *dpose2delta,
+        PoseT<Scalar> *dpose2L)
+{
+    if(q.is_bend) {
+        calcPoseAndJacobian<Scalar>(q.length, q.theta, q.delta, 0, pose, Jv,
+                                    Jw, dpose2theta, dpose2delta, dpose2L);
+    }
+    else {
+        calcRigidPoseAndJacobian<Scalar>(q.length, q.delta, 0, pose, Jv, Jw,
+                                         dpose2theta, dpose2delta, dpose2L);
+    }
+}
+
+
+template<typename Scalar>
+void calcVariableLengthWithRigidSegmentPoseAndJacobian(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr, PoseT<Scalar>& pose,
+        Eigen::Matrix<Scalar, 3, 3>& Jv, Eigen::Matrix<Scalar, 3, 3>& Jw,
+        PoseT<Scalar> *dpose2theta, PoseT<Scalar> *dpose2delta,
+        PoseT<Scalar> *dpose2L)
+{
+    calcPoseAndJacobian<Scalar>(L, theta, delta, Lr, pose, Jv, Jw,
+                        dpose2theta, dpose2delta, dpose2L);
+}
+
+
+template<typename Scalar>
+void calcVariableLengthWithRigidSegmentPoseAndJacobian(
+        const ConfigSpcT<Scalar> &q, NonDeduced<Scalar> Lr, PoseT<Scalar>& pose,
+        Eigen::Matrix<Scalar, 3, 3>& Jv, Eigen::Matrix<Scalar, 3, 3>& Jw,
+        PoseT<Scalar> *dpose2theta, PoseT<Scalar> *dpose2delta,
+        PoseT<Scalar> *dpose2L)
+{
+    if(q.is_bend) {
+        calcPoseAndJacobian<Scalar>(q.length, q.theta, q.delta, Lr, pose, Jv,
+                                    Jw, dpose2theta, dpose2delta, dpose2L);
+    }
+    else {
+        calcRigidPoseAndJacobian<Scalar>(q.length, q.delta, Lr, pose, Jv, Jw,
+                                         dpose2theta, dpose2delta, dpose2L);
+    }
+}
+
+
+/*---------------------------------------------------------------------------*/
+/*           Calculate the second derivatives of Pose, i.e., Hessian         */
+/*---------------------------------------------------------------------------*/
+
+
+namespace {
+/** The terms of delta in pose, or their derivatives to delta. */
+template<typename Scalar>
+struct DeltaTerms
+{
+    Scalar c2;  //!< cos(delta)^2
+    Scalar s2;  //!< sin(delta)^2
+    Scalar sc;  //!< sin(delta)*cos(delta)
+    Scalar c;   //!< cos(delta)
+    Scalar s;   //!< sin(delta)
+    Scalar u;   //!< 1, which is the coefficient of R(2, 2) and t[2]
+};
+
+
+/** The terms of theta in pose, or their derivatives to theta. */
+template<typename Scalar>
+struct ThetaTerms
+{
+    Scalar omc; //!< 1 - cos(theta)
+    Scalar s;   //!< sin(theta)
+    Scalar c;   //!< cos(theta)
+    Scalar f1;  //!< (1 - cos(theta))/theta
+    Scalar f2;  //!< sin(theta)/theta
+};
+
+
+/**
+ * The partial of pose built from the terms, with
+ *   R = [one - c2*omc, -sc*omc, c*s; -sc*omc, one - s2*omc, s*s; -c*s, -s*s, u*c]
+ *   t = L*[c*f1, s*f1, u*f2] + Lr*[c*s, s*s, u*c],
+ * where one is 1 for the pose and 0 for the derivatives.
+ */
+template<typename Scalar>
+void calcPartial(const DeltaTerms<Scalar> &d, const ThetaTerms<Scalar> &t,
+                 Scalar one, Scalar L, Scalar Lr, PoseT<Scalar> &dpose)
+{
+    dpose.R << one - d.c2*t.omc, -d.sc*t.omc, d.c*t.s,
+            -d.sc*t.omc, one - d.s2*t.omc, d.s*t.s,
+            -d.c*t.s, -d.s*t.s, d.u*t.c;
+    const Scalar k = L*t.f1 + Lr*t.s;
+    dpose.t << d.c*k, d.s*k, d.u*(L*t.f2 + Lr*t.c);
+}
+
+
+/** The partial of the partial, to L if L = 1 and Lr = 0, or to Lr reversely. */
+template<typename Scalar>
+void calcLengthPartial(const DeltaTerms<Scalar> &d, const ThetaTerms<Scalar> &t,
+                       Scalar L, Scalar Lr, PoseT<Scalar> &dpose)
+{
+    dpose.R = Eigen::Matrix<Scalar, 3, 3>::Zero();
+    const Scalar k = L*t.f1 + Lr*t.s;
+    dpose.t << d.c*k, d.s*k, d.u*(L*t.f2 + Lr*t.c);
+}
+
+
+/** The zero partial. */
+template<typename Scalar>
+void setZero(PoseT<Scalar> &dpose)
+{
+    dpose.R = Eigen::Matrix<Scalar, 3, 3>::Zero();
+    dpose.t = Eigen::Vector<Scalar, 3>::Zero();
+}
+
+
+/** Copy the upper triangle of d2pose to the lower. */
+template<typename Scalar, int N>
+void symmetrize(PoseT<Scalar> d2pose[N][N])
+{
+    for(int i = 1; i < N; i++) {
+        for(int j = 0; j < i; j++) {
+            d2pose[i][j] = d2pose[j][i];
+        }
+    }
+}
+
+
+/**
+ * The Hessian kernel, where N = 3 gives [theta, delta, L] and N = 4 gives
+ * [theta, delta, L, Lr]. The pose is a sum of the products of the delta terms
+ * and the theta terms, so each partial is the same product of the derivatives
+ * of the terms.
+ */
+template<typename Scalar, int N>
+void calcPoseHessian(Scalar L, Scalar theta, Scalar delta, Scalar Lr,
+                     PoseT<Scalar> d2pose[N][N], PoseT<Scalar> *pose,
+                     PoseT<Scalar> *dpose)
+{
+    // f1, f2 and their derivatives to theta, without branches near zero
+    SegmentThetaTerms<Scalar> terms;
+    SegmentThetaSecondTerms<Scalar> terms2;
+    calcSegmentThetaTerms<Scalar>(theta, terms);
+    calcSegmentThetaSecondTerms<Scalar>(theta, terms, terms2);
+    const Scalar st = terms.s, ct = terms.c, omc = terms.omc;
+    const Scalar f1 = terms.f1, f2 = terms.f2;
+    const Scalar df1 = terms.df1, df2 = terms.df2;
+    const Scalar ddf1 = terms2.ddf1, ddf2 = terms2.ddf2;
+    const Scalar sd = std::sin(delta), cd = std::cos(delta);
+
+    // The k-th derivatives of the terms
+    const Scalar c2 = cd*cd, s2 = sd*sd, sc = sd*cd, c2d = c2 - s2;
+    const DeltaTerms<Scalar> d[3] = {
+        { c2, s2, sc, cd, sd, 1 },
+        { -2*sc, 2*sc, c2d, -sd, cd, 0 },
+        { -2*c2d, 2*c2d, -4*sc, -cd, -sd, 0 }
+    };
+    const ThetaTerms<Scalar> t[3] = {
+        { omc, st, ct, f1, f2 },
+        { st, ct, -st, df1, df2 },
+        { ct, -st, -ct, ddf1, ddf2 }
+    };
+
+    if(pose) {
+        calcPartial<Scalar>(d[0], t[0], 1, L, Lr, *pose);
+    }
+    if(dpose) {
+        calcPartial<Scalar>(d[0], t[1], 0, L, Lr, dpose[0]);
+        calcPartial<Scalar>(d[1], t[0], 0, L, Lr, dpose[1]);
+        calcLengthPartial<Scalar>(d[0], t[0], 1, 0, dpose[2]);
+        if constexpr (N == 4) {
+            calcLengthPartial<Scalar>(d[0], t[0], 0, 1, dpose[3]);
+        }
+    }
+
+    calcPartial<Scalar>(d[0], t[2], 0, L, Lr, d2pose[0][0]);
+    calcPartial<Scalar>(d[1], t[1], 0, L, Lr, d2pose[0][1]);
+    calcPartial<Scalar>(d[2], t[0], 0, L, Lr, d2pose[1][1]);
+    calcLengthPartial<Scalar>(d[0], t[1], 1, 0, d2pose[0][2]);
+    calcLengthPartial<Scalar>(d[1], t[0], 1, 0, d2pose[1][2]);
+    setZero(d2pose[2][2]);
+    if constexpr (N == 4) {
+        calcLengthPartial<Scalar>(d[0], t[1], 0, 1, d2pose[0][3]);
+        calcLengthPartial<Scalar>(d[1], t[0], 0, 1, d2pose[1][3]);
+        setZero(d2pose[2][3]);
+        setZero(d2pose[3][3]);
+    }
+    symmetrize<Scalar, N>(d2pose);
+}
+
+
+/** The Hessian of a rigid segment, which only rotates along z by delta. */
+template<typename Scalar, int N>
+void calcRigidPoseHessian(Scalar L, Scalar delta, Scalar Lr,
+                          PoseT<Scalar> d2pose[N][N], PoseT<Scalar> *pose,
+                          PoseT<Scalar> *dpose)
+{
+    const Scalar sd = std::sin(delta), cd = std::cos(delta);
+    if(pose) {
+        pose->R << cd, -sd, 0,
+                sd, cd, 0,
+                0, 0, 1;
+        pose->t = Eigen::Vector<Scalar, 3>(0, 0, L + Lr);
+    }
+    if(dpose) {
+        for(int i = 0; i < N; i++) {
+            setZero(dpose[i]);
+        }
+        dpose[1].R << -sd, -cd, 0,
+                cd, -sd, 0,
+                0, 0, 0;
+        for(int i = 2; i < N; i++) {
+            dpose[i].t[2] = 1;
+        }
+    }
+
+    for(int i = 0; i < N; i++) {
+        for(int j = 0; j < N; j++) {
+            setZero(d2pose[i][j]);
+        }
+    }
+    d2pose[1][1].R << -cd, sd, 0,
+            -sd, -cd, 0,
+            0, 0, 0;
+}
+}
+
+
+template<typename Scalar>
+void calcSingleSegmentPoseHessian(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, PoseT<Scalar> d2pose[3][3],
+        PoseT<Scalar> *pose, PoseT<Scalar> *dpose)
+{
+    calcPoseHessian<Scalar, 3>(L, theta, delta, 0, d2pose, pose, dpose);
+}
+
+
+template<typename Scalar>
+void calcSingleSegmentPoseHessian(
+        const ConfigSpcT<Scalar> &q, PoseT<Scalar> d2pose[3][3],
+        PoseT<Scalar> *pose, PoseT<Scalar> *dpose)
+{
+    if(q.is_bend) {
+        calcPoseHessian<Scalar, 3>(q.length, q.theta, q.delta, 0, d2pose,
+                                   pose, dpose);
+    }
+    else {
+        calcRigidPoseHessian<Scalar, 3>(q.length, q.delta, 0, d2pose,
+                                        pose, dpose);
+    }
+}
+
+
+template<typename Scalar>
+void calcSingleWithRigidSegmentPoseHessian(
+        NonDeduced<Scalar> L, NonDeduced<Scalar> theta,
+        NonDeduced<Scalar> delta, NonDeduced<Scalar> Lr,
+        PoseT<Scalar> d2pose[4][4], PoseT<Scalar> *pose, PoseT<Scalar> *dpose)
+{
+    calcPoseHessian<Scalar, 4>(L, theta, delta, Lr, d2pose, pose, dpose);
+}
+
+
+template<typename Scalar>
+void calcSingleWithRigidSegmentPoseHessian(
+        const ConfigSpcT<Scalar> &q, NonDeduced<Scalar> Lr,
+        PoseT<Scalar> d2pose[4][4], PoseT<Scalar> *pose, PoseT<Scalar> *dpose)
+{
+    if(q.is_bend) {
+        calcPoseHessian<Scalar, 4>(q.length, q.theta, q.delta, Lr, d2pose,
+                                   pose, dpose);
+    }
+    else {
+        calcRigidPoseHessian<Scalar, 4>(q.length, q.delta, Lr, d2pose,
+                                        pose, dpose);
+    }
+}
+
+
+/* Explicit instantiations for float and double */
+#define INSTANTIATE_DCONTINUUM_POSE(T)                                        \
+    template void dSingleSegmentPose2theta<T>(T, T, T, PoseT<T>&);            \
+    template PoseT<T> dSingleSegmentPose2theta<T>(T, T, T);                   \
+    template void dSingleSegmentPose2delta<T>(T, T, T, PoseT<T>&);            \
+    template PoseT<T> dSingleSegmentPose2delta<T>(T, T, T);                   \
+    template void dSingleSegmentPose2L<T>(T, T, T, PoseT<T>&);                \
+    template PoseT<T> dSingleSegmentPose2L<T>(T, T, T);                       \
+    template void dSingleWithRigidSegmentPose2theta<T>(T, T, T, T,            \
+            PoseT<T>&);                                                       \
+    template PoseT<T> dSingleWithRigidSegmentPose2theta<T>(T, T, T, T);       \
+    template void dSingleWithRigidSegmentPose2delta<T>(T, T, T, T,            \
+            PoseT<T>&);                                                       \
+    template PoseT<T> dSingleWithRigidSegmentPose2delta<T>(T, T, T, T);       \
+    template void dSingleWithRigidSegmentPose2L<T>(T, T, T, T, PoseT<T>&);    \
+    template PoseT<T> dSingleWithRigidSegmentPose2L<T>(T, T, T, T);           \
+    template void calcSingleSegmentJacobian<T>(T, T, T,                       \
+            Eigen::Matrix<T, 3, 2>&, Eigen::Matrix<T, 3, 2>&);                \
+    template void calcSingleSegmentJacobian<T>(const ConfigSpcT<T>&,          \
+            Eigen::Matrix<T, 3, 2>&, Eigen::Matrix<T, 3, 2>&);                \
+    template void calcVariableLengthSegmentJacobian<T>(T, T, T,               \
+            Eigen::Matrix<T, 3, 3>&, Eigen::Matrix<T, 3, 3>&);                \
+    template void calcVariableLengthSegmentJacobian<T>(const ConfigSpcT<T>&,  \
+            Eigen::Matrix<T, 3, 3>&, Eigen::Matrix<T, 3, 3>&);                \
+    template void calcSingleWithRigidSegmentJacobian<T>(T, T, T, T,           \
+            Eigen::Matrix<T, 3, 2>&, Eigen::Matrix<T, 3, 2>&);                \
+    template void calcSingleWithRigidSegmentJacobian<T>(const ConfigSpcT<T>&, \
+            T, Eigen::Matrix<T, 3, 2>&, Eigen::Matrix<T, 3, 2>&);             \
+    template void calcVariableLengthWithRigidSegmentJacobian<T>(T, T, T, T,   \
+            Eigen::Matrix<T, 3, 3>&, Eigen::Matrix<T, 3, 3>&);                \
+    template void calcVariableLengthWithRigidSegmentJacobian<T>(const ConfigSpcT<T>&, \
+            T, Eigen::Matrix<T, 3, 3>&, Eigen::Matrix<T, 3, 3>&);             \
+    template void calcSingleSegmentPoseAndJacobian<T>(T, T, T, PoseT<T>&,     \
+            Eigen::Matrix<T, 3, 2>&, Eigen::Matrix<T, 3, 2>&, PoseT<T>*,      \
+            PoseT<T>*, PoseT<T>*);                                            \
+    template void calcSingleSegmentPoseAndJacobian<T>(const ConfigSpcT<T>&,   \
+            PoseT<T>&, Eigen::Matrix<T, 3, 2>&, Eigen::Matrix<T, 3, 2>&,      \
+            PoseT<T>*, PoseT<T>*, PoseT<T>*);                                 \
+    template void calcVariableLengthWithRigidSegmentPoseAndJacobian<T>(T, T,  \
+            T, T, PoseT<T>&, Eigen::Matrix<T, 3, 3>&,                         \
+            Eigen::Matrix<T, 3, 3>&, PoseT<T>*, PoseT<T>*, PoseT<T>*);        \
+    template void calcVariableLengthWithRigidSegmentPoseAndJacobian<T>(const ConfigSpcT<T>&, \
+            T, PoseT<T>&, Eigen::Matrix<T, 3, 3>&, Eigen::Matrix<T, 3, 3>&,   \
+            PoseT<T>*, PoseT<T>*, PoseT<T>*);                                 \
+    template void calcSingleSegmentPoseHessian<T>(T, T, T, PoseT<T>[3][3],    \
+            PoseT<T>*, PoseT<T>*);                                            \
+    template void calcSingleSegmentPoseHessian<T>(const ConfigSpcT<T>&,       \
+            PoseT<T>[3][3], PoseT<T>*, PoseT<T>*);                            \
+    template void calcSingleWithRigidSegmentPoseHessian<T>(T, T, T, T,        \
+            PoseT<T>[4][4], PoseT<T>*, PoseT<T>*);                            \
+    template void calcSingleWithRigidSegmentPoseHessian<T>(                   \
+            const ConfigSpcT<T>&, T, PoseT<T>[4][4], PoseT<T>*, PoseT<T>*);
+
+INSTANTIATE_DCONTINUUM_POSE(float)
+INSTANTIATE_DCONTINUUM_POSE(double)
+#undef INSTANTIATE_DCONTINUUM_POSE
+
 }} // mmath::continuum
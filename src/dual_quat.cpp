@@ -0,0 +1,74 @@
+#include "../include/lib_math/kine/dual_quat.h"
+#include "../include/lib_math/kine/lie.h"
+#include <cassert>
+
+namespace mmath{
+
+namespace {
+/** Blend dqs[indices[j]] (or dqs[j] if indices is nullptr), j < num. */
+template<typename Scalar>
+DualQuatT<Scalar> blendRange(const DualQuatT<Scalar> *dqs, const int *indices,
+                             const Scalar *weights, std::size_t num)
+{
+    assert(num > 0);
+    const DualQuatT<Scalar>& pivot = dqs[indices ? indices[0] : 0];
+    Eigen::Vector<Scalar, 4> real = Eigen::Vector<Scalar, 4>::Zero();
+    Eigen::Vector<Scalar, 4> dual = Eigen::Vector<Scalar, 4>::Zero();
+    for(std::size_t j = 0; j < num; j++) {
+        const DualQuatT<Scalar>& dq = dqs[indices ? indices[j] : j];
+        Scalar w = dq.real.dot(pivot.real) < 0 ? -weights[j] : weights[j];
+        real += w * dq.real.coeffs();
+        dual += w * dq.dual.coeffs();
+    }
+
+    DualQuatT<Scalar> ret;
+    ret.real.coeffs() = real;
+    ret.dual.coeffs() = dual;
+    ret.normalize();
+    return ret;
+}
+}
+
+
+template<typename Scalar>
+DualQuatT<Scalar> blendDualQuat(const DualQuatT<Scalar> *dqs,
+                                const Scalar *weights, std::size_t num)
+{
+    return blendRange<Scalar>(dqs, nullptr, weights, num);
+}
+
+
+template<typename Scalar>
+void blendDualQuatBatch(const DualQuatT<Scalar> *dqs, const int *indices,
+                        const Scalar *weights, int k, std::size_t num,
+                        DualQuatT<Scalar> *out)
+{
+    for(std::size_t i = 0; i < num; i++) {
+        out[i] = blendRange(dqs, indices + i * k, weights + i * k, k);
+    }
+}
+
+
+template<typename Scalar>
+DualQuatT<Scalar> sclerp(const DualQuatT<Scalar> &dq0,
+                         const DualQuatT<Scalar> &dq1, NonDeduced<Scalar> h)
+{
+    DualQuatT<Scalar> rel = dq0.inverse() * dq1;
+    Eigen::Vector<Scalar, 6> xi = logSE3(rel.toPose());
+    return dq0 * DualQuatT<Scalar>(expSE3(Eigen::Vector<Scalar, 6>(h * xi)));
+}
+
+
+/* Explicit instantiations for float and double */
+#define INSTANTIATE_DUAL_QUAT(T)                                              \
+    template DualQuatT<T> blendDualQuat<T>(const DualQuatT<T>*, const T*,     \
+            std::size_t);                                                     \
+    template void blendDualQuatBatch<T>(const DualQuatT<T>*, const int*,      \
+            const T*, int, std::size_t, DualQuatT<T>*);                       \
+    template DualQuatT<T> sclerp<T>(const DualQuatT<T>&, const DualQuatT<T>&, \
+            T);
+INSTANTIATE_DUAL_QUAT(float)
+INSTANTIATE_DUAL_QUAT(double)
+#undef INSTANTIATE_DUAL_QUAT
+
+} // mmath
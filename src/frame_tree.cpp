@@ -0,0 +1,384 @@
+#include "../include/lib_math/kine/frame_tree.h"
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+namespace mmath{
+
+namespace {
+/** A sample of parent_T_child. */
+struct Sample
+{
+    double                    time = 0;
+    Eigen::Quaternion<kfloat> q = Eigen::Quaternion<kfloat>::Identity();
+    Eigen::Vector<kfloat, 3>  t = Eigen::Vector<kfloat, 3>::Zero();
+};
+
+
+/**
+ * A slot of the ring buffer, where each word is an atomic accessed with the
+ * relaxed order, so a reader racing with the writer is well-defined and only
+ * sees a torn sample, which is discarded by the check of the sequence lock.
+ */
+struct SampleSlot
+{
+    std::atomic<double> time{0};
+    std::atomic<kfloat> q[4];
+    std::atomic<kfloat> t[3];
+
+    double loadTime() const
+    {
+        return time.load(std::memory_order_relaxed);
+    }
+
+    void load(Sample &s) const
+    {
+        s.time = time.load(std::memory_order_relaxed);
+        for(int i = 0; i < 4; i++) {
+            s.q.coeffs()[i] = q[i].load(std::memory_order_relaxed);
+        }
+        for(int i = 0; i < 3; i++) {
+            s.t[i] = t[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    void store(double sample_time, const Pose &pose)
+    {
+        Eigen::Quaternion<kfloat> quat(pose.R);
+        time.store(sample_time, std::memory_order_relaxed);
+        for(int i = 0; i < 4; i++) {
+            q[i].store(quat.coeffs()[i], std::memory_order_relaxed);
+        }
+        for(int i = 0; i < 3; i++) {
+            t[i].store(pose.t[i], std::memory_order_relaxed);
+        }
+    }
+};
+
+
+/** Return the interpolated pose between two samples. */
+Pose interpolate(const Sample &s0, const Sample &s1, double time)
+{
+    double dt = s1.time - s0.time;
+    kfloat h = dt > 0 ? static_cast<kfloat>((time - s0.time) / dt) : 0;
+    Pose pose;
+    pose.R = s0.q.slerp(h, s1.q).toRotationMatrix();
+    pose.t = (1 - h) * s0.t + h * s1.t;
+    return pose;
+}
+}
+
+
+struct FrameTree::Frame
+{
+    std::string            name;
+    int                    parent;
+    int                    depth;
+    std::atomic<uint64_t>  seq{0};           //!< Odd while being written.
+    std::atomic<uint64_t>  count{0};         //!< The number of samples.
+    std::atomic<bool>      is_static{false}; //!< Whether the edge is static.
+    std::unique_ptr<SampleSlot[]> samples;   //!< The ring buffer.
+};
+
+
+FrameTree::FrameTree(std::size_t buffer_size)
+    : _buffer_size(std::max<std::size_t>(buffer_size, 2))
+{}
+
+
+FrameTree::~FrameTree() = default;
+
+
+int FrameTree::addFrame(const std::string &name, const std::string &parent)
+{
+    if(name.empty() || _ids.count(name)) {
+        return -1;
+    }
+    int parent_id = -1;
+    if(!parent.empty()) {
+        parent_id = frameId(parent);
+        if(parent_id < 0) {
+            return -1;
+        }
+    }
+
+    std::unique_ptr<Frame> frame(new Frame);
+    frame->name = name;
+    frame->parent = parent_id;
+    frame->depth = parent_id < 0 ? 0 : _frames[parent_id]->depth + 1;
+    if(parent_id >= 0) {
+        frame->samples.reset(new SampleSlot[_buffer_size]());
+    }
+
+    int id = static_cast<int>(_frames.size());
+    _frames.push_back(std::move(frame));
+    _ids[name] = id;
+    return id;
+}
+
+
+int FrameTree::frameId(const std::string &name) const
+{
+    auto it = _ids.find(name);
+    return it == _ids.end() ? -1 : it->second;
+}
+
+
+std::size_t FrameTree::frameNum() const
+{
+    return _frames.size();
+}
+
+
+const std::string& FrameTree::frameName(int id) const
+{
+    assert(id >= 0 && id < static_cast<int>(_frames.size()));
+    return _frames[id]->name;
+}
+
+
+int FrameTree::parent(int id) const
+{
+    assert(id >= 0 && id < static_cast<int>(_frames.size()));
+    return _frames[id]->parent;
+}
+
+
+bool FrameTree::setTransform(int id, double time, const Pose &pose)
+{
+    assert(id >= 0 && id < static_cast<int>(_frames.size()));
+    Frame& f = *_frames[id];
+    uint64_t n = f.count.load(std::memory_order_relaxed);
+    if(f.parent < 0 || f.is_static.load(std::memory_order_relaxed) ||
+            (n > 0 && time <= f.samples[(n - 1) % _buffer_size].loadTime())) {
+        return false;
+    }
+
+    uint64_t seq = f.seq.load(std::memory_order_relaxed);
+    f.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    f.samples[n % _buffer_size].store(time, pose);
+    f.count.store(n + 1, std::memory_order_relaxed);
+
+    f.seq.store(seq + 2, std::memory_order_release);
+    return true;
+}
+
+
+bool FrameTree::setStaticTransform(int id, const Pose &pose)
+{
+    assert(id >= 0 && id < static_cast<int>(_frames.size()));
+    Frame& f = *_frames[id];
+    if(f.parent < 0) {
+        return false;
+    }
+
+    uint64_t seq = f.seq.load(std::memory_order_relaxed);
+    f.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    f.samples[0].store(0, pose);
+    f.count.store(1, std::memory_order_relaxed);
+    f.is_static.store(true, std::memory_order_relaxed);
+
+    f.seq.store(seq + 2, std::memory_order_release);
+    return true;
+}
+
+
+uint64_t FrameTree::version(int id) const
+{
+    assert(id >= 0 && id < static_cast<int>(_frames.size()));
+    return _frames[id]->seq.load(std::memory_order_acquire);
+}
+
+
+bool FrameTree::lookup(int target, int source, double time, Pose &pose) const
+{
+    assert(target >= 0 && target < static_cast<int>(_frames.size()));
+    assert(source >= 0 && source < static_cast<int>(_frames.size()));
+    int ancestor = commonAncestor(target, source);
+    if(ancestor < 0) {
+        return false;
+    }
+
+    // target_T_source = (ancestor_T_target)^-1 * ancestor_T_source
+    Pose up, down;
+    if(!composeUp(target, ancestor, time, up) ||
+            !composeUp(source, ancestor, time, down)) {
+        return false;
+    }
+    pose = up.inverse() * down;
+    return true;
+}
+
+
+bool FrameTree::lookup(const std::string &target, const std::string &source,
+                       double time, Pose &pose) const
+{
+    int target_id = frameId(target), source_id = frameId(source);
+    if(target_id < 0 || source_id < 0) {
+        return false;
+    }
+    return lookup(target_id, source_id, time, pose);
+}
+
+
+int FrameTree::commonAncestor(int a, int b) const
+{
+    while(a >= 0 && b >= 0 && a != b) {
+        if(_frames[a]->depth >= _frames[b]->depth) {
+            a = _frames[a]->parent;
+        }
+        else {
+            b = _frames[b]->parent;
+        }
+    }
+    return a == b ? a : -1;
+}
+
+
+bool FrameTree::edgeTransform(int id, double time, Pose &pose,
+                              uint64_t *version) const
+{
+    const Frame& f = *_frames[id];
+    const uint64_t N = _buffer_size;
+    Sample s0, s1;
+    bool is_found = false;
+    uint64_t seq = 0;
+    for(;;) {
+        seq = f.seq.load(std::memory_order_acquire);
+        if(seq & 1) {
+            // The writer holds the edge for a few stores only
+            std::this_thread::yield();
+            continue;
+        }
+
+        uint64_t n = f.count.load(std::memory_order_relaxed);
+        uint64_t lo = n > N ? n - N : 0;
+        is_found = n > 0;
+        if(is_found) {
+            f.samples[(n - 1) % N].load(s1);
+            s0 = s1;
+        }
+        if(is_found && time != LATEST && !f.is_static.load(std::memory_order_relaxed)) {
+            if(time > s1.time || time < f.samples[lo % N].loadTime()) {
+                is_found = false;
+            }
+            else {
+                // The last sample k in [lo, n) with samples[k].time <= time
+                uint64_t first = lo, last = n - 1;
+                while(first < last) {
+                    uint64_t mid = first + (last - first + 1) / 2;
+                    if(f.samples[mid % N].loadTime() <= time) {
+                        first = mid;
+                    }
+                    else {
+                        last = mid - 1;
+                    }
+                }
+                f.samples[first % N].load(s0);
+                f.samples[std::min(first + 1, n - 1) % N].load(s1);
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(f.seq.load(std::memory_order_relaxed) == seq) {
+            break;
+        }
+    }
+
+    if(version) {
+        *version = seq;
+    }
+    if(is_found) {
+        pose = interpolate(s0, s1, time == LATEST ? s0.time : time);
+    }
+    return is_found;
+}
+
+
+bool FrameTree::composeUp(int id, int ancestor, double time, Pose &pose) const
+{
+    pose = Pose();
+    Pose edge;
+    for(; id != ancestor; id = _frames[id]->parent) {
+        if(!edgeTransform(id, time, edge)) {
+            return false;
+        }
+        pose = edge * pose;
+    }
+    return true;
+}
+
+
+FrameLookup::FrameLookup(const FrameTree &tree, int target, int source)
+    : _tree(tree)
+    , _is_valid(false)
+    , _is_cached(false)
+    , _time(0)
+{
+    int ancestor = tree.commonAncestor(target, source);
+    if(ancestor < 0) {
+        return;
+    }
+    for(int id = target; id != ancestor; id = tree.parent(id)) {
+        _up.push_back(id);
+    }
+    for(int id = source; id != ancestor; id = tree.parent(id)) {
+        _down.push_back(id);
+    }
+    _versions.resize(_up.size() + _down.size());
+    _is_valid = true;
+}
+
+
+bool FrameLookup::isValid() const
+{
+    return _is_valid;
+}
+
+
+bool FrameLookup::lookup(double time, Pose &pose)
+{
+    if(!_is_valid) {
+        return false;
+    }
+    if(_is_cached && time == _time) {
+        bool is_changed = false;
+        for(std::size_t i = 0; i < _up.size() && !is_changed; i++) {
+            is_changed = _tree.version(_up[i]) != _versions[i];
+        }
+        for(std::size_t i = 0; i < _down.size() && !is_changed; i++) {
+            is_changed = _tree.version(_down[i]) != _versions[_up.size() + i];
+        }
+        if(!is_changed) {
+            pose = _pose;
+            return true;
+        }
+    }
+
+    _is_cached = false;
+    Pose up, down, edge;
+    for(std::size_t i = 0; i < _up.size(); i++) {
+        if(!_tree.edgeTransform(_up[i], time, edge, &_versions[i])) {
+            return false;
+        }
+        up = edge * up;
+    }
+    for(std::size_t i = 0; i < _down.size(); i++) {
+        if(!_tree.edgeTransform(_down[i], time, edge,
+                                &_versions[_up.size() + i])) {
+            return false;
+        }
+        down = edge * down;
+    }
+    _pose = up.inverse() * down;
+    _time = time;
+    _is_cached = true;
+    pose = _pose;
+    return true;
+}
+
+} // mmath
@@ -0,0 +1,276 @@
+#include "../include/lib_math/kine/lie.h"
+#include "../include/lib_math/matrix/skew.h"
+#include <cmath>
+#include <limits>
+
+namespace mmath{
+
+namespace {
+/** 
+ * The threshold of theta^2 below which the coefficients of SO(3) are replaced
+ * by their Taylor series.
+ */
+template<typename Scalar>
+Scalar smallAngle2()
+{
+    return std::sqrt(std::numeric_limits<Scalar>::epsilon());
+}
+
+
+/** 
+ * The threshold of theta^2 for the coupling block Q of SE(3), whose 
+ * coefficients are divided by theta^4 and theta^5, thus larger.
+ */
+template<typename Scalar>
+Scalar smallAngle2Q()
+{
+    return 100 * std::cbrt(std::numeric_limits<Scalar>::epsilon());
+}
+
+
+/**
+ * The coefficients of SO(3) with theta2 = theta^2:
+ *   A = sin(theta) / theta
+ *   B = (1 - cos(theta)) / theta^2
+ *   C = (theta - sin(theta)) / theta^3
+ */
+template<typename Scalar>
+void calcCoeffs(Scalar theta2, Scalar &A, Scalar &B, Scalar &C)
+{
+    if(theta2 < smallAngle2<Scalar>()) {
+        A = 1 - theta2 / 6 * (1 - theta2 / 20);
+        B = Scalar(0.5) - theta2 / 24 * (1 - theta2 / 30);
+        C = Scalar(1) / 6 - theta2 / 120 * (1 - theta2 / 42);
+    }
+    else {
+        Scalar theta = std::sqrt(theta2);
+        Scalar s = std::sin(theta);
+        Scalar h = std::sin(theta / 2);
+        A = s / theta;
+        B = 2 * h * h / theta2;
+        C = (theta - s) / (theta2 * theta);
+    }
+}
+
+
+/**
+ * The coefficient D = (1 - A / (2 * B)) / theta^2 of the inverse Jacobian,
+ * where A / (2 * B) = h * cot(h) with h = theta / 2 is taken without
+ * "1 - cos(theta)", whose cancellation would leave D no correct digit in float
+ * right above the threshold of the series.
+ */
+template<typename Scalar>
+Scalar calcCoeffInv(Scalar theta2)
+{
+    if(theta2 < smallAngle2<Scalar>()) {
+        return Scalar(1) / 12 + theta2 / 720 * (1 + theta2 / 42);
+    }
+    Scalar h = std::sqrt(theta2) / 2;
+    return (1 - h * std::cos(h) / std::sin(h)) / theta2;
+}
+
+
+/** I + a * K + b * K^2, where K = phi^. */
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> polySO3(const Eigen::Vector<Scalar, 3> &phi,
+                                    Scalar a, Scalar b)
+{
+    Eigen::Matrix<Scalar, 3, 3> K = skewSymmetric<Scalar>(phi);
+    Eigen::Matrix<Scalar, 3, 3> ret = b * K * K;
+    ret += a * K;
+    ret.diagonal().array() += 1;
+    return ret;
+}
+
+
+/** The coupling block Q of the left Jacobian of SE(3). */
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> calcQ(const Eigen::Vector<Scalar, 6> &xi)
+{
+    using Mat3 = Eigen::Matrix<Scalar, 3, 3>;
+    Mat3 P = skewSymmetric<Scalar>(Eigen::Vector<Scalar, 3>(xi.template head<3>()));
+    Mat3 K = skewSymmetric<Scalar>(Eigen::Vector<Scalar, 3>(xi.template tail<3>()));
+    Scalar theta2 = xi.template tail<3>().squaredNorm();
+
+    Scalar c1, c2, c3, A, B;
+    if(theta2 < smallAngle2Q<Scalar>()) {
+        c1 = Scalar(1) / 6 - theta2 / 120 * (1 - theta2 / 42);
+        c2 = Scalar(1) / 24 - theta2 / 720 * (1 - theta2 / 56);
+        c3 = Scalar(1) / 120 - theta2 / 2520 * (1 - theta2 / 48);
+    }
+    else {
+        calcCoeffs(theta2, A, B, c1);
+        c2 = (Scalar(0.5) - B) / theta2;
+        c3 = (3 * (c1 - Scalar(1) / 6) - (B - Scalar(0.5))) / (2 * theta2);
+    }
+
+    Mat3 KP = K * P, PK = P * K, KPK = KP * K;
+    return Scalar(0.5) * P + c1 * (KP + PK + KPK)
+            + c2 * (K * KP + PK * K - 3 * KPK) + c3 * (KPK * K + K * KPK);
+}
+}
+
+
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> expSO3(const Eigen::Vector<Scalar, 3> &phi)
+{
+    Scalar A, B, C;
+    calcCoeffs(phi.squaredNorm(), A, B, C);
+    return polySO3(phi, A, B);
+}
+
+
+template<typename Scalar>
+Eigen::Vector<Scalar, 3> logSO3(const Eigen::Matrix<Scalar, 3, 3> &R)
+{
+    Eigen::Quaternion<Scalar> q(R);
+    if(q.w() < 0) {
+        q.coeffs() = -q.coeffs();
+    }
+    Scalar n2 = q.vec().squaredNorm();
+    Scalar w = q.w();
+
+    // phi = 2 * atan2(n, w) / n * v
+    Scalar k;
+    if(n2 < smallAngle2<Scalar>()) {
+        k = 2 / w * (1 - n2 / (3 * w * w));
+    }
+    else {
+        Scalar n = std::sqrt(n2);
+        k = 2 * std::atan2(n, w) / n;
+    }
+    return k * q.vec();
+}
+
+
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> leftJacobianSO3(const Eigen::Vector<Scalar, 3> &phi)
+{
+    Scalar A, B, C;
+    calcCoeffs(phi.squaredNorm(), A, B, C);
+    return polySO3(phi, B, C);
+}
+
+
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> leftJacobianInvSO3(
+        const Eigen::Vector<Scalar, 3> &phi)
+{
+    return polySO3(phi, Scalar(-0.5), calcCoeffInv(phi.squaredNorm()));
+}
+
+
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> rightJacobianSO3(
+        const Eigen::Vector<Scalar, 3> &phi)
+{
+    Scalar A, B, C;
+    calcCoeffs(phi.squaredNorm(), A, B, C);
+    return polySO3(phi, -B, C);
+}
+
+
+template<typename Scalar>
+Eigen::Matrix<Scalar, 3, 3> rightJacobianInvSO3(
+        const Eigen::Vector<Scalar, 3> &phi)
+{
+    return polySO3(phi, Scalar(0.5), calcCoeffInv(phi.squaredNorm()));
+}
+
+
+template<typename Scalar>
+PoseT<Scalar> expSE3(const Eigen::Vector<Scalar, 6> &xi)
+{
+    Eigen::Vector<Scalar, 3> phi = xi.template tail<3>();
+    Scalar A, B, C;
+    calcCoeffs(phi.squaredNorm(), A, B, C);
+
+    PoseT<Scalar> pose;
+    pose.R = polySO3(phi, A, B);
+    pose.t.noalias() = polySO3(phi, B, C) * xi.template head<3>();
+    return pose;
+}
+
+
+template<typename Scalar>
+Eigen::Vector<Scalar, 6> logSE3(const PoseT<Scalar> &pose)
+{
+    Eigen::Vector<Scalar, 6> xi;
+    Eigen::Vector<Scalar, 3> phi = logSO3(pose.R);
+    xi.template head<3>().noalias() = leftJacobianInvSO3(phi) * pose.t;
+    xi.template tail<3>() = phi;
+    return xi;
+}
+
+
+template<typename Scalar>
+Eigen::Matrix<Scalar, 6, 6> leftJacobianSE3(const Eigen::Vector<Scalar, 6> &xi)
+{
+    Eigen::Matrix<Scalar, 6, 6> J;
+    Eigen::Vector<Scalar, 3> phi = xi.template tail<3>();
+    J.template topLeftCorner<3, 3>() = leftJacobianSO3(phi);
+    J.template bottomRightCorner<3, 3>() = J.template topLeftCorner<3, 3>();
+    J.template topRightCorner<3, 3>() = calcQ(xi);
+    J.template bottomLeftCorner<3, 3>().setZero();
+    return J;
+}
+
+
+template<typename Scalar>
+Eigen::Matrix<Scalar, 6, 6> leftJacobianInvSE3(
+        const Eigen::Vector<Scalar, 6> &xi)
+{
+    Eigen::Matrix<Scalar, 6, 6> J;
+    Eigen::Vector<Scalar, 3> phi = xi.template tail<3>();
+    Eigen::Matrix<Scalar, 3, 3> Jinv = leftJacobianInvSO3(phi);
+    J.template topLeftCorner<3, 3>() = Jinv;
+    J.template bottomRightCorner<3, 3>() = Jinv;
+    J.template topRightCorner<3, 3>() = -Jinv * calcQ(xi) * Jinv;
+    J.template bottomLeftCorner<3, 3>().setZero();
+    return J;
+}
+
+
+template<typename Scalar>
+Eigen::Matrix<Scalar, 6, 6> rightJacobianSE3(
+        const Eigen::Vector<Scalar, 6> &xi)
+{
+    return leftJacobianSE3<Scalar>(-xi);
+}
+
+
+template<typename Scalar>
+Eigen::Matrix<Scalar, 6, 6> rightJacobianInvSE3(
+        const Eigen::Vector<Scalar, 6> &xi)
+{
+    return leftJacobianInvSE3<Scalar>(-xi);
+}
+
+
+/* Explicit instantiations for float and double */
+#define INSTANTIATE_LIE(T)                                                    \
+    template Eigen::Matrix<T, 3, 3> expSO3<T>(const Eigen::Vector<T, 3>&);    \
+    template Eigen::Vector<T, 3> logSO3<T>(const Eigen::Matrix<T, 3, 3>&);    \
+    template Eigen::Matrix<T, 3, 3> leftJacobianSO3<T>(                       \
+            const Eigen::Vector<T, 3>&);                                      \
+    template Eigen::Matrix<T, 3, 3> leftJacobianInvSO3<T>(                    \
+            const Eigen::Vector<T, 3>&);                                      \
+    template Eigen::Matrix<T, 3, 3> rightJacobianSO3<T>(                      \
+            const Eigen::Vector<T, 3>&);                                      \
+    template Eigen::Matrix<T, 3, 3> rightJacobianInvSO3<T>(                   \
+            const Eigen::Vector<T, 3>&);                                      \
+    template PoseT<T> expSE3<T>(const Eigen::Vector<T, 6>&);                  \
+    template Eigen::Vector<T, 6> logSE3<T>(const PoseT<T>&);                  \
+    template Eigen::Matrix<T, 6, 6> leftJacobianSE3<T>(                       \
+            const Eigen::Vector<T, 6>&);                                      \
+    template Eigen::Matrix<T, 6, 6> leftJacobianInvSE3<T>(                    \
+            const Eigen::Vector<T, 6>&);                                      \
+    template Eigen::Matrix<T, 6, 6> rightJacobianSE3<T>(                      \
+            const Eigen::Vector<T, 6>&);                                      \
+    template Eigen::Matrix<T, 6, 6> rightJacobianInvSE3<T>(                   \
+            const Eigen::Vector<T, 6>&);
+INSTANTIATE_LIE(float)
+INSTANTIATE_LIE(double)
+#undef INSTANTIATE_LIE
+
+} // mmath
@@ -1,9 +1,19 @@
 #include "../include/lib_math/kine/pose.h"
+#include "../include/lib_math/kine/lie.h"
+#include "../include/lib_math/kine/pose_chain.h"
+#include "../include/lib_math/util/format.h"
 #include <iomanip>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 namespace mmath{
 
-Pose& Pose::operator=(const Pose &pose)
+template<typename Scalar>
+PoseT<Scalar>& PoseT<Scalar>::operator=(const PoseT<Scalar> &pose)
 {
     this->R = pose.R;
     this->t = pose.t;
@@ -11,16 +21,18 @@ Pose& Pose::operator=(const Pose &pose)
 }
 
 
-Pose Pose::operator*(const Pose &pose) const
+template<typename Scalar>
+PoseT<Scalar> PoseT<Scalar>::operator*(const PoseT<Scalar> &pose) const
 {
-    Pose ret;
+    PoseT ret;
     ret.R = this->R * pose.R;
     ret.t = this->R * pose.t + this->t;
     return ret;
 }
 
 
-Pose& Pose::operator*=(const Pose &pose)
+template<typename Scalar>
+PoseT<Scalar>& PoseT<Scalar>::operator*=(const PoseT<Scalar> &pose)
 {
     this->t += this->R * pose.t;
     this->R *= pose.R;
@@ -28,15 +40,99 @@ Pose& Pose::operator*=(const Pose &pose)
 }
 
 
-Eigen::Vector<kfloat, 3> Pose::operator*(const Eigen::Vector<kfloat, 3>& p)
+template<typename Scalar>
+Eigen::Vector<Scalar, 3> PoseT<Scalar>::operator*(
+        const Eigen::Vector<Scalar, 3>& p) const
 {
-    Eigen::Vector<kfloat, 3> ret;
+    Eigen::Vector<Scalar, 3> ret;
     ret = this->R * p + this->t;
     return ret;
 }
 
 
-std::ostream& operator<<(std::ostream &os, const Pose &pose)
+namespace {
+/** The number of points transformed together in one block. */
+constexpr int TRANSFORM_BLOCK = 256;
+
+/** The minimum number of points for each thread. */
+constexpr Eigen::Index MIN_POINTS_PER_THREAD = 8192;
+
+
+/**
+ * Transform the points in [begin, end) block by block, which supports 
+ * src == dst since each block is computed into a local buffer first.
+ */
+template<typename Scalar, typename SrcType, typename DstType>
+void transformRange(const PoseT<Scalar>& pose, const SrcType& src, DstType& dst,
+                    Eigen::Index begin, Eigen::Index end, bool is_deterministic)
+{
+    if(is_deterministic) {
+        for(Eigen::Index i = begin; i < end; i++) {
+            dst.col(i) = pose * Eigen::Vector<Scalar, 3>(src.col(i));
+        }
+        return;
+    }
+
+    Eigen::Matrix<Scalar, 3, Eigen::Dynamic, 0, 3, TRANSFORM_BLOCK> block;
+    for(Eigen::Index i = begin; i < end; i += TRANSFORM_BLOCK) {
+        Eigen::Index n = std::min<Eigen::Index>(TRANSFORM_BLOCK, end - i);
+        block.resize(3, n);
+        block.noalias() = pose.R * src.middleCols(i, n);
+        dst.middleCols(i, n) = block.colwise() + pose.t;
+    }
+}
+
+
+/** Split [0, num) into contiguous ranges and transform them in threads. */
+template<typename Scalar, typename SrcType, typename DstType>
+void transformParallel(const PoseT<Scalar>& pose, const SrcType& src,
+                       DstType& dst, int thread_num, bool is_deterministic)
+{
+    const Eigen::Index num = src.cols();
+    thread_num = static_cast<int>(std::min<Eigen::Index>(
+                std::max(thread_num, 1), num / MIN_POINTS_PER_THREAD + 1));
+    if(thread_num == 1) {
+        transformRange(pose, src, dst, 0, num, is_deterministic);
+        return;
+    }
+
+    const Eigen::Index step = (num + thread_num - 1) / thread_num;
+    std::vector<std::thread> threads;
+    threads.reserve(thread_num - 1);
+    for(int k = 1; k < thread_num; k++) {
+        Eigen::Index begin = std::min(num, k * step);
+        Eigen::Index end = std::min(num, begin + step);
+        threads.emplace_back([&, begin, end]() {
+            transformRange(pose, src, dst, begin, end, is_deterministic);
+        });
+    }
+    transformRange(pose, src, dst, 0, std::min(num, step), is_deterministic);
+    for(auto& thread : threads) {
+        thread.join();
+    }
+}
+}
+
+
+template<typename Scalar>
+void PoseT<Scalar>::transform(ConstPointsRef src, PointsRef dst,
+                              int thread_num, bool is_deterministic) const
+{
+    assert(src.cols() == dst.cols());
+    transformParallel(*this, src, dst, thread_num, is_deterministic);
+}
+
+
+template<typename Scalar>
+void PoseT<Scalar>::transformInPlace(PointsRef pts, int thread_num,
+                                     bool is_deterministic) const
+{
+    transformParallel(*this, pts, pts, thread_num, is_deterministic);
+}
+
+
+template<typename Scalar>
+std::ostream& operator<<(std::ostream &os, const PoseT<Scalar> &pose)
 {
     int w = 12;
     for(uint8_t i = 0; i < 3; i++) {
@@ -50,62 +146,55 @@ std::ostream& operator<<(std::ostream &os, const Pose &pose)
 }
 
 
-Eigen::Quaternion<kfloat> Pose::q() const
+template<typename Scalar>
+Eigen::Quaternion<Scalar> PoseT<Scalar>::q() const
 {
-    return Eigen::Quaternion<kfloat>(R);
+    return Eigen::Quaternion<Scalar>(R);
 }
 
 
-Eigen::Matrix<kfloat, 4, 4> Pose::T() const
+template<typename Scalar>
+Eigen::Matrix<Scalar, 4, 4> PoseT<Scalar>::T() const
 {
-    Eigen::Matrix<kfloat, 4, 4> T = Eigen::Matrix<kfloat, 4, 4>::Identity();
+    Eigen::Matrix<Scalar, 4, 4> T = Eigen::Matrix<Scalar, 4, 4>::Identity();
     T.topLeftCorner(3, 3) = R;
     T.topRightCorner(3, 1) = t;
     return T;
 }
 
 
-Pose Pose::inverse() const
+template<typename Scalar>
+PoseT<Scalar> PoseT<Scalar>::inverse() const
 {
-    Pose pose;
+    PoseT pose;
     pose.R = this->R.transpose();
     pose.t = -this->R.transpose()*this->t;
     return pose;
 }
 
 
-bool Pose::isUnitOrthogonal() const
+template<typename Scalar>
+bool PoseT<Scalar>::isUnitOrthogonal() const
 {
-    Pose pose = this->inverse() * (*this);
-    auto& RR = pose.R;
-    auto& tt = pose.t;
-    
-    auto isEqual = [](float val1, float val2) -> bool {
-        return abs(val1 - val2) < 1e-5;
-    };
-    bool flag = 
-        isEqual(RR(0,0), 1) && isEqual(RR(1,1), 1) && isEqual(RR(2,2), 1)
-        && isEqual(RR(0,1), 0) && isEqual(RR(0,2), 0)
-        && isEqual(RR(1,0), 0) && isEqual(RR(1,2), 0) 
-        && isEqual(RR(2,0), 0) && isEqual(RR(2,1), 0)
-        && isEqual(tt[0], 0) && isEqual(tt[1], 0) && isEqual(tt[2], 0);
-        
-    return flag;
+    // The entries of R^T * R - I, without composing inverse() * (*this)
+    return orthogonalityError(R) < Scalar(1e-5);
 }
 
 
-void Pose::unitOrthogonalize()
+template<typename Scalar>
+void PoseT<Scalar>::unitOrthogonalize()
 {
-    Eigen::Quaternion<kfloat> q = this->q();
+    Eigen::Quaternion<Scalar> q = this->q();
     q.normalize();
     R = q.toRotationMatrix();
 }
 
 
-void Pose::increase(const Eigen::Quaternion<kfloat> &dq,
-                    const Eigen::Vector<kfloat, 3> &dt)
+template<typename Scalar>
+void PoseT<Scalar>::increase(const Eigen::Quaternion<Scalar> &dq,
+                             const Eigen::Vector<Scalar, 3> &dt)
 {
-    Eigen::Quaternion<kfloat> q = this->q();
+    Eigen::Quaternion<Scalar> q = this->q();
     q.coeffs() += dq.coeffs();
     q.normalize();
     R = q.toRotationMatrix();
@@ -113,10 +202,11 @@ void Pose::increase(const Eigen::Quaternion<kfloat> &dq,
 }
 
 
-void Pose::decrease(const Eigen::Quaternion<kfloat> &dq,
-                    const Eigen::Vector<kfloat, 3> &dt)
+template<typename Scalar>
+void PoseT<Scalar>::decrease(const Eigen::Quaternion<Scalar> &dq,
+                             const Eigen::Vector<Scalar, 3> &dt)
 {
-    Eigen::Quaternion<kfloat> q = this->q();
+    Eigen::Quaternion<Scalar> q = this->q();
     q.coeffs() -= dq.coeffs();
     q.normalize();
     R = q.toRotationMatrix();
@@ -124,14 +214,67 @@ void Pose::decrease(const Eigen::Quaternion<kfloat> &dq,
 }
 
 
-char* Pose::info() const
+template<typename Scalar>
+PoseT<Scalar> PoseT<Scalar>::boxplus(const Eigen::Vector<Scalar, 6> &xi) const
 {
-    static char tmp_cstr[200];
-    sprintf(tmp_cstr, "row-1st, R=[%f,%f,%f,%f,%f,%f,%f,%f,%f],t=[%f,%f,%f]",
-            R(0, 0), R(0, 1), R(0, 2),
-            R(1, 0), R(1, 1), R(1, 2),
-            R(2, 0), R(2, 1), R(2, 2), t[0], t[1], t[2]);
+    return (*this) * expSE3(xi);
+}
+
+
+template<typename Scalar>
+Eigen::Vector<Scalar, 6> PoseT<Scalar>::boxminus(const PoseT<Scalar> &pose) const
+{
+    return logSE3(pose.inverse() * (*this));
+}
+
+
+template<typename Scalar>
+char* PoseT<Scalar>::info() const
+{
+    thread_local char tmp_cstr[200];
+    info(tmp_cstr, sizeof(tmp_cstr));
     return tmp_cstr;
 }
 
+
+template<typename Scalar>
+int PoseT<Scalar>::info(char *buf, std::size_t size, int precision) const
+{
+    FormatWriter writer(buf, size);
+    writer.append("row-1st, R=[");
+    for(int i = 0; i < 9; i++) {
+        writer.append(R(i / 3, i % 3), precision).append(i < 8 ? "," : "]");
+    }
+    writer.append(",t=[");
+    for(int i = 0; i < 3; i++) {
+        writer.append(t[i], precision).append(i < 2 ? "," : "]");
+    }
+    return writer.length();
+}
+
+
+template<typename Scalar>
+std::size_t PoseT<Scalar>::toRecord(void *record) const
+{
+    std::memcpy(record, R.data(), 9 * sizeof(Scalar));
+    std::memcpy(static_cast<char*>(record) + 9 * sizeof(Scalar), t.data(),
+                3 * sizeof(Scalar));
+    return RECORD_SIZE;
+}
+
+
+template<typename Scalar>
+void PoseT<Scalar>::fromRecord(const void *record)
+{
+    std::memcpy(R.data(), record, 9 * sizeof(Scalar));
+    std::memcpy(t.data(), static_cast<const char*>(record) + 9 * sizeof(Scalar),
+                3 * sizeof(Scalar));
+}
+
+
+template class PoseT<float>;
+template class PoseT<double>;
+template std::ostream& operator<< (std::ostream&, const PoseT<float>&);
+template std::ostream& operator<< (std::ostream&, const PoseT<double>&);
+
 } // mmath
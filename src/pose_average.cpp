@@ -0,0 +1,190 @@
+#include "../include/lib_math/kine/pose_average.h"
+#include "../include/lib_math/kine/lie.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace mmath{
+
+namespace {
+/** The minimum number of poses for each thread. */
+constexpr std::size_t MIN_POSES_PER_THREAD = 4096;
+
+/** The minimum residual of the Weiszfeld weights. */
+constexpr double MIN_RESIDUAL = 1e-12;
+
+
+/** The partial sums of a range of poses. */
+struct Accumulator
+{
+    Eigen::Matrix4d M = Eigen::Matrix4d::Zero();       //!< sum(w * q * q^T)
+    Eigen::Vector3d t = Eigen::Vector3d::Zero();       //!< sum(w * t)
+    Eigen::Matrix<double, 6, 6> C = Eigen::Matrix<double, 6, 6>::Zero();
+    double w_r = 0;                                    //!< sum of weights of R
+    double w_t = 0;                                    //!< sum of weights of t
+
+    void add(const Accumulator &acc)
+    {
+        M += acc.M;
+        t += acc.t;
+        C += acc.C;
+        w_r += acc.w_r;
+        w_t += acc.w_t;
+    }
+};
+
+
+/** Return the robust weight of a residual. */
+double robustWeight(RobustLoss loss, double r, double delta)
+{
+    switch(loss) {
+    case RobustLoss::WEISZFELD:
+        return 1 / std::max(r, MIN_RESIDUAL);
+    case RobustLoss::HUBER:
+        return r <= delta ? 1 : delta / r;
+    default:
+        return 1;
+    }
+}
+
+
+/** Split [0, num) into contiguous ranges and reduce them in threads. */
+template<typename Func>
+Accumulator reduceParallel(std::size_t num, int thread_num, Func func)
+{
+    thread_num = static_cast<int>(std::min<std::size_t>(
+                std::max(thread_num, 1), num / MIN_POSES_PER_THREAD + 1));
+    std::vector<Accumulator> accs(thread_num);
+    const std::size_t step = (num + thread_num - 1) / thread_num;
+    std::vector<std::thread> threads;
+    threads.reserve(thread_num - 1);
+    for(int k = 1; k < thread_num; k++) {
+        std::size_t begin = std::min(num, k * step);
+        std::size_t end = std::min(num, begin + step);
+        threads.emplace_back([&, k, begin, end]() {
+            func(begin, end, accs[k]);
+        });
+    }
+    func(0, std::min(num, step), accs[0]);
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    // Sum in a fixed order, so the result only depends on thread_num
+    for(int k = 1; k < thread_num; k++) {
+        accs[0].add(accs[k]);
+    }
+    return accs[0];
+}
+
+
+/** The weighted sums of poses, weighted w.r.t. the mean if not nullptr. */
+template<typename Scalar>
+void accumulateRange(const PoseT<Scalar> *poses, std::size_t begin,
+                     std::size_t end, const Eigen::Quaterniond *q_mean,
+                     const Eigen::Vector3d *t_mean,
+                     const AverageOptions &options, Accumulator &acc)
+{
+    for(std::size_t i = begin; i < end; i++) {
+        Eigen::Quaterniond q(poses[i].R.template cast<double>());
+        Eigen::Vector3d t = poses[i].t.template cast<double>();
+        double w_r = 1, w_t = 1;
+        if(q_mean) {
+            double c = std::min(1.0, std::abs(q.dot(*q_mean)));
+            w_r = robustWeight(options.loss, 2 * std::acos(c),
+                               options.huber_rotation);
+            w_t = robustWeight(options.loss, (t - *t_mean).norm(),
+                               options.huber_translation);
+        }
+        acc.M.noalias() += w_r * q.coeffs() * q.coeffs().transpose();
+        acc.t += w_t * t;
+        acc.w_r += w_r;
+        acc.w_t += w_t;
+    }
+}
+
+
+/** The residuals [t_i - t; log(R^T * R_i)] multiplied by themselves. */
+template<typename Scalar>
+void covarianceRange(const PoseT<Scalar> *poses, std::size_t begin,
+                     std::size_t end, const Eigen::Matrix3d &R_mean,
+                     const Eigen::Vector3d &t_mean, Accumulator &acc)
+{
+    Eigen::Vector<double, 6> xi;
+    Eigen::Matrix3d dR;
+    for(std::size_t i = begin; i < end; i++) {
+        dR.noalias() = R_mean.transpose() * poses[i].R.template cast<double>();
+        xi.head<3>() = poses[i].t.template cast<double>() - t_mean;
+        xi.tail<3>() = logSO3(dR);
+        acc.C.noalias() += xi * xi.transpose();
+    }
+}
+
+
+/** The mean rotation of the sums. */
+Eigen::Quaterniond meanRotation(const Eigen::Matrix4d &M)
+{
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix4d> solver(M);
+    Eigen::Quaterniond q;
+    q.coeffs() = solver.eigenvectors().col(3);
+    return q.w() < 0 ? Eigen::Quaterniond(-q.coeffs()) : q;
+}
+}
+
+
+template<typename Scalar>
+PoseT<Scalar> averagePoses(const PoseT<Scalar> *poses, std::size_t num,
+        NonDeduced<Eigen::Matrix<Scalar, 6, 6>> *covariance,
+        const AverageOptions &options)
+{
+    assert(num > 0);
+    Eigen::Quaterniond q_mean;
+    Eigen::Vector3d t_mean;
+    auto reduce = [&](bool is_weighted) {
+        const Eigen::Quaterniond *q = is_weighted ? &q_mean : nullptr;
+        const Eigen::Vector3d *t = is_weighted ? &t_mean : nullptr;
+        Accumulator acc = reduceParallel(num, options.thread_num,
+                [&](std::size_t begin, std::size_t end, Accumulator &a) {
+            accumulateRange(poses, begin, end, q, t, options, a);
+        });
+        q_mean = meanRotation(acc.M);
+        t_mean = acc.t / acc.w_t;
+    };
+
+    reduce(false);
+    if(options.loss != RobustLoss::NONE) {
+        for(int k = 0; k < options.max_iteration; k++) {
+            Eigen::Quaterniond q_prev = q_mean;
+            Eigen::Vector3d t_prev = t_mean;
+            reduce(true);
+            if(q_prev.angularDistance(q_mean) <= options.tolerance &&
+                    (t_prev - t_mean).norm() <= options.tolerance) {
+                break;
+            }
+        }
+    }
+
+    PoseT<Scalar> mean;
+    Eigen::Matrix3d R_mean = q_mean.toRotationMatrix();
+    mean.R = R_mean.cast<Scalar>();
+    mean.t = t_mean.cast<Scalar>();
+    if(covariance) {
+        Accumulator acc = reduceParallel(num, options.thread_num,
+                [&](std::size_t begin, std::size_t end, Accumulator &a) {
+            covarianceRange(poses, begin, end, R_mean, t_mean, a);
+        });
+        *covariance = (acc.C / std::max<double>(1, num - 1)).cast<Scalar>();
+    }
+    return mean;
+}
+
+
+/* Explicit instantiations for float and double */
+template PoseT<float> averagePoses<float>(const PoseT<float>*, std::size_t,
+        Eigen::Matrix<float, 6, 6>*, const AverageOptions&);
+template PoseT<double> averagePoses<double>(const PoseT<double>*, std::size_t,
+        Eigen::Matrix<double, 6, 6>*, const AverageOptions&);
+
+} // mmath
@@ -0,0 +1,156 @@
+#include "../include/lib_math/kine/pose_chain.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mmath{
+
+namespace {
+/** The rounding error of a 3x3 product measured by orthogonalityError(). */
+template<typename Scalar>
+Scalar productError()
+{
+    return 8 * std::numeric_limits<Scalar>::epsilon();
+}
+
+
+/** The error above which the Gram-Schmidt process is applied first. */
+constexpr double NEWTON_MAX_ERROR = 0.1;
+}
+
+
+template<typename Scalar>
+Scalar orthogonalityError(const Eigen::Matrix<Scalar, 3, 3> &R)
+{
+    auto c0 = R.col(0), c1 = R.col(1), c2 = R.col(2);
+    Scalar e = std::abs(c0.squaredNorm() - 1);
+    e = std::max(e, std::abs(c1.squaredNorm() - 1));
+    e = std::max(e, std::abs(c2.squaredNorm() - 1));
+    e = std::max(e, std::abs(c0.dot(c1)));
+    e = std::max(e, std::abs(c0.dot(c2)));
+    e = std::max(e, std::abs(c1.dot(c2)));
+    return e;
+}
+
+
+template<typename Scalar>
+void orthonormalize(Eigen::Matrix<Scalar, 3, 3> &R, int iterations)
+{
+    if(orthogonalityError(R) > Scalar(NEWTON_MAX_ERROR)) {
+        R.col(0).normalize();
+        R.col(1) -= R.col(0).dot(R.col(1)) * R.col(0);
+        R.col(1).normalize();
+        R.col(2) = R.col(0).cross(R.col(1));
+    }
+
+    // R = R * (3I - R^T * R) / 2
+    Eigen::Matrix<Scalar, 3, 3> M;
+    for(int i = 0; i < iterations; i++) {
+        M.noalias() = Scalar(-0.5) * R.transpose() * R;
+        M.diagonal().array() += Scalar(1.5);
+        R = R * M;
+    }
+}
+
+
+template<typename Scalar>
+void orthonormalizeBatch(Scalar *R, std::size_t num, int iterations)
+{
+    for(std::size_t i = 0; i < num; i++) {
+        Eigen::Map<Eigen::Matrix<Scalar, 3, 3>> Ri(R + 9 * i);
+        Eigen::Matrix<Scalar, 3, 3> tmp = Ri;
+        orthonormalize(tmp, iterations);
+        Ri = tmp;
+    }
+}
+
+
+template<typename Scalar>
+void orthonormalizeBatch(PoseT<Scalar> *poses, std::size_t num, int iterations)
+{
+    for(std::size_t i = 0; i < num; i++) {
+        orthonormalize(poses[i].R, iterations);
+    }
+}
+
+
+template<typename Scalar>
+PoseChainT<Scalar>::PoseChainT(const PoseT<Scalar> &pose, Scalar threshold)
+    : _pose(pose)
+    , _threshold(threshold > 0 ? threshold
+                               : 1024 * std::numeric_limits<Scalar>::epsilon())
+    , _bound(0)
+    , _count(0)
+{}
+
+
+template<typename Scalar>
+void PoseChainT<Scalar>::reset(const PoseT<Scalar> &pose)
+{
+    _pose = pose;
+    _bound = 0;
+    _count = 0;
+}
+
+
+template<typename Scalar>
+void PoseChainT<Scalar>::multiply(const PoseT<Scalar> &pose, Scalar pose_error)
+{
+    _pose *= pose;
+    _bound += pose_error + _bound * pose_error + productError<Scalar>();
+    if(_bound > _threshold) {
+        reorthonormalize();
+    }
+}
+
+
+template<typename Scalar>
+PoseChainT<Scalar>& PoseChainT<Scalar>::operator*=(const PoseT<Scalar> &pose)
+{
+    multiply(pose);
+    return *this;
+}
+
+
+template<typename Scalar>
+void PoseChainT<Scalar>::reorthonormalize()
+{
+    orthonormalize(_pose.R);
+    _bound = productError<Scalar>();
+    _count++;
+}
+
+
+template<typename Scalar>
+const PoseT<Scalar>& PoseChainT<Scalar>::pose() const
+{
+    return _pose;
+}
+
+
+template<typename Scalar>
+Scalar PoseChainT<Scalar>::errorBound() const
+{
+    return _bound;
+}
+
+
+template<typename Scalar>
+std::size_t PoseChainT<Scalar>::reorthonormalizeCount() const
+{
+    return _count;
+}
+
+
+/* Explicit instantiations for float and double */
+#define INSTANTIATE_POSE_CHAIN(T)                                             \
+    template T orthogonalityError<T>(const Eigen::Matrix<T, 3, 3>&);          \
+    template void orthonormalize<T>(Eigen::Matrix<T, 3, 3>&, int);            \
+    template void orthonormalizeBatch<T>(T*, std::size_t, int);               \
+    template void orthonormalizeBatch<T>(PoseT<T>*, std::size_t, int);        \
+    template class PoseChainT<T>;
+INSTANTIATE_POSE_CHAIN(float)
+INSTANTIATE_POSE_CHAIN(double)
+#undef INSTANTIATE_POSE_CHAIN
+
+} // mmath
@@ -0,0 +1,248 @@
+#include "../include/lib_math/kine/pose_trajectory.h"
+#include "../include/lib_math/kine/lie.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace mmath{
+
+namespace {
+/** Return the rotation vector of q0^-1 * q1 along the shortest path. */
+template<typename Scalar>
+Eigen::Vector<Scalar, 3> relativeRotVec(const Eigen::Quaternion<Scalar> &q0,
+                                        const Eigen::Quaternion<Scalar> &q1)
+{
+    return logSO3(Eigen::Matrix<Scalar, 3, 3>(
+                      (q0.conjugate() * q1).toRotationMatrix()));
+}
+}
+
+
+template<typename Scalar>
+void PoseTrajectoryT<Scalar>::reserve(std::size_t num)
+{
+    _times.reserve(num);
+    _qs.reserve(num);
+    _ts.reserve(num);
+    _xis.reserve(num);
+    _ss.reserve(num);
+    _ms.reserve(num);
+}
+
+
+template<typename Scalar>
+void PoseTrajectoryT<Scalar>::clear()
+{
+    _times.clear();
+    _qs.clear();
+    _ts.clear();
+    _xis.clear();
+    _ss.clear();
+    _ms.clear();
+}
+
+
+template<typename Scalar>
+bool PoseTrajectoryT<Scalar>::push(double time, const PoseT<Scalar> &pose)
+{
+    if(!_times.empty() && time <= _times.back()) {
+        return false;
+    }
+
+    Quaternion q(pose.R);
+    if(!_qs.empty() && q.dot(_qs.back()) < 0) {
+        q.coeffs() = -q.coeffs();
+    }
+    _times.push_back(time);
+    _qs.push_back(q);
+    _ts.push_back(pose.t);
+    _ss.push_back(q);
+    _ms.push_back(Vector3::Zero());
+
+    std::size_t n = _times.size();
+    if(n >= 2) {
+        _xis.push_back(logSE3(this->pose(n - 2).inverse() * pose));
+        updateControl(n - 2);
+        updateControl(n - 1);
+    }
+    return true;
+}
+
+
+template<typename Scalar>
+std::size_t PoseTrajectoryT<Scalar>::size() const
+{
+    return _times.size();
+}
+
+
+template<typename Scalar>
+double PoseTrajectoryT<Scalar>::time(std::size_t i) const
+{
+    assert(i < _times.size());
+    return _times[i];
+}
+
+
+template<typename Scalar>
+PoseT<Scalar> PoseTrajectoryT<Scalar>::pose(std::size_t i) const
+{
+    assert(i < _times.size());
+    return PoseT<Scalar>(_qs[i].toRotationMatrix(), _ts[i]);
+}
+
+
+template<typename Scalar>
+double PoseTrajectoryT<Scalar>::startTime() const
+{
+    assert(!_times.empty());
+    return _times.front();
+}
+
+
+template<typename Scalar>
+double PoseTrajectoryT<Scalar>::endTime() const
+{
+    assert(!_times.empty());
+    return _times.back();
+}
+
+
+template<typename Scalar>
+std::size_t PoseTrajectoryT<Scalar>::findInterval(double time,
+                                                  std::size_t hint) const
+{
+    assert(_times.size() >= 2);
+    const std::size_t last = _times.size() - 2;
+    std::size_t i = std::min(hint, last);
+    if(time < _times[i]) {
+        auto it = std::upper_bound(_times.begin(), _times.begin() + i, time);
+        return it == _times.begin() ? 0 : (it - _times.begin()) - 1;
+    }
+    while(i < last && _times[i + 1] <= time) {
+        i++;
+    }
+    return i;
+}
+
+
+template<typename Scalar>
+PoseT<Scalar> PoseTrajectoryT<Scalar>::at(double time, InterpMode mode) const
+{
+    assert(!_times.empty());
+    if(_times.size() == 1) {
+        return pose(0);
+    }
+    return interpolate(findInterval(time), time, mode);
+}
+
+
+template<typename Scalar>
+void PoseTrajectoryT<Scalar>::resample(const double *times, std::size_t num,
+                                       PoseT<Scalar> *poses,
+                                       InterpMode mode) const
+{
+    assert(!_times.empty());
+    if(_times.size() == 1) {
+        std::fill(poses, poses + num, pose(0));
+        return;
+    }
+    std::size_t i = 0;
+    for(std::size_t k = 0; k < num; k++) {
+        i = findInterval(times[k], i);
+        poses[k] = interpolate(i, times[k], mode);
+    }
+}
+
+
+template<typename Scalar>
+void PoseTrajectoryT<Scalar>::resample(double start, double end, int num,
+                                       PoseT<Scalar> *poses,
+                                       InterpMode mode) const
+{
+    assert(!_times.empty() && num >= 1);
+    if(_times.size() == 1) {
+        std::fill(poses, poses + num, pose(0));
+        return;
+    }
+    const double step = num > 1 ? (end - start) / (num - 1) : 0;
+    std::size_t i = 0;
+    for(int k = 0; k < num; k++) {
+        double time = (k == num - 1 && num > 1) ? end : start + k * step;
+        i = findInterval(time, i);
+        poses[k] = interpolate(i, time, mode);
+    }
+}
+
+
+template<typename Scalar>
+void PoseTrajectoryT<Scalar>::resample(const std::vector<double> &times,
+                                       std::vector<PoseT<Scalar>> &poses,
+                                       InterpMode mode) const
+{
+    poses.resize(times.size());
+    resample(times.data(), times.size(), poses.data(), mode);
+}
+
+
+template<typename Scalar>
+PoseT<Scalar> PoseTrajectoryT<Scalar>::interpolate(std::size_t i, double time,
+                                                   InterpMode mode) const
+{
+    const double dt = _times[i + 1] - _times[i];
+    const Scalar h = static_cast<Scalar>(
+                std::clamp((time - _times[i]) / dt, 0.0, 1.0));
+
+    PoseT<Scalar> ret;
+    switch(mode) {
+    case InterpMode::SCLERP:
+        ret = pose(i) * expSE3(Vector6(h * _xis[i]));
+        break;
+    case InterpMode::CUBIC: {
+        // SQUAD: slerp(slerp(q0, q1, h), slerp(s0, s1, h), 2h(1-h))
+        Quaternion q = _qs[i].slerp(h, _qs[i + 1]);
+        Quaternion s = _ss[i].slerp(h, _ss[i + 1]);
+        ret.R = q.slerp(2 * h * (1 - h), s).toRotationMatrix();
+
+        // Cubic Hermite with the tangents scaled by the interval
+        Scalar h2 = h * h, h3 = h2 * h;
+        ret.t = (2 * h3 - 3 * h2 + 1) * _ts[i] + (-2 * h3 + 3 * h2) * _ts[i + 1]
+                + static_cast<Scalar>(dt) * ((h3 - 2 * h2 + h) * _ms[i]
+                                             + (h3 - h2) * _ms[i + 1]);
+        break;
+    }
+    default:
+        ret.R = _qs[i].slerp(h, _qs[i + 1]).toRotationMatrix();
+        ret.t = (1 - h) * _ts[i] + h * _ts[i + 1];
+        break;
+    }
+    return ret;
+}
+
+
+template<typename Scalar>
+void PoseTrajectoryT<Scalar>::updateControl(std::size_t i)
+{
+    const std::size_t n = _times.size();
+    std::size_t prev = i > 0 ? i - 1 : i;
+    std::size_t next = i + 1 < n ? i + 1 : i;
+    _ms[i] = (_ts[next] - _ts[prev]) /
+            static_cast<Scalar>(_times[next] - _times[prev]);
+
+    // s_i = q_i * exp(-(log(q_i^-1 q_i+1) + log(q_i^-1 q_i-1)) / 4)
+    if(prev == i || next == i) {
+        _ss[i] = _qs[i];
+    }
+    else {
+        Vector3 phi = relativeRotVec(_qs[i], _qs[next]) +
+                relativeRotVec(_qs[i], _qs[prev]);
+        _ss[i] = _qs[i] * Quaternion(expSO3(Vector3(-phi / 4)));
+    }
+}
+
+
+/* Explicit instantiations for float and double */
+template class PoseTrajectoryT<float>;
+template class PoseTrajectoryT<double>;
+
+} // mmath
@@ -0,0 +1,228 @@
+#include "../include/lib_math/kine/singularity_monitor.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace mmath{
+
+namespace {
+/** The Gram matrix in double with at most 6x6 values, never allocated. */
+using GramMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, 6, 6>;
+using GramVector = Eigen::Matrix<double, Eigen::Dynamic, 1, 0, 6, 1>;
+
+
+/** The eigenvalues of the Gram matrix, in increasing order. */
+void calcGramEigenvalues(const GramMatrix &A, GramVector &lambda)
+{
+    const Eigen::Index n = A.rows();
+    if(n == 1) {
+        lambda.resize(1);
+        lambda[0] = A(0, 0);
+    }
+    else if(n == 2) {
+        // The closed form of a symmetric 2x2 matrix
+        const double mean = (A(0, 0) + A(1, 1)) / 2;
+        const double half = (A(0, 0) - A(1, 1)) / 2;
+        const double radius = std::sqrt(half * half + A(0, 1) * A(0, 1));
+        lambda.resize(2);
+        lambda << mean - radius, mean + radius;
+    }
+    else if(n == 3) {
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+        solver.computeDirect(A.topLeftCorner<3, 3>(), Eigen::EigenvaluesOnly);
+        lambda = solver.eigenvalues();
+    }
+    else {
+        Eigen::SelfAdjointEigenSolver<GramMatrix> solver(
+                    A, Eigen::EigenvaluesOnly);
+        lambda = solver.eigenvalues();
+    }
+}
+}
+
+
+template<typename Scalar>
+SingularityMeasureT<Scalar> calcSingularityMeasure(
+        const Eigen::Ref<const Eigen::Matrix<Scalar, Eigen::Dynamic,
+        Eigen::Dynamic>> &J)
+{
+    const Eigen::Index n = std::min(J.rows(), J.cols());
+    assert(n >= 1 && n <= 6);
+
+    // The coefficient-based product needs no workspace of the GEMM kernel
+    const auto Jd = J.template cast<double>();
+    GramMatrix A(n, n);
+    if(J.rows() <= J.cols()) {
+        A = Jd.lazyProduct(Jd.transpose());
+    }
+    else {
+        A = Jd.transpose().lazyProduct(Jd);
+    }
+    GramVector lambda;
+    calcGramEigenvalues(A, lambda);
+
+    // The rounding may give tiny negative eigenvalues of a singular matrix
+    const double lambda_min = std::max(lambda[0], 0.0);
+    const double lambda_max = std::max(lambda[n - 1], 0.0);
+    double det = 1;
+    for(Eigen::Index i = 0; i < n; i++) {
+        det *= std::max(lambda[i], 0.0);
+    }
+    const double sigma_min = std::sqrt(lambda_min);
+    const double sigma_max = std::sqrt(lambda_max);
+    SingularityMeasureT<Scalar> measure;
+    measure.manipulability = static_cast<Scalar>(std::sqrt(det));
+    measure.sigma_min = static_cast<Scalar>(sigma_min);
+    measure.sigma_max = static_cast<Scalar>(sigma_max);
+    measure.condition = sigma_min > 0 ?
+                static_cast<Scalar>(sigma_max / sigma_min) :
+                std::numeric_limits<Scalar>::infinity();
+    return measure;
+}
+
+
+
+template<typename Scalar>
+SingularityMonitorT<Scalar>::SingularityMonitorT(std::size_t window)
+    : _samples(std::max<std::size_t>(window, 1))
+    , _next(0)
+    , _count(0)
+    , _flags(0)
+    , _min_manipulability(0)
+    , _min_sigma(0)
+    , _max_condition(0)
+    , _hysteresis(Scalar(0.1))
+{}
+
+
+template<typename Scalar>
+void SingularityMonitorT<Scalar>::setThresholds(
+        Scalar min_manipulability, Scalar min_sigma, Scalar max_condition,
+        Scalar hysteresis)
+{
+    assert(hysteresis >= 0);
+    _min_manipulability = min_manipulability;
+    _min_sigma = min_sigma;
+    _max_condition = max_condition;
+    _hysteresis = hysteresis;
+}
+
+
+template<typename Scalar>
+void SingularityMonitorT<Scalar>::setCallback(Callback callback)
+{
+    _callback = std::move(callback);
+}
+
+
+template<typename Scalar>
+uint32_t SingularityMonitorT<Scalar>::checkFlags(const Measure &measure) const
+{
+    // A set flag is released beyond the threshold scaled by the hysteresis
+    const Scalar k = 1 + _hysteresis;
+    uint32_t flags = 0;
+    Scalar threshold = (_flags & LOW_MANIPULABILITY) ?
+                _min_manipulability * k : _min_manipulability;
+    if(measure.manipulability < threshold) {
+        flags |= LOW_MANIPULABILITY;
+    }
+    threshold = (_flags & LOW_SIGMA_MIN) ? _min_sigma * k : _min_sigma;
+    if(measure.sigma_min < threshold) {
+        flags |= LOW_SIGMA_MIN;
+    }
+    threshold = (_flags & HIGH_CONDITION) ? _max_condition / k : _max_condition;
+    if(_max_condition > 0 && measure.condition > threshold) {
+        flags |= HIGH_CONDITION;
+    }
+    return flags;
+}
+
+
+template<typename Scalar>
+const typename SingularityMonitorT<Scalar>::Measure&
+SingularityMonitorT<Scalar>::update(
+        const Eigen::Ref<const Eigen::Matrix<Scalar, Eigen::Dynamic,
+        Eigen::Dynamic>> &J)
+{
+    _measure = calcSingularityMeasure<Scalar>(J);
+    _samples[_next] = _measure;
+    _next = (_next + 1) % _samples.size();
+    _count = std::min(_count + 1, _samples.size());
+
+    uint32_t flags = checkFlags(_measure);
+    if(flags != _flags) {
+        _flags = flags;
+        if(_callback) {
+            _callback(_measure, flags);
+        }
+    }
+    return _measure;
+}
+
+
+template<typename Scalar>
+const typename SingularityMonitorT<Scalar>::Measure&
+SingularityMonitorT<Scalar>::measure() const
+{
+    return _measure;
+}
+
+
+template<typename Scalar>
+uint32_t SingularityMonitorT<Scalar>::flags() const
+{
+    return _flags;
+}
+
+
+template<typename Scalar>
+typename SingularityMonitorT<Scalar>::Stats
+SingularityMonitorT<Scalar>::stats() const
+{
+    Stats stats;
+    stats.count = _count;
+    if(_count == 0) return stats;
+
+    // The samples are the latest _count slots before _next
+    const std::size_t size = _samples.size();
+    const std::size_t first = (_next + size - _count) % size;
+    double manipulability_sum = 0, sigma_min_sum = 0;
+    stats.manipulability_min = std::numeric_limits<Scalar>::infinity();
+    stats.sigma_min_min = std::numeric_limits<Scalar>::infinity();
+    for(std::size_t k = 0; k < _count; k++) {
+        const Measure& m = _samples[(first + k) % size];
+        manipulability_sum += m.manipulability;
+        sigma_min_sum += m.sigma_min;
+        stats.manipulability_min = std::min(stats.manipulability_min,
+                                            m.manipulability);
+        stats.sigma_min_min = std::min(stats.sigma_min_min, m.sigma_min);
+        stats.condition_max = std::max(stats.condition_max, m.condition);
+    }
+    stats.manipulability_mean = static_cast<Scalar>(manipulability_sum / _count);
+    stats.sigma_min_mean = static_cast<Scalar>(sigma_min_sum / _count);
+    return stats;
+}
+
+
+template<typename Scalar>
+void SingularityMonitorT<Scalar>::reset()
+{
+    _next = 0;
+    _count = 0;
+    _flags = 0;
+    _measure = Measure();
+}
+
+
+/* Explicit instantiations for float and double */
+template SingularityMeasureT<float> calcSingularityMeasure<float>(
+        const Eigen::Ref<const Eigen::Matrix<float, Eigen::Dynamic,
+        Eigen::Dynamic>>&);
+template SingularityMeasureT<double> calcSingularityMeasure<double>(
+        const Eigen::Ref<const Eigen::Matrix<double, Eigen::Dynamic,
+        Eigen::Dynamic>>&);
+template class SingularityMonitorT<float>;
+template class SingularityMonitorT<double>;
+
+} // mmath
@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+#include <vector>
+
+TEST_CASE("Test continuum actuation mapping", "[continuum]")
+{
+    using namespace mmath::continuum;
+    SegmentActuationT<double> actuation(4, 2.5, 0.3);
+    REQUIRE(actuation.backboneNum() == 4);
+    CHECK(actuation.backboneAngle(1) == Approx(0.3 + mmath::PI / 2));
+
+    // The lengths of the backbone inside the bend are shortened
+    std::vector<double> lengths(4);
+    actuation.calcLengths(ConfigSpcT<double>(0.8, 0.3, 30, true), lengths.data());
+    CHECK(lengths[0] == Approx(30 - 2.5 * 0.8));
+    CHECK(lengths[1] == Approx(30));
+    CHECK(lengths[2] == Approx(30 + 2.5 * 0.8));
+
+    // Round trip, where theta < 0 is the same as (-theta, delta + pi)
+    std::vector<ConfigSpcT<double>> qs = {
+        ConfigSpcT<double>(0.8, 0.3, 30, true),
+        ConfigSpcT<double>(1.9, -2.7, 25, true),
+        ConfigSpcT<double>(-0.6, 1.0, 20, true),
+        ConfigSpcT<double>(0.0, 0.0, 15, true),
+        ConfigSpcT<double>(0.0, 0.4, 10, false)
+    };
+    std::vector<double> batch(4 * qs.size());
+    std::vector<ConfigSpcT<double>> qs2(qs.size());
+    actuation.calcLengthsBatch(qs.data(), qs.size(), batch.data());
+    actuation.calcConfigBatch(batch.data(), qs.size(), qs2.data());
+    for(std::size_t k = 0; k < qs.size(); k++) {
+        mmath::PoseT<double> pose = calcSingleSegmentPose(qs[k]);
+        mmath::PoseT<double> pose2 = calcSingleSegmentPose(qs2[k]);
+        CHECK(qs2[k].is_bend);
+        CHECK(qs2[k].theta >= 0);
+        CHECK(qs2[k].length == Approx(qs[k].length));
+        CHECK((pose.t - pose2.t).norm() == Approx(0).margin(1e-12));
+        if(qs[k].is_bend) {
+            CHECK((pose.R - pose2.R).norm() == Approx(0).margin(1e-12));
+        }
+    }
+    CHECK(qs2[0].theta == Approx(0.8));
+    CHECK(qs2[0].delta == Approx(0.3));
+    CHECK(qs2[2].theta == Approx(0.6));
+    CHECK(qs2[2].delta == Approx(1.0 - mmath::PI));
+}
+
+
+TEST_CASE("Test continuum actuation Jacobian", "[continuum]")
+{
+    using namespace mmath::continuum;
+    SegmentActuationT<double> actuation(3, 4.0, -0.2);
+    const double Lr = 6, h = 1e-6;
+
+    for(double theta : {1.1, 0.2, 1e-4, 0.0}) {
+        ConfigSpcT<double> q(theta, 0.9, 35, true);
+
+        // The length Jacobian by central differences
+        Eigen::Matrix<double, Eigen::Dynamic, 3> Jl(3, 3), Jl0(3, 3);
+        actuation.calcLengthJacobian(q, Jl);
+        std::vector<double> lp(3), lm(3);
+        for(int j = 0; j < 3; j++) {
+            ConfigSpcT<double> qp = q, qm = q;
+            double *vp = j == 0 ? &qp.theta : j == 1 ? &qp.delta : &qp.length;
+            double *vm = j == 0 ? &qm.theta : j == 1 ? &qm.delta : &qm.length;
+            *vp += h;
+            *vm -= h;
+            actuation.calcLengths(qp, lp.data());
+            actuation.calcLengths(qm, lm.data());
+            for(int i = 0; i < 3; i++) {
+                Jl0(i, j) = (lp[i] - lm[i]) / (2 * h);
+            }
+        }
+        CHECK((Jl - Jl0).cwiseAbs().maxCoeff() == Approx(0).margin(1e-7));
+
+        // The actuation Jacobian by central differences of the lengths
+        Eigen::Matrix<double, 3, Eigen::Dynamic> Jv(3, 3), Jw(3, 3);
+        actuation.calcActuationJacobian(q, Lr, Jv, Jw);
+        std::vector<double> l(3);
+        actuation.calcLengths(q, l.data());
+        mmath::PoseT<double> pose = calcSingleWithRigidSegmentPose(
+                    actuation.calcConfig(l.data()), Lr);
+        for(int i = 0; i < 3; i++) {
+            lp = l;
+            lm = l;
+            lp[i] += h;
+            lm[i] -= h;
+            mmath::PoseT<double> pp = calcSingleWithRigidSegmentPose(
+                        actuation.calcConfig(lp.data()), Lr);
+            mmath::PoseT<double> pm = calcSingleWithRigidSegmentPose(
+                        actuation.calcConfig(lm.data()), Lr);
+            Eigen::Vector3d v = (pp.t - pm.t) / (2 * h);
+            Eigen::Matrix3d dR = (pp.R - pm.R) / (2 * h) * pose.R.transpose();
+            Eigen::Vector3d w(dR(2, 1), dR(0, 2), dR(1, 0));
+            CHECK((Jv.col(i) - v).norm() == Approx(0).margin(1e-6));
+            CHECK((Jw.col(i) - w).norm() == Approx(0).margin(1e-6));
+        }
+    }
+}
+
+
+TEST_CASE("Test continuum robot actuation Jacobian", "[continuum]")
+{
+    using namespace mmath::continuum;
+    std::vector<ConfigSpc> qs = {
+        ConfigSpc(0, 0.3, 10, false),
+        ConfigSpc(mmath::deg2rad(40), mmath::deg2rad(50), 30, true),
+        ConfigSpc(mmath::deg2rad(70), mmath::deg2rad(-20), 20, true)
+    };
+    std::vector<mmath::kfloat> Lrs = {0, 5, 10};
+    std::vector<SegmentActuation> actuations = {
+        SegmentActuation(3, 2), SegmentActuation(3, 2), SegmentActuation(4, 1.5)
+    };
+    ContinuumRobot robot(qs, Lrs, mmath::Pose(1.f, 2.f, 3.f));
+    REQUIRE(robot.actuationCols(actuations) == 10);
+
+    Eigen::Matrix<mmath::kfloat, 6, Eigen::Dynamic> J(6, 10), Jq(6, 9);
+    robot.calcActuationJacobian(actuations, J);
+    robot.calcJacobian(Jq, true);
+
+    // The chain Jacobian times the pseudo-inverse of each length Jacobian
+    Eigen::MatrixXd Jl = Eigen::MatrixXd::Zero(10, 9);
+    Eigen::Index row = 0;
+    for(std::size_t i = 0; i < qs.size(); i++) {
+        int n = actuations[i].backboneNum();
+        Eigen::Matrix<mmath::kfloat, Eigen::Dynamic, 3> Jli(n, 3);
+        actuations[i].calcLengthJacobian(qs[i], Jli);
+        Jl.block(row, 3 * i, n, 3) = Jli.cast<double>();
+        row += n;
+    }
+    // The rigid segment has only the length column
+    Eigen::MatrixXd dq = Eigen::MatrixXd::Zero(9, 10);
+    dq.row(2).head(3).setConstant(1.0 / 3);
+    dq.block(3, 3, 6, 7) = Jl.block(3, 3, 7, 6).completeOrthogonalDecomposition()
+            .pseudoInverse();
+    Eigen::MatrixXd J0 = Jq.cast<double>() * dq;
+    CHECK((J.cast<double>() - J0).cwiseAbs().maxCoeff() == Approx(0).margin(1e-4));
+}
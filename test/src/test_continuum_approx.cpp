@@ -0,0 +1,57 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+
+TEST_CASE("Test continuum approximation", "[continuum]")
+{
+    using namespace mmath::continuum;
+
+    SegmentApproxT<double> approx_d(-0.5, 2.5, 16, 7);
+    CHECK(approx_d.termError() < 1e-11);
+    SegmentApproxError error = approx_d.errorReport(64);
+    CHECK(error.theta_terms <= approx_d.termError() * 2);
+    CHECK(error.rotation < 1e-11);
+    CHECK(error.position < 1e-12);
+    CHECK(error.jacobian_v < 1e-12);
+    CHECK(error.jacobian_w < 1e-12);
+
+    SegmentApprox approx;
+    CHECK(approx.termError() < 1e-5);
+    error = approx.errorReport(64);
+    CHECK(error.rotation < 1e-5);
+    CHECK(error.position < 1e-5);
+    CHECK(error.jacobian_v < 1e-5);
+    CHECK(error.jacobian_w < 1e-5);
+
+    const double L = 30, Lr = 5;
+    for(double theta : {0.0, 0.3, 1.2, 2.4}) {
+        // The delta out of [-pi, pi] is wrapped
+        for(double delta : {-3.0, 0.7, 2 * mmath::PI + 0.7, -9.0}) {
+            mmath::PoseT<double> pose, pose0;
+            approx_d.calcSingleWithRigidSegmentPose(L, theta, delta, Lr, pose);
+            pose0 = calcSingleWithRigidSegmentPose<double>(L, theta, delta, Lr);
+            CHECK((pose.R - pose0.R).cwiseAbs().maxCoeff() == Approx(0).margin(1e-11));
+            CHECK((pose.t - pose0.t).cwiseAbs().maxCoeff() == Approx(0).margin(1e-9));
+
+            Eigen::Matrix<double, 3, 2> Jv, Jw, Jv0, Jw0;
+            approx_d.calcSingleSegmentJacobian(L, theta, delta, Jv, Jw);
+            calcSingleSegmentJacobian<double>(L, theta, delta, Jv0, Jw0);
+            CHECK((Jv - Jv0).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+            CHECK((Jw - Jw0).cwiseAbs().maxCoeff() == Approx(0).margin(1e-9));
+
+            mmath::PoseT<double> pose1;
+            Eigen::Matrix<double, 3, 2> Jv1, Jw1;
+            approx_d.calcSingleSegmentPose(L, theta, delta, pose);
+            approx_d.calcSingleSegmentPoseAndJacobian(L, theta, delta, pose1,
+                                                      Jv1, Jw1);
+            CHECK(pose1.R.isApprox(pose.R, 1e-14));
+            CHECK(pose1.t.isApprox(pose.t, 1e-14));
+            CHECK(Jv1.isApprox(Jv, 1e-14));
+            CHECK(Jw1.isApprox(Jw, 1e-14));
+        }
+    }
+
+    // The theta out of the table falls back to the exact terms
+    mmath::PoseT<double> pose;
+    approx_d.calcSingleSegmentPose(L, 3.0, 0.1, pose);
+    CHECK(pose.t.isApprox(calcSingleSegmentPose<double>(L, 3.0, 0.1).t, 1e-12));
+}
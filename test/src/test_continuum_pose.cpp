@@ -481,3 +481,288 @@ TEST_CASE("Test continuum Jacobian", "[continuum]")
     CHECK(Jw2(2, 0) == Approx(0).margin(1e-6));
     CHECK(Jw2(2, 1) == Approx(0.672816648889328).margin(1e-6));
 }
+
+
+TEST_CASE("Test continuum pose batch", "[continuum]")
+{
+    const int num = 100;
+    std::vector<mmath::kfloat> L(num), theta(num), delta(num), Lr(num);
+    for(int i = 0; i < num; i++) {
+        L[i] = 20 + 0.1*i;
+        theta[i] = i % 10 == 0 ? 0 : mmath::deg2rad(-90 + 1.8*i);
+        delta[i] = mmath::deg2rad(-180 + 3.6*i);
+        Lr[i] = 0.05*i;
+    }
+
+    std::vector<mmath::kfloat> R(9*num), t(3*num);
+    mmath::continuum::calcSingleSegmentPoseBatch(
+                L.data(), theta.data(), delta.data(), num, R.data(), t.data());
+    for(int i = 0; i < num; i++) {
+        mmath::Pose pose = mmath::continuum::calcSingleSegmentPose(
+                    L[i], theta[i], delta[i]);
+        Eigen::Map<Eigen::Matrix<mmath::kfloat, 3, 3>> Ri(R.data() + 9*i);
+        Eigen::Map<Eigen::Vector<mmath::kfloat, 3>> ti(t.data() + 3*i);
+        CHECK((Ri - pose.R).cwiseAbs().maxCoeff() == Approx(0).margin(1e-5));
+        CHECK((ti - pose.t).cwiseAbs().maxCoeff() == Approx(0).margin(1e-4));
+    }
+
+    mmath::continuum::calcSingleWithRigidSegmentPoseBatch(
+                L.data(), theta.data(), delta.data(), Lr.data(), num,
+                R.data(), t.data());
+    for(int i = 0; i < num; i++) {
+        mmath::Pose pose = mmath::continuum::calcSingleWithRigidSegmentPose(
+                    L[i], theta[i], delta[i], Lr[i]);
+        Eigen::Map<Eigen::Matrix<mmath::kfloat, 3, 3>> Ri(R.data() + 9*i);
+        Eigen::Map<Eigen::Vector<mmath::kfloat, 3>> ti(t.data() + 3*i);
+        CHECK((Ri - pose.R).cwiseAbs().maxCoeff() == Approx(0).margin(1e-5));
+        CHECK((ti - pose.t).cwiseAbs().maxCoeff() == Approx(0).margin(1e-4));
+    }
+}
+
+
+TEST_CASE("Test continuum branch-free theta terms", "[continuum]")
+{
+    using namespace mmath::continuum;
+
+    // The closed forms in long double are the reference away from zero
+    for(double theta : {-1.0, -0.3, 0.1, 0.499, 0.501, 1.0, 2.5}) {
+        long double th = theta, s = std::sin(th), c = std::cos(th);
+        SegmentThetaTerms<double> terms;
+        calcSegmentThetaTerms(theta, terms);
+        CHECK(terms.f1 == Approx(double((1 - c) / th)).epsilon(1e-12));
+        CHECK(terms.f1_theta == Approx(double((1 - c) / (th*th))).epsilon(1e-12));
+        CHECK(terms.f2 == Approx(double(s / th)).epsilon(1e-12));
+        CHECK(terms.df1 == Approx(double((th*s - 1 + c) / (th*th))).epsilon(1e-11));
+        CHECK(terms.df2 == Approx(double((th*c - s) / (th*th))).epsilon(1e-11));
+
+        SegmentThetaSecondTerms<double> terms2;
+        calcSegmentThetaSecondTerms(theta, terms, terms2);
+        CHECK(terms2.ddf1 == Approx(double(
+                (th*th*c - 2*th*s + 2*(1 - c)) / (th*th*th))).epsilon(1e-8));
+        CHECK(terms2.ddf2 == Approx(double(
+                (2*s - 2*th*c - th*th*s) / (th*th*th))).epsilon(1e-8));
+    }
+
+    // The terms are finite at zero, and the float terms keep the precision
+    for(double theta : {0.0, 1e-7, 1e-5, 1e-3, 0.2, 0.499, 0.501, 1.0}) {
+        SegmentThetaTerms<double> terms;
+        SegmentThetaTerms<float> termsf;
+        calcSegmentThetaTerms(theta, terms);
+        calcSegmentThetaTerms(float(theta), termsf);
+        CHECK(termsf.omc == Approx(terms.omc).epsilon(1e-6).margin(1e-30));
+        CHECK(termsf.f1 == Approx(terms.f1).epsilon(1e-6).margin(1e-30));
+        CHECK(termsf.f1_theta == Approx(terms.f1_theta).epsilon(1e-6));
+        CHECK(termsf.f2 == Approx(terms.f2).epsilon(1e-6));
+        CHECK(termsf.df1 == Approx(terms.df1).epsilon(1e-6));
+        CHECK(termsf.df2 == Approx(terms.df2).epsilon(1e-5).margin(1e-30));
+    }
+    SegmentThetaTerms<double> terms;
+    calcSegmentThetaTerms(0.0, terms);
+    CHECK(terms.f1 == 0);
+    CHECK(terms.f1_theta == 0.5);
+    CHECK(terms.f2 == 1);
+    CHECK(terms.df1 == 0.5);
+    CHECK(terms.df2 == 0);
+
+    // The rigid segment contributes to the derivatives at zero as well
+    const double L = 30, delta = 0.4, Lr = 5;
+    mmath::PoseT<double> d0 = dSingleWithRigidSegmentPose2theta<double>(
+                L, 0, delta, Lr);
+    mmath::PoseT<double> d1 = dSingleWithRigidSegmentPose2theta<double>(
+                L, 1e-9, delta, Lr);
+    CHECK((d0.t - d1.t).norm() == Approx(0).margin(1e-7));
+    Eigen::Matrix<double, 3, 2> Jv, Jw;
+    calcSingleWithRigidSegmentJacobian<double>(L, 0, delta, Lr, Jv, Jw);
+    CHECK((Jv.col(0) - d0.t).norm() == Approx(0).margin(1e-12));
+}
+
+
+TEST_CASE("Test continuum fused pose and Jacobian", "[continuum]")
+{
+    mmath::kfloat L = 30;
+    mmath::kfloat Lr = 10;
+    mmath::kfloat delta = mmath::deg2rad(50);
+    std::vector<mmath::kfloat> thetas = {
+        mmath::deg2rad<mmath::kfloat>(30), mmath::deg2rad<mmath::kfloat>(-75),
+        mmath::deg2rad<mmath::kfloat>(120)};
+
+    for(mmath::kfloat theta : thetas) {
+        mmath::Pose pose, dtheta, ddelta, dL;
+        Eigen::Matrix<mmath::kfloat, 3, 3> Jv, Jw, Jv0, Jw0;
+        mmath::continuum::calcVariableLengthWithRigidSegmentPoseAndJacobian(
+                    L, theta, delta, Lr, pose, Jv, Jw, &dtheta, &ddelta, &dL);
+        mmath::continuum::calcVariableLengthWithRigidSegmentJacobian(
+                    L, theta, delta, Lr, Jv0, Jw0);
+        mmath::Pose pose0 = mmath::continuum::calcSingleWithRigidSegmentPose(
+                    L, theta, delta, Lr);
+        CHECK((pose.R - pose0.R).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+        CHECK((pose.t - pose0.t).cwiseAbs().maxCoeff() == Approx(0).margin(1e-5));
+        CHECK((Jv - Jv0).cwiseAbs().maxCoeff() == Approx(0).margin(1e-5));
+        CHECK((Jw - Jw0).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+
+        mmath::Pose d0 = mmath::continuum::dSingleWithRigidSegmentPose2theta(
+                    L, theta, delta, Lr);
+        CHECK((dtheta.R - d0.R).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+        CHECK((dtheta.t - d0.t).cwiseAbs().maxCoeff() == Approx(0).margin(1e-5));
+        d0 = mmath::continuum::dSingleWithRigidSegmentPose2delta(
+                    L, theta, delta, Lr);
+        CHECK((ddelta.R - d0.R).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+        CHECK((ddelta.t - d0.t).cwiseAbs().maxCoeff() == Approx(0).margin(1e-5));
+        d0 = mmath::continuum::dSingleSegmentPose2L(L, theta, delta);
+        CHECK((dL.R - d0.R).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+        CHECK((dL.t - d0.t).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+
+        Eigen::Matrix<mmath::kfloat, 3, 2> Jv2, Jw2, Jv20, Jw20;
+        mmath::continuum::calcSingleSegmentPoseAndJacobian(
+                    L, theta, delta, pose, Jv2, Jw2);
+        mmath::continuum::calcSingleSegmentJacobian(L, theta, delta, Jv20, Jw20);
+        CHECK((Jv2 - Jv20).cwiseAbs().maxCoeff() == Approx(0).margin(1e-5));
+        CHECK((Jw2 - Jw20).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+    }
+
+    // The straight limit is consistent with calcSingleSegmentJacobian()
+    mmath::Pose pose, dtheta;
+    Eigen::Matrix<mmath::kfloat, 3, 2> Jv, Jw, Jv0, Jw0;
+    mmath::continuum::calcSingleSegmentPoseAndJacobian(
+                L, 0, delta, pose, Jv, Jw, &dtheta);
+    mmath::continuum::calcSingleSegmentJacobian(L, 0, delta, Jv0, Jw0);
+    CHECK((Jv - Jv0).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+    CHECK((Jw - Jw0).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+    CHECK((dtheta.t - Jv.col(0)).norm() == Approx(0).margin(1e-6));
+    CHECK(pose.t[2] == Approx(L).margin(1e-6));
+}
+
+
+TEST_CASE("Test continuum pose in float and double", "[continuum]")
+{
+    using namespace mmath::continuum;
+    double L = 30, theta = 0.7, delta = -1.2, Lr = 5;
+    ConfigSpcT<double> q(theta, delta, L, true);
+
+    mmath::PoseT<double> pose_d = calcSingleWithRigidSegmentPose(q, Lr);
+    mmath::PoseT<float> pose_f =
+            calcSingleWithRigidSegmentPose(q.cast<float>(), float(Lr));
+    CHECK(pose_d.cast<float>().R.isApprox(pose_f.R, 1e-5f));
+    CHECK(pose_d.cast<float>().t.isApprox(pose_f.t, 1e-5f));
+    CHECK((calcSingleSegmentPose<double>(L, theta, delta).t -
+           calcSingleSegmentPose(q).t).norm() == 0);
+
+    Eigen::Matrix<double, 3, 3> Jv_d, Jw_d;
+    Eigen::Matrix<float, 3, 3> Jv_f, Jw_f;
+    calcVariableLengthWithRigidSegmentJacobian(q, Lr, Jv_d, Jw_d);
+    calcVariableLengthWithRigidSegmentJacobian(q.cast<float>(), 5, Jv_f, Jw_f);
+    CHECK(Jv_d.cast<float>().isApprox(Jv_f, 1e-5f));
+    CHECK(Jw_d.cast<float>().isApprox(Jw_f, 1e-5f));
+
+    mmath::CameraProjectorT<double> cam_d(1000, 320, 240, 5);
+    mmath::CameraProjectorT<float> cam_f(1000, 320, 240, 5);
+    Eigen::Vector3d pt(1, 2, 100);
+    CHECK(cam_d.cvt3Dto2D(pt, mmath::cam::LEFT).cast<float>().isApprox(
+              cam_f.cvt3Dto2D(pt.cast<float>(), mmath::cam::LEFT)));
+}
+
+
+TEST_CASE("Test continuum pose Hessian", "[continuum]")
+{
+    using namespace mmath::continuum;
+    using PoseD = mmath::PoseT<double>;
+    const double L = 30, delta = 0.8, Lr = 5, h = 1e-4;
+
+    // The first derivatives in [theta, delta, L, Lr] by the fused kernel
+    auto calcDerivatives = [&](const double q[4], PoseD dpose[4]) {
+        PoseD pose;
+        Eigen::Matrix<double, 3, 3> Jv, Jw;
+        calcVariableLengthWithRigidSegmentPoseAndJacobian(
+                    q[2], q[0], q[1], q[3], pose, Jv, Jw,
+                    &dpose[0], &dpose[1], &dpose[2]);
+        dpose[3].R.setZero();
+        dpose[3].t = pose.R.col(2);
+    };
+
+    for(double theta : {0.9, -0.3, 0.05, 1e-3}) {
+        PoseD d2pose[4][4], pose, dpose[4], dpose0[4];
+        calcSingleWithRigidSegmentPoseHessian(L, theta, delta, Lr, d2pose,
+                                              &pose, dpose);
+        const double q[4] = {theta, delta, L, Lr};
+        calcDerivatives(q, dpose0);
+        CHECK(pose.R.isApprox(calcSingleWithRigidSegmentPose<double>(
+                                  L, theta, delta, Lr).R, 1e-12));
+        for(int i = 0; i < 4; i++) {
+            CHECK((dpose[i].R - dpose0[i].R).norm() == Approx(0).margin(1e-9));
+            CHECK((dpose[i].t - dpose0[i].t).norm() == Approx(0).margin(1e-6));
+        }
+
+        // The central differences of the first derivatives
+        for(int j = 0; j < 4; j++) {
+            double qp[4] = {theta, delta, L, Lr}, qm[4] = {theta, delta, L, Lr};
+            qp[j] += h;
+            qm[j] -= h;
+            PoseD dp[4], dm[4];
+            calcDerivatives(qp, dp);
+            calcDerivatives(qm, dm);
+            for(int i = 0; i < 4; i++) {
+                Eigen::Matrix3d dR = (dp[i].R - dm[i].R) / (2*h);
+                Eigen::Vector3d dt = (dp[i].t - dm[i].t) / (2*h);
+                CHECK((d2pose[i][j].R - dR).norm() == Approx(0).margin(1e-6));
+                CHECK((d2pose[i][j].t - dt).norm() == Approx(0).margin(1e-4));
+            }
+        }
+    }
+
+    // The straight limit, where d2t/dtheta2 = -L/3 and d2t/dthetadL = 1/2
+    mmath::PoseT<float> d2pose[3][3];
+    calcSingleSegmentPoseHessian<float>(30, 0, 0, d2pose);
+    CHECK(d2pose[0][0].t[2] == Approx(-10).margin(1e-5));
+    CHECK(d2pose[0][2].t[0] == Approx(0.5).margin(1e-6));
+    CHECK(d2pose[2][0].t[0] == Approx(0.5).margin(1e-6));
+
+    // The rigid segment only rotates by delta
+    ConfigSpcT<double> q(0, delta, L, false);
+    PoseD d2rigid[4][4], pose;
+    calcSingleWithRigidSegmentPoseHessian(q, Lr, d2rigid, &pose);
+    CHECK(d2rigid[1][1].R.topLeftCorner<2, 2>().isApprox(
+              -pose.R.topLeftCorner<2, 2>()));
+    CHECK(d2rigid[0][0].t.norm() == 0);
+}
+
+
+TEST_CASE("Test continuum pose on AD scalar", "[continuum]")
+{
+    using namespace mmath::continuum;
+    using AD = Eigen::AutoDiffScalar<Eigen::Vector<double, 1>>;
+
+    // The rotation kernels run on the AD scalar
+    AD angle(0.3, 1, 0);
+    Eigen::Matrix<AD, 3, 3> Rz = mmath::rotByZ<AD>(angle);
+    Eigen::Matrix3d dRz = mmath::dRotByZ<double>(0.3);
+    for(int r = 0; r < 3; r++) {
+        for(int c = 0; c < 3; c++) {
+            CHECK(Rz(r, c).value() == Approx(mmath::rotByZ<double>(0.3)(r, c)));
+            CHECK(Rz(r, c).derivatives()[0] == Approx(dRz(r, c)).margin(1e-12));
+        }
+    }
+
+    const double L = 30, delta = -1.2, Lr = 5;
+    for(double theta : {0.7, -0.2, 1e-4, 0.0}) {
+        Eigen::Matrix3d R;
+        Eigen::Vector3d t;
+        calcSingleWithRigidSegmentPoseGeneric(L, theta, delta, Lr, R, t);
+        mmath::PoseT<double> pose = calcSingleWithRigidSegmentPose<double>(
+                    L, theta, delta, Lr);
+        CHECK((R - pose.R).norm() == Approx(0).margin(1e-12));
+        CHECK((t - pose.t).norm() == Approx(0).margin(1e-9));
+
+        Eigen::Matrix3d Jv, Jw, Jv0, Jw0;
+        calcVariableLengthWithRigidSegmentJacobianAD(L, theta, delta, Lr, Jv, Jw);
+        calcVariableLengthWithRigidSegmentJacobian<double>(
+                    L, theta, delta, Lr, Jv0, Jw0);
+        CHECK((Jv - Jv0).norm() == Approx(0).margin(1e-6));
+        CHECK((Jw - Jw0).norm() == Approx(0).margin(1e-9));
+    }
+
+    Eigen::Matrix3f Jv, Jw, Jv0, Jw0;
+    calcVariableLengthWithRigidSegmentJacobianAD(30.f, 0.5f, 0.4f, 5.f, Jv, Jw);
+    calcVariableLengthWithRigidSegmentJacobian<float>(30, 0.5, 0.4, 5, Jv0, Jw0);
+    CHECK(Jv.isApprox(Jv0, 1e-5f));
+    CHECK(Jw.isApprox(Jw0, 1e-5f));
+}
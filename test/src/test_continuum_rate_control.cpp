@@ -0,0 +1,120 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+#include <cmath>
+
+TEST_CASE("Test continuum resolved-rate controller", "[continuum]")
+{
+    using namespace mmath::continuum;
+    const double Lr = 8;
+    ConfigSpcT<double> q(0.7, 0.4, 30, true);
+
+    // A feasible twist is resolved back into its rates
+    for(bool is_variable_length : {false, true}) {
+        ResolvedRateControllerT<double> controller(Lr, is_variable_length);
+        Eigen::Matrix<double, 3, 3> Jv, Jw;
+        calcVariableLengthWithRigidSegmentJacobian(q, Lr, Jv, Jw);
+        Eigen::Vector3d dq0(0.2, -0.3, is_variable_length ? 1.5 : 0);
+        Eigen::Matrix<double, 6, 1> twist;
+        twist << Jv * dq0, Jw * dq0;
+
+        ConfigSpcT<double> rate;
+        controller.calcRate(q, twist, 0, rate);
+        CHECK(controller.damping() == 0);
+        CHECK(controller.saturation() == 1);
+        CHECK(rate.is_bend);
+        CHECK(rate.theta == Approx(dq0[0]).epsilon(1e-10));
+        CHECK(rate.delta == Approx(dq0[1]).epsilon(1e-10));
+        CHECK(rate.length == Approx(dq0[2]).margin(1e-10));
+    }
+
+    // The saturation scales all the rates and keeps the direction
+    ResolvedRateControllerT<double> controller(Lr, true);
+    controller.setRateLimits(0.1, 0.1, 1.0);
+    Eigen::Matrix<double, 3, 3> Jv, Jw;
+    calcVariableLengthWithRigidSegmentJacobian(q, Lr, Jv, Jw);
+    Eigen::Vector3d dq0(0.2, -0.6, 1.5);
+    Eigen::Matrix<double, 6, 1> twist;
+    twist << Jv * dq0, Jw * dq0;
+    ConfigSpcT<double> rate;
+    controller.calcRate(q, twist, 0, rate);
+    CHECK(controller.saturation() == Approx(0.1 / 0.6));
+    CHECK(std::abs(rate.delta) == Approx(0.1));
+    CHECK(std::abs(rate.theta) <= 0.1 + 1e-12);
+    CHECK(rate.length <= 1.0 + 1e-12);
+    CHECK(rate.theta / rate.delta == Approx(dq0[0] / dq0[1]));
+    CHECK(rate.length / rate.delta == Approx(dq0[2] / dq0[1]));
+
+    // The joint limit stops the bending angle at the limit
+    controller.setRateLimits(0, 0, 0);
+    controller.setJointLimits(-1, 0.71, 10, 40);
+    ConfigSpcT<double> q1 = q;
+    controller.step(q1, twist, 0.1);
+    CHECK(q1.theta == Approx(0.71));
+}
+
+
+TEST_CASE("Test continuum resolved-rate controller at singularity", "[continuum]")
+{
+    using namespace mmath::continuum;
+    ResolvedRateControllerT<double> controller(5, false);
+    controller.setDamping(0.1, 0.5);
+    controller.setRateLimits(1, 2);
+
+    // The delta column vanishes for a straight segment, the rates are bounded
+    Eigen::Matrix<double, 6, 1> twist;
+    twist << 3, -2, 0, 0.1, 0.2, 0;
+    ConfigSpcT<double> rate;
+    controller.calcRate(ConfigSpcT<double>(0, 0.3, 20, true), twist, 0, rate);
+    CHECK(controller.measure().sigma_min == Approx(0).margin(1e-12));
+    CHECK(controller.damping() == Approx(0.1));
+    CHECK(std::isfinite(rate.theta));
+    CHECK(std::isfinite(rate.delta));
+    CHECK(std::abs(rate.theta) <= 1 + 1e-12);
+    CHECK(std::abs(rate.delta) <= 2 + 1e-12);
+
+    // The float damping near a straight segment follows the true sigma_min
+    for(float theta : {1e-3f, 3e-4f, 1e-4f}) {
+        ConfigSpcT<float> qf(theta, 0.7f, 30, true);
+        Eigen::Matrix<double, 3, 3> Jv, Jw;
+        calcVariableLengthWithRigidSegmentJacobian(
+                    ConfigSpcT<double>(theta, 0.7f, 30, true), 5.0, Jv, Jw);
+        Eigen::Matrix<double, 6, 3> J;
+        J << Jv, Jw;
+        const double sigma_min = Eigen::JacobiSVD<Eigen::MatrixXd>(J)
+                .singularValues()[2];
+        ResolvedRateControllerT<float> controllerf(5, true);
+        ConfigSpcT<float> ratef;
+        Eigen::Matrix<float, 6, 1> twistf = Eigen::Matrix<float, 6, 1>::Zero();
+        controllerf.setDamping(0.1f, float(0.5 * sigma_min));
+        controllerf.calcRate(qf, twistf, 0, ratef);
+        CHECK(controllerf.measure().sigma_min == Approx(sigma_min).epsilon(1e-3));
+        CHECK(controllerf.damping() == 0);
+        controllerf.setDamping(0.1f, float(2 * sigma_min));
+        controllerf.calcRate(qf, twistf, 0, ratef);
+        CHECK(controllerf.damping() == Approx(0.1 * std::sqrt(0.75)).epsilon(1e-3));
+    }
+
+    // A rigid segment has no rates of the bending
+    controller.calcRate(ConfigSpcT<double>(0, 0, 20, false), twist, 0, rate);
+    CHECK(!rate.is_bend);
+    CHECK(rate.theta == 0);
+    CHECK(rate.delta == 0);
+
+    // Tracking a position through theta = 0 converges in a 1 kHz loop
+    ResolvedRateController tracker(5, true);
+    tracker.setOrientationWeight(0);
+    tracker.setRateLimits(2, 10, 50);
+    using Vector3 = Eigen::Vector<mmath::kfloat, 3>;
+    ConfigSpc q(mmath::deg2rad(30.f), mmath::deg2rad(10.f), 20, true);
+    const Vector3 target = calcSingleWithRigidSegmentPose(
+                ConfigSpc(mmath::deg2rad(40.f), mmath::deg2rad(190.f), 24, true),
+                5).t;
+    for(int k = 0; k < 5000; k++) {
+        Vector3 p = calcSingleWithRigidSegmentPose(q, 5).t;
+        Eigen::Vector<mmath::kfloat, 6> v;
+        v << 10 * (target - p), 0, 0, 0;
+        tracker.step(q, v, 1e-3f);
+    }
+    CHECK((calcSingleWithRigidSegmentPose(q, 5).t - target).norm() ==
+          Approx(0).margin(1e-3));
+}
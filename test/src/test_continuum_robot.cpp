@@ -0,0 +1,211 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Test continuum robot forward kinematics", "[continuum]")
+{
+    std::vector<mmath::continuum::ConfigSpc> qs = {
+        mmath::continuum::ConfigSpc(0, 0, 10, false),
+        mmath::continuum::ConfigSpc(mmath::deg2rad(30), mmath::deg2rad(50), 30, true),
+        mmath::continuum::ConfigSpc(mmath::deg2rad(60), mmath::deg2rad(-20), 20, true)
+    };
+    std::vector<mmath::kfloat> Lrs = {0, 5, 10};
+    mmath::Pose base(1.f, 2.f, 3.f);
+    mmath::continuum::ContinuumRobot robot(qs, Lrs, base);
+
+    REQUIRE(robot.segmentNum() == 3);
+    REQUIRE(robot.frames().size() == 4);
+
+    mmath::Pose pose = base;
+    for(size_t i = 0; i < qs.size(); i++) {
+        pose *= mmath::continuum::calcSingleWithRigidSegmentPose(qs[i], Lrs[i]);
+        const mmath::Pose& frame = robot.frame(i + 1);
+        CHECK((frame.R - pose.R).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+        CHECK((frame.t - pose.t).cwiseAbs().maxCoeff() == Approx(0).margin(1e-5));
+    }
+    CHECK((robot.endPose().t - pose.t).norm() == Approx(0).margin(1e-5));
+
+    qs[1].theta = mmath::deg2rad(45);
+    robot.setConfig(1, qs[1]);
+    robot.calcForwardKinematics();
+    pose = base;
+    for(size_t i = 0; i < qs.size(); i++) {
+        pose *= mmath::continuum::calcSingleWithRigidSegmentPose(qs[i], Lrs[i]);
+    }
+    CHECK((robot.endPose().R - pose.R).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+    CHECK((robot.endPose().t - pose.t).cwiseAbs().maxCoeff() == Approx(0).margin(1e-5));
+}
+
+
+TEST_CASE("Test continuum robot incremental update", "[continuum]")
+{
+    std::vector<mmath::continuum::ConfigSpc> qs;
+    std::vector<mmath::kfloat> Lrs;
+    for(int i = 0; i < 5; i++) {
+        qs.emplace_back(mmath::deg2rad(10 + 10*i), mmath::deg2rad(-30 + 25*i),
+                        15 + i, true);
+        Lrs.push_back(i);
+    }
+    mmath::continuum::ContinuumRobot robot(qs, Lrs);
+    robot.enableJacobianCache();
+    REQUIRE(robot.isJacobianCacheEnabled());
+
+    for(int k = 0; k < 10; k++) {
+        size_t i = (k * 3) % qs.size();
+        qs[i].theta += mmath::deg2rad(2);
+        qs[(i + 1) % qs.size()].delta -= mmath::deg2rad(3);
+        robot.setConfig(qs);
+        if(k == 5) {
+            robot.setRigidLength(2, 7);
+            Lrs[2] = 7;
+        }
+        robot.calcForwardKinematics();
+
+        mmath::Pose pose;
+        for(size_t j = 0; j < qs.size(); j++) {
+            pose *= mmath::continuum::calcSingleWithRigidSegmentPose(qs[j], Lrs[j]);
+            const mmath::Pose& frame = robot.frame(j + 1);
+            CHECK((frame.R - pose.R).cwiseAbs().maxCoeff() == Approx(0).margin(1e-5));
+            CHECK((frame.t - pose.t).cwiseAbs().maxCoeff() == Approx(0).margin(1e-4));
+
+            Eigen::Matrix<mmath::kfloat, 3, 3> Jv, Jw;
+            mmath::continuum::calcVariableLengthWithRigidSegmentJacobian(
+                        qs[j], Lrs[j], Jv, Jw);
+            CHECK((robot.segmentJv(j) - Jv).cwiseAbs().maxCoeff() == Approx(0).margin(1e-5));
+            CHECK((robot.segmentJw(j) - Jw).cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+        }
+    }
+}
+
+
+TEST_CASE("Test continuum robot Jacobian", "[continuum]")
+{
+    std::vector<mmath::continuum::ConfigSpc> qs = {
+        mmath::continuum::ConfigSpc(mmath::deg2rad(40), mmath::deg2rad(20), 25, true),
+        mmath::continuum::ConfigSpc(mmath::deg2rad(70), mmath::deg2rad(-60), 20, true),
+        mmath::continuum::ConfigSpc(mmath::deg2rad(35), mmath::deg2rad(110), 15, true)
+    };
+    std::vector<mmath::kfloat> Lrs = {2, 4, 8};
+    mmath::continuum::ContinuumRobot robot(qs, Lrs);
+
+    for(bool is_variable_length : {false, true}) {
+        int per = is_variable_length ? 3 : 2;
+        mmath::continuum::ChainJacobian<9> J;
+        J.resize(6, robot.jacobianCols(is_variable_length));
+        robot.calcJacobian(J, is_variable_length);
+
+        // Compare with central differences of the end pose
+        const mmath::kfloat h = 1e-3;
+        for(size_t i = 0; i < qs.size(); i++) {
+            for(int k = 0; k < per; k++) {
+                auto perturbed = [&](mmath::kfloat dq) {
+                    std::vector<mmath::continuum::ConfigSpc> qq = qs;
+                    mmath::kfloat& v = k == 0 ? qq[i].theta :
+                                       k == 1 ? qq[i].delta : qq[i].length;
+                    v += dq;
+                    robot.setConfig(qq);
+                    robot.calcForwardKinematics();
+                    return robot.endPose();
+                };
+                mmath::Pose p1 = perturbed(h);
+                mmath::Pose p0 = perturbed(-h);
+                robot.setConfig(qs);
+                robot.calcForwardKinematics();
+
+                Eigen::Vector<mmath::kfloat, 3> v = (p1.t - p0.t) / (2*h);
+                Eigen::Matrix<mmath::kfloat, 3, 3> dR =
+                        (p1.R - p0.R) / (2*h) * robot.endPose().R.transpose();
+                Eigen::Vector<mmath::kfloat, 3> w(dR(2, 1), dR(0, 2), dR(1, 0));
+
+                int c = i * per + k;
+                CHECK((J.col(c).head<3>() - v).norm() == Approx(0).margin(1e-2));
+                CHECK((J.col(c).tail<3>() - w).norm() == Approx(0).margin(1e-3));
+            }
+        }
+
+        robot.enableJacobianCache(is_variable_length);
+    }
+}
+
+
+TEST_CASE("Test continuum robot inverse kinematics", "[continuum]")
+{
+    std::vector<mmath::continuum::ConfigSpc> qs = {
+        mmath::continuum::ConfigSpc(mmath::deg2rad(40), mmath::deg2rad(20), 25, true),
+        mmath::continuum::ConfigSpc(mmath::deg2rad(70), mmath::deg2rad(-60), 20, true)
+    };
+    std::vector<mmath::kfloat> Lrs = {2, 5};
+    mmath::continuum::ContinuumRobot robot(qs, Lrs);
+    mmath::Pose target = robot.endPose();
+
+    // Warm start from a nearby configuration
+    std::vector<mmath::continuum::ConfigSpc> q0 = qs;
+    q0[0].theta += mmath::deg2rad(8);
+    q0[1].delta -= mmath::deg2rad(10);
+    q0[1].length += 1;
+    robot.setConfig(q0);
+
+    mmath::continuum::ContinuumIkSolver solver(robot, true);
+    solver.setTolerance(1e-3, 1e-3);
+    solver.setBudget(100);
+    for(size_t i = 0; i < qs.size(); i++) {
+        solver.setLimits(i, 0, mmath::PI / 2, 10, 30);
+    }
+    mmath::continuum::IkStatus status = solver.solve(target);
+    REQUIRE(status == mmath::continuum::IkStatus::CONVERGED);
+    CHECK(solver.positionError() <= 1e-3);
+    CHECK(solver.orientationError() <= 1e-3);
+    CHECK((robot.endPose().t - target.t).norm() == Approx(0).margin(1e-3));
+
+    // A converged solution is returned immediately
+    status = solver.solve(target);
+    CHECK(status == mmath::continuum::IkStatus::CONVERGED);
+    CHECK(solver.iterations() == 0);
+
+    // The limits are respected for an unreachable target
+    mmath::Pose far = target;
+    far.t *= 10;
+    solver.setBudget(20);
+    status = solver.solve(far);
+    CHECK(status != mmath::continuum::IkStatus::CONVERGED);
+    for(size_t i = 0; i < qs.size(); i++) {
+        CHECK(robot.config(i).theta >= 0);
+        CHECK(robot.config(i).theta <= mmath::PI / 2);
+        CHECK(robot.config(i).length >= 10);
+        CHECK(robot.config(i).length <= 30);
+    }
+}
+
+
+TEST_CASE("Test continuum robot inverse kinematics of position", "[continuum]")
+{
+    using namespace mmath::continuum;
+    std::vector<ConfigSpc> qs = {
+        ConfigSpc(mmath::deg2rad(40), mmath::deg2rad(20), 25, true),
+        ConfigSpc(mmath::deg2rad(70), mmath::deg2rad(-60), 20, true)
+    };
+    ContinuumRobot robot(qs, std::vector<mmath::kfloat>{2, 5});
+    mmath::Pose target = robot.endPose();
+    target.t += Eigen::Vector<mmath::kfloat, 3>(2, -1, 1);
+
+    // A zero weight solves the position only
+    ContinuumIkSolver solver(robot, true);
+    CHECK(solver.isValid());
+    CHECK(!solver.setOrientationWeight(-1));
+    REQUIRE(solver.setOrientationWeight(0));
+    solver.setTolerance(1e-3, 1e-3);
+    IkStatus status = solver.solve(target);
+    REQUIRE(status == IkStatus::CONVERGED);
+    CHECK(std::isfinite(solver.orientationError()));
+    CHECK((robot.endPose().t - target.t).norm() == Approx(0).margin(1e-3));
+
+    // A chain beyond MAX_DOF is rejected without touching the robot
+    std::vector<ConfigSpc> qs7(7, ConfigSpc(mmath::deg2rad(10), 0, 10, true));
+    ContinuumRobot robot7(qs7, std::vector<mmath::kfloat>(7, 0));
+    ContinuumIkSolver solver7(robot7, true);
+    CHECK(!solver7.isValid());
+    CHECK(solver7.solve(robot7.endPose()) == IkStatus::INVALID);
+    CHECK(robot7.config(6).theta == Approx(mmath::deg2rad(10)));
+    CHECK(ContinuumIkSolver(robot7, false).isValid());
+}
@@ -0,0 +1,44 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+#include <cstdio>
+
+using namespace mmath::continuum;
+
+TEST_CASE("Test continuum trajectory", "[continuum]")
+{
+    const char* filename = "test_continuum_trajectory.bin";
+    std::vector<ConfigSpc> qs = {ConfigSpc(0.5, 0.1, 20, true),
+                                 ConfigSpc(0, 0, 5, false)};
+    ContinuumRobot robot(qs);
+    {
+        TrajectoryWriter writer(filename, qs.size());
+        REQUIRE(writer.isOpen());
+        for(int i = 0; i < 100; i++) {
+            qs[0].theta = 0.01f * i;
+            robot.setConfig(qs);
+            robot.calcForwardKinematics();
+            REQUIRE(writer.write(0.001 * i, qs, robot.endPose()));
+        }
+        CHECK(writer.recordNum() == 100);
+    }
+
+    TrajectoryReader reader(filename);
+    REQUIRE(reader.isOpen());
+    CHECK(reader.segmentNum() == 2);
+    REQUIRE(reader.recordNum() == 100);
+    for(std::size_t i = 0; i < reader.recordNum(); i++) {
+        qs[0].theta = 0.01f * i;
+        robot.setConfig(qs);
+        robot.calcForwardKinematics();
+        CHECK(reader.time(i) == 0.001 * i);
+        CHECK(reader.config(i, 0) == qs[0]);
+        CHECK(reader.config(i, 1) == qs[1]);
+        CHECK(reader.R(i) == robot.endPose().R);
+        CHECK(reader.t(i) == robot.endPose().t);
+    }
+    CHECK(reader.pose(99).t == robot.endPose().t);
+    std::remove(filename);
+
+    TrajectoryReader invalid("not_exist.bin");
+    CHECK(invalid.isOpen() == false);
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+TEST_CASE("Test continuum workspace", "[continuum]")
+{
+    using namespace mmath::continuum;
+    ConfigGrid grid({{0, 2, 3}, {-1, 1, 5}, {10, 20, 2}});
+    REQUIRE(grid.size() == 30);
+    mmath::kfloat q[3];
+    grid.at(0, q);
+    CHECK(q[0] == 0);
+    CHECK(q[1] == -1);
+    CHECK(q[2] == 10);
+    grid.at(29, q);
+    CHECK(q[0] == 2);
+    CHECK(q[1] == 1);
+    CHECK(q[2] == 20);
+    grid.at(1 + 3 * 2, q);
+    CHECK(q[0] == Approx(1));
+    CHECK(q[1] == Approx(0).margin(1e-6));
+    CHECK(q[2] == 10);
+
+    // The threads give the same map as a single thread
+    const GridAxis theta{0, mmath::PI / 2, 40}, delta{-mmath::PI, mmath::PI, 60};
+    const GridAxis L{20, 30, 6};
+    VoxelMap map(2), map_mt(2);
+    sampleSingleWithRigidSegmentWorkspace(theta, delta, L, 5, map);
+    sampleSingleWithRigidSegmentWorkspace(theta, delta, L, 5, map_mt, 4);
+    REQUIRE(map.size() > 0);
+    REQUIRE(map.size() == map_mt.size());
+    std::size_t count = 0;
+    map.forEach([&](const VoxelMap::Index &index, const VoxelStats &stats) {
+        const VoxelStats *other = map_mt.find(index);
+        REQUIRE(other);
+        CHECK(other->count == stats.count);
+        CHECK(other->z_min == stats.z_min);
+        CHECK(other->z_max == stats.z_max);
+        count += stats.count;
+    });
+    CHECK(count == 40 * 60 * 6);
+
+    // The straight segment reaches [0, 0, L + Lr] along z
+    mmath::Pose pose = calcSingleWithRigidSegmentPose(25, 0, 0, 5);
+    CHECK(map.isOccupied(pose.t.cast<double>()));
+    CHECK_FALSE(map.isOccupied(Eigen::Vector3d(0, 0, -10)));
+    const VoxelStats *stats = map.find(map.index(pose.t.cast<double>()));
+    REQUIRE(stats);
+    CHECK(stats->z_max[2] == Approx(1));
+    CHECK(map.center(map.index(Eigen::Vector3d(-0.5, 1, 3))).isApprox(
+              Eigen::Vector3d(-1, 1, 3)));
+
+    // Save and reload
+    const char* filename = "test_continuum_workspace.bin";
+    REQUIRE(map.save(filename));
+    VoxelMap loaded;
+    REQUIRE(loaded.load(filename));
+    CHECK(loaded.voxelSize() == 2);
+    CHECK(loaded.size() == map.size());
+    map.forEach([&](const VoxelMap::Index &index, const VoxelStats &stats) {
+        const VoxelStats *other = loaded.find(index);
+        REQUIRE(other);
+        CHECK(other->count == stats.count);
+        CHECK(other->z_min == stats.z_min);
+    });
+    std::remove(filename);
+    CHECK_FALSE(loaded.load(filename));
+
+    // A corrupt voxel_num or index is rejected, and the map is unchanged
+    auto write = [filename](const VoxelMapHeader &header,
+                            const std::vector<int32_t> &record) {
+        FILE *file = fopen(filename, "wb");
+        REQUIRE(file);
+        fwrite(&header, sizeof(header), 1, file);
+        fwrite(record.data(), sizeof(int32_t), record.size(), file);
+        fclose(file);
+    };
+    VoxelMapHeader header;
+    std::memcpy(header.magic, "LMVOXEL", 8);
+    header.version = VoxelMapHeader::VERSION;
+    header.record_size = VoxelMapHeader::RECORD_SIZE;
+    header.voxel_size = 2;
+    std::vector<int32_t> record(VoxelMapHeader::RECORD_SIZE / 4, 0);
+    header.voxel_num = uint64_t(1) << 61;
+    write(header, record);
+    CHECK_FALSE(loaded.load(filename));
+    header.voxel_num = 1;
+    record[0] = 1 << 21;
+    write(header, record);
+    CHECK_FALSE(loaded.load(filename));
+    CHECK(loaded.size() == map.size());
+    record[0] = -(1 << 20);
+    write(header, record);
+    REQUIRE(loaded.load(filename));
+    CHECK(loaded.find(VoxelMap::Index(-(1 << 20), 0, 0)));
+    std::remove(filename);
+
+    // A position out of the range of the index is dropped
+    pose.t << 1e7f, 0, 0;
+    CHECK_FALSE(loaded.add(pose));
+    CHECK(loaded.size() == 1);
+    CHECK_FALSE(loaded.isOccupied(Eigen::Vector3d(1e7, 0, 0)));
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+#include <vector>
+
+TEST_CASE("Test dual quaternion", "[kine]")
+{
+    using Vec3 = Eigen::Vector<double, 3>;
+    using Vec6 = Eigen::Vector<double, 6>;
+    Vec6 xi1, xi2;
+    xi1 << 1, 2, 3, 0.3, -0.2, 0.5;
+    xi2 << -2, 0, 1, -0.1, 0.8, 0.2;
+    mmath::PoseT<double> pose1 = mmath::expSE3(xi1);
+    mmath::PoseT<double> pose2 = mmath::expSE3(xi2);
+    mmath::DualQuatT<double> dq1(pose1), dq2(pose2);
+
+    mmath::PoseT<double> pose = dq1.toPose();
+    CHECK(pose.R.isApprox(pose1.R, 1e-12));
+    CHECK(pose.t.isApprox(pose1.t, 1e-12));
+
+    pose = (dq1 * dq2.inverse()).toPose();
+    mmath::PoseT<double> ref = pose1 * pose2.inverse();
+    CHECK(pose.R.isApprox(ref.R, 1e-12));
+    CHECK(pose.t.isApprox(ref.t, 1e-12));
+    CHECK((dq1 * Vec3(1, -1, 2)).isApprox(pose1 * Vec3(1, -1, 2), 1e-12));
+
+    // ScLERP is the constant twist between the poses
+    pose = mmath::sclerp(dq1, dq2, 0.3).toPose();
+    Vec6 xi = mmath::logSE3(pose1.inverse() * pose2);
+    ref = pose1 * mmath::expSE3(Vec6(0.3 * xi));
+    CHECK(pose.R.isApprox(ref.R, 1e-9));
+    CHECK(pose.t.isApprox(ref.t, 1e-9));
+
+    // ScLERP in float with a small relative rotation and a long translation
+    for(double theta : {0.019, 0.025, 0.05}) {
+        Vec6 dxi;
+        dxi << 20, -10, 30, theta * Vec3(0.2, 0.3, -1).normalized();
+        mmath::PoseT<double> pose3 = pose1 * mmath::expSE3(dxi);
+        mmath::DualQuatT<float> dqf1(mmath::PoseT<float>(
+                pose1.R.cast<float>().eval(), pose1.t.cast<float>().eval()));
+        mmath::DualQuatT<float> dqf3(mmath::PoseT<float>(
+                pose3.R.cast<float>().eval(), pose3.t.cast<float>().eval()));
+        mmath::PoseT<float> posef = mmath::sclerp(dqf1, dqf3, 0.4f).toPose();
+        ref = pose1 * mmath::expSE3(Vec6(0.4 * dxi));
+        CHECK((posef.R.cast<double>() - ref.R).cwiseAbs().maxCoeff() ==
+              Approx(0).margin(1e-6));
+        CHECK((posef.t.cast<double>() - ref.t).cwiseAbs().maxCoeff() ==
+              Approx(0).margin(2e-5));
+    }
+
+    // Blending is rigid, and is not affected by the sign of inputs
+    mmath::DualQuatT<double> dq2_neg(mmath::DualQuatT<double>::Quaternion(
+                                         -dq2.real.coeffs()),
+                                     mmath::DualQuatT<double>::Quaternion(
+                                         -dq2.dual.coeffs()));
+    std::vector<mmath::DualQuatT<double>> dqs = {dq1, dq2, dq2_neg};
+    double weights[] = {0.5, 0.5, 0.5, 0.5, 1.0, 0.0};
+    int indices[] = {0, 1, 0, 2, 1, 0};
+    mmath::DualQuatT<double> out[3];
+    mmath::blendDualQuatBatch(dqs.data(), indices, weights, 2, 3, out);
+    CHECK(out[0].real.coeffs().isApprox(out[1].real.coeffs(), 1e-12));
+    CHECK(out[0].translation().isApprox(out[1].translation(), 1e-12));
+    CHECK(out[2].translation().isApprox(pose2.t, 1e-12));
+    CHECK(out[0].real.norm() == Approx(1).margin(1e-12));
+    CHECK(out[0].real.dot(out[0].dual) == Approx(0).margin(1e-12));
+    CHECK(out[0].toPose().isUnitOrthogonal());
+
+    mmath::DualQuatT<double> blend = mmath::blendDualQuat(dqs.data(), weights, 2);
+    CHECK(blend.translation().isApprox(out[0].translation(), 1e-12));
+}
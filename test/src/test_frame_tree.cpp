@@ -0,0 +1,107 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+#include <atomic>
+#include <thread>
+
+namespace {
+using Vec3 = Eigen::Vector<mmath::kfloat, 3>;
+
+mmath::Pose makePose(mmath::kfloat angle, const Vec3 &t)
+{
+    return mmath::Pose(Eigen::AngleAxis<mmath::kfloat>(angle, Vec3::UnitZ())
+                       .toRotationMatrix(), t);
+}
+}
+
+TEST_CASE("Test frame tree", "[kine]")
+{
+    mmath::FrameTree tree(4);
+    int world = tree.addFrame("world");
+    int base = tree.addFrame("base", "world");
+    int tool = tree.addFrame("tool", "base");
+    int camera = tree.addFrame("camera", "world");
+    int other = tree.addFrame("other");
+    REQUIRE(tree.addFrame("base", "world") == -1);
+    REQUIRE(tree.addFrame("x", "missing") == -1);
+    REQUIRE(tree.frameNum() == 5);
+    CHECK(tree.frameId("tool") == tool);
+    CHECK(tree.parent(tool) == base);
+    CHECK(tree.frameName(camera) == "camera");
+
+    mmath::Pose pose;
+    CHECK_FALSE(tree.lookup(world, base, 0, pose));
+    CHECK_FALSE(tree.setTransform(world, 0, pose));
+
+    REQUIRE(tree.setStaticTransform(camera, makePose(0.5, Vec3(0, 0, 2))));
+    for(int i = 0; i < 6; i++) {
+        REQUIRE(tree.setTransform(base, i, makePose(0.1 * i, Vec3(i, 0, 0))));
+        REQUIRE(tree.setTransform(tool, i, makePose(0, Vec3(0, 0, 0.5 * i))));
+    }
+    CHECK_FALSE(tree.setTransform(base, 5, pose));
+
+    // camera_T_tool = camera_T_world * world_T_base * base_T_tool
+    REQUIRE(tree.lookup("camera", "tool", 3.5, pose));
+    mmath::Pose ref = makePose(0.5, Vec3(0, 0, 2)).inverse()
+            * makePose(0.35, Vec3(3.5, 0, 0)) * makePose(0, Vec3(0, 0, 1.75));
+    CHECK(pose.R.isApprox(ref.R, 1e-5f));
+    CHECK(pose.t.isApprox(ref.t, 1e-5f));
+
+    REQUIRE(tree.lookup(tool, world, mmath::FrameTree::LATEST, pose));
+    ref = (makePose(0.5, Vec3(5, 0, 0)) * makePose(0, Vec3(0, 0, 2.5))).inverse();
+    CHECK(pose.t.isApprox(ref.t, 1e-5f));
+
+    // Only the last 4 samples are buffered
+    CHECK_FALSE(tree.lookup(world, tool, 1.5, pose));
+    CHECK_FALSE(tree.lookup(world, tool, 5.5, pose));
+    CHECK_FALSE(tree.lookup(world, other, 3, pose));
+    CHECK(tree.lookup(base, base, 3, pose));
+    CHECK(pose.R.isIdentity());
+
+    // The cached lookup is invalidated by updates
+    mmath::FrameLookup lookup(tree, world, tool);
+    REQUIRE(lookup.isValid());
+    REQUIRE(lookup.lookup(mmath::FrameTree::LATEST, pose));
+    CHECK(pose.t.isApprox(Vec3(5, 0, 2.5)));
+    REQUIRE(lookup.lookup(mmath::FrameTree::LATEST, pose));
+    CHECK(pose.t.isApprox(Vec3(5, 0, 2.5)));
+    uint64_t version = tree.version(tool);
+    REQUIRE(tree.setTransform(tool, 6, makePose(0, Vec3(0, 0, 1))));
+    CHECK(tree.version(tool) != version);
+    REQUIRE(lookup.lookup(mmath::FrameTree::LATEST, pose));
+    CHECK(pose.t.isApprox(Vec3(5, 0, 1)));
+    CHECK_FALSE(mmath::FrameLookup(tree, base, other).isValid());
+}
+
+
+TEST_CASE("Test frame tree from threads", "[kine]")
+{
+    mmath::FrameTree tree(16);
+    tree.addFrame("world");
+    int base = tree.addFrame("base", "world");
+    tree.setTransform(base, 0, mmath::Pose());
+
+    // A torn read would break the rigidity or the equal translations
+    std::atomic<bool> is_done(false);
+    std::thread writer([&]() {
+        for(int i = 1; i <= 20000; i++) {
+            mmath::kfloat v = static_cast<mmath::kfloat>(i % 100);
+            tree.setTransform(base, i, makePose(0.01f * v, Vec3(v, v, v)));
+        }
+        is_done = true;
+    });
+
+    bool is_consistent = true;
+    int reads = 0;
+    mmath::Pose pose;
+    while(!is_done || reads < 100) {
+        if(tree.lookup("world", "base", mmath::FrameTree::LATEST, pose)) {
+            mmath::kfloat v = pose.t.x();
+            Eigen::Matrix<mmath::kfloat, 3, 3> R = makePose(0.01f * v, Vec3::Zero()).R;
+            is_consistent = is_consistent && pose.t.y() == v && pose.t.z() == v
+                    && R.isApprox(pose.R, 1e-4f);
+            reads++;
+        }
+    }
+    writer.join();
+    CHECK(is_consistent);
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+#include <cmath>
+#include <limits>
+
+namespace {
+using Vec3 = Eigen::Vector<double, 3>;
+using Vec6 = Eigen::Vector<double, 6>;
+}
+
+TEST_CASE("Test SO3 exp and log", "[kine]")
+{
+    for(double theta : {0.0, 1e-9, 1e-5, 0.3, 2.0, 3.1415}) {
+        Vec3 phi = theta * Vec3(1, -2, 0.5).normalized();
+        Eigen::Matrix3d R = mmath::expSO3(phi);
+        Eigen::Matrix3d R_ref = Eigen::AngleAxisd(theta,
+                Vec3(1, -2, 0.5).normalized()).toRotationMatrix();
+        CHECK(R.isApprox(R_ref, 1e-12));
+        CHECK((mmath::logSO3(R) - phi).norm() == Approx(0).margin(1e-9));
+    }
+
+    // Jl * dphi and Jr * dphi are the left/right increments of exp()
+    Vec3 phi(0.4, -0.2, 0.7), dphi(1e-7, -2e-7, 3e-7);
+    Eigen::Matrix3d R = mmath::expSO3(phi);
+    Eigen::Matrix3d R_new = mmath::expSO3(Vec3(phi + dphi));
+    Vec3 dl = mmath::logSO3(Eigen::Matrix3d(R_new * R.transpose()));
+    Vec3 dr = mmath::logSO3(Eigen::Matrix3d(R.transpose() * R_new));
+    CHECK((mmath::leftJacobianSO3(phi) * dphi - dl).norm() == Approx(0).margin(1e-12));
+    CHECK((mmath::rightJacobianSO3(phi) * dphi - dr).norm() == Approx(0).margin(1e-12));
+    CHECK((mmath::leftJacobianInvSO3(phi) * mmath::leftJacobianSO3(phi)).isIdentity(1e-12));
+    CHECK((mmath::rightJacobianInvSO3(phi) * mmath::rightJacobianSO3(phi)).isIdentity(1e-12));
+}
+
+
+TEST_CASE("Test SO3 inverse Jacobian in float", "[kine]")
+{
+    // Around the threshold of the series, i.e., theta^2 = sqrt(eps)
+    using Vec3f = Eigen::Vector<float, 3>;
+    const float theta_series = std::sqrt(std::sqrt(
+            std::numeric_limits<float>::epsilon()));
+    for(float theta : {0.99f * theta_series, 1.01f * theta_series, 0.025f,
+                       0.05f, 0.1f, 0.5f}) {
+        Vec3f phi = theta * Vec3f(1, -2, 0.5).normalized();
+        Eigen::Matrix3f Jinv = mmath::leftJacobianInvSO3(phi);
+        Eigen::Matrix3d Jinv_ref = mmath::leftJacobianInvSO3(Vec3(phi.cast<double>()));
+        CHECK((Jinv.cast<double>() - Jinv_ref).cwiseAbs().maxCoeff() ==
+              Approx(0).margin(1e-6));
+        CHECK((mmath::rightJacobianInvSO3(phi).cast<double>()
+               - mmath::rightJacobianInvSO3(Vec3(phi.cast<double>())))
+              .cwiseAbs().maxCoeff() == Approx(0).margin(1e-6));
+        CHECK((Jinv * mmath::leftJacobianSO3(phi)).isIdentity(1e-6f));
+    }
+}
+
+
+TEST_CASE("Test SE3 exp, log and Jacobians", "[kine]")
+{
+    for(double theta : {0.0, 1e-6, 0.01, 0.5, 2.5}) {
+        Vec6 xi;
+        xi << 1, -2, 3, theta * Vec3(0.2, 0.3, -1).normalized();
+        mmath::PoseT<double> pose = mmath::expSE3(xi);
+        CHECK((mmath::logSE3(pose) - xi).norm() == Approx(0).margin(1e-9));
+
+        // Compare Jl and Jr with the numerical difference
+        Eigen::Matrix<double, 6, 6> Jl_num, Jr_num;
+        const double h = 1e-6;
+        for(int i = 0; i < 6; i++) {
+            Vec6 d = Vec6::Zero();
+            d[i] = h;
+            mmath::PoseT<double> pose_p = mmath::expSE3(Vec6(xi + d));
+            mmath::PoseT<double> pose_m = mmath::expSE3(Vec6(xi - d));
+            Jl_num.col(i) = (mmath::logSE3(pose_p * pose.inverse())
+                             - mmath::logSE3(pose_m * pose.inverse())) / (2 * h);
+            Jr_num.col(i) = (mmath::logSE3(pose.inverse() * pose_p)
+                             - mmath::logSE3(pose.inverse() * pose_m)) / (2 * h);
+        }
+        CHECK((mmath::leftJacobianSE3(xi) - Jl_num).norm() == Approx(0).margin(1e-6));
+        CHECK((mmath::rightJacobianSE3(xi) - Jr_num).norm() == Approx(0).margin(1e-6));
+        CHECK((mmath::leftJacobianInvSE3(xi) * mmath::leftJacobianSE3(xi)).isIdentity(1e-9));
+        CHECK((mmath::rightJacobianInvSE3(xi) * mmath::rightJacobianSE3(xi)).isIdentity(1e-9));
+    }
+}
+
+
+TEST_CASE("Test pose boxplus and boxminus", "[kine]")
+{
+    using Vec3f = Eigen::Vector<float, 3>;
+    Eigen::AngleAxisf aa1(0.8f, Vec3f(1, 1, 0).normalized());
+    Eigen::AngleAxisf aa2(-0.3f, Vec3f(0, 1, 2).normalized());
+    mmath::PoseT<float> pose1(aa1.toRotationMatrix(), Vec3f(1, 2, 3));
+    mmath::PoseT<float> pose2(aa2.toRotationMatrix(), Vec3f(-4, 0, 5));
+
+    Eigen::Vector<float, 6> xi = pose2.boxminus(pose1);
+    mmath::PoseT<float> pose = pose1.boxplus(xi);
+    CHECK(pose.R.isApprox(pose2.R, 1e-5f));
+    CHECK(pose.t.isApprox(pose2.t, 1e-5f));
+
+    // A tiny increment is the first order of R * (I + phi^)
+    Eigen::Vector<float, 6> dxi;
+    dxi << 1e-4f, 0, 0, 0, 0, 2e-4f;
+    pose = pose1.boxplus(dxi);
+    CHECK(pose.boxminus(pose1).isApprox(dxi, 1e-3f));
+    CHECK(pose1.boxminus(pose1).norm() == Approx(0).margin(1e-6));
+}
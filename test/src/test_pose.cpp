@@ -1,5 +1,7 @@
 #include <catch2/catch.hpp>
 #include <lib_math/lib_math.h>
+#include <cstring>
+#include <string>
 
 TEST_CASE("Test pose", "[kine]")
 {
@@ -82,4 +84,134 @@ TEST_CASE("Test dpose", "[kine]")
     CHECK(dR(2, 0) == Approx(0).margin(1e-6));
     CHECK(dR(2, 1) == Approx(0).margin(1e-6));
     CHECK(dR(2, 2) == Approx(0).margin(1e-6));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test pose info", "[kine]")
+{
+    char expect[64], buf[64];
+    const double values[] = {0, -0.0, 1.5, -2.25, 3.1415926, 0.9999999,
+                             -1234567.0000005, 1e-7};
+    for(double v : values) {
+        int n = snprintf(expect, sizeof(expect), "%.6f", v);
+        CHECK(mmath::formatFixed(buf, sizeof(buf), v) == n);
+        CHECK(std::string(buf) == std::string(expect));
+    }
+    CHECK(mmath::formatFixed(buf, 4, 12.5, 3) == 6);
+    CHECK(std::string(buf) == "12.");
+
+    mmath::Pose pose(0.0, 0.0, 1.0, -16.15,
+                     1.0, 0.0, 0.0, -2.5,
+                     0.0, 1.0, 0.0, 38.2);
+    char expect_info[200];
+    sprintf(expect_info, "row-1st, R=[%f,%f,%f,%f,%f,%f,%f,%f,%f],t=[%f,%f,%f]",
+            pose.R(0, 0), pose.R(0, 1), pose.R(0, 2),
+            pose.R(1, 0), pose.R(1, 1), pose.R(1, 2),
+            pose.R(2, 0), pose.R(2, 1), pose.R(2, 2),
+            pose.t[0], pose.t[1], pose.t[2]);
+    char info[200];
+    CHECK(pose.info(info, sizeof(info)) == int(strlen(expect_info)));
+    CHECK(std::string(info) == std::string(expect_info));
+    CHECK(std::string(pose.info()) == std::string(expect_info));
+
+    char record[mmath::Pose::RECORD_SIZE];
+    CHECK(pose.toRecord(record) == mmath::Pose::RECORD_SIZE);
+    mmath::Pose pose2;
+    pose2.fromRecord(record);
+    CHECK(pose2.R == pose.R);
+    CHECK(pose2.t == pose.t);
+
+    mmath::continuum::ConfigSpc q(0.5, -1.25, 30, false);
+    CHECK(std::string(q.info()) ==
+          "theta:0.500000,delta:-1.250000,length:30.000000,is_bend:0");
+    char record_q[mmath::continuum::ConfigSpc::RECORD_SIZE];
+    q.toRecord(record_q);
+    mmath::continuum::ConfigSpc q2;
+    q2.fromRecord(record_q);
+    CHECK(q2 == q);
+}
+
+
+TEST_CASE("Test pose transform", "[kine]")
+{
+    using Vec3 = Eigen::Vector<mmath::kfloat, 3>;
+    Eigen::AngleAxis<mmath::kfloat> aa(0.3, Vec3(1, 2, 3).normalized());
+    mmath::Pose pose(aa.toRotationMatrix(), Vec3(10, -20, 30));
+    const int num = 20000;
+    Eigen::Matrix<mmath::kfloat, 3, Eigen::Dynamic> src, dst(3, num);
+    src = Eigen::Matrix<mmath::kfloat, 3, Eigen::Dynamic>::Random(3, num) * 100;
+
+    for(int thread_num : {1, 4}) {
+        pose.transform(src, dst, thread_num, true);
+        bool is_identical = true;
+        for(int i = 0; i < num; i++) {
+            is_identical &= (dst.col(i) == pose * src.col(i).eval());
+        }
+        CHECK(is_identical);
+
+        pose.transform(src, dst, thread_num);
+        for(int i = 0; i < num; i += 997) {
+            CHECK((dst.col(i) - pose * src.col(i).eval()).norm() ==
+                  Approx(0).margin(1e-3));
+        }
+    }
+
+    // A strided buffer [x y z w ...] transformed in place
+    std::vector<mmath::kfloat> buf(4 * num);
+    Eigen::Map<Eigen::Matrix<mmath::kfloat, 3, Eigen::Dynamic>, 0,
+               Eigen::OuterStride<4>> pts(buf.data(), 3, num);
+    pts = src;
+    pose.transformInPlace(pts, 2, true);
+    bool is_identical = true;
+    for(int i = 0; i < num; i++) {
+        is_identical &= (pts.col(i) == pose * src.col(i).eval());
+    }
+    CHECK(is_identical);
+}
+
+
+TEST_CASE("Test qpose", "[kine]")
+{
+    using Vec3 = Eigen::Vector<mmath::kfloat, 3>;
+    Eigen::AngleAxis<mmath::kfloat> aa1(0.3, Vec3(1, 2, 3).normalized());
+    Eigen::AngleAxis<mmath::kfloat> aa2(-1.2, Vec3(0, 1, -1).normalized());
+    mmath::Pose pose1(aa1.toRotationMatrix(), Vec3(10, -20, 30));
+    mmath::Pose pose2(aa2.toRotationMatrix(), Vec3(-1, 2, 5));
+    mmath::QPose qpose1(pose1), qpose2(pose2);
+
+    mmath::Pose pose = pose1 * pose2.inverse();
+    mmath::Pose pose_q = (qpose1 * qpose2.inverse()).toPose();
+    CHECK(pose_q.R.isApprox(pose.R, 1e-5f));
+    CHECK(pose_q.t.isApprox(pose.t, 1e-5f));
+
+    Vec3 p(3, -4, 5);
+    CHECK((qpose1 * p).isApprox(pose1 * p, 1e-5f));
+
+    mmath::QPose qpose = qpose1;
+    qpose *= qpose2;
+    CHECK(qpose.toPose().R.isApprox((pose1 * pose2).R, 1e-5f));
+
+    mmath::Pose pose_rt = mmath::QPose(pose1).toPose();
+    CHECK(pose_rt.R.isApprox(pose1.R, 1e-6f));
+    CHECK(pose_rt.t == pose1.t);
+
+    // The increment matches Pose whatever the sign of the stored q
+    Eigen::Quaternion<mmath::kfloat> dq(0.02f, -0.01f, 0.03f, 0.01f);
+    mmath::Pose pose3;
+    pose3.R = Eigen::AngleAxis<mmath::kfloat>(3, Vec3(0, 0, 1)).toRotationMatrix();
+    for(const mmath::Pose &p0 : {pose1, pose2, pose3}) {
+        for(mmath::kfloat sign : {1.f, -1.f}) {
+            mmath::QPose qinc(p0), qdec(p0);
+            qinc.q.coeffs() *= sign;
+            qdec.q.coeffs() *= sign;
+            mmath::Pose pinc = p0, pdec = p0;
+            qinc.increase(dq, p);
+            pinc.increase(dq, p);
+            qdec.decrease(dq, p);
+            pdec.decrease(dq, p);
+            CHECK(qinc.toPose().R.isApprox(pinc.R, 1e-5f));
+            CHECK(qinc.t.isApprox(pinc.t));
+            CHECK(qdec.toPose().R.isApprox(pdec.R, 1e-5f));
+            CHECK(qdec.t.isApprox(pdec.t));
+        }
+    }
+}
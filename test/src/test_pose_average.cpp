@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+#include <random>
+#include <vector>
+
+TEST_CASE("Test pose average", "[kine]")
+{
+    using Vec6 = Eigen::Vector<double, 6>;
+    Vec6 xi;
+    xi << 0.1, 0.2, 0.3, 0.5, -0.4, 1.2;
+    const mmath::PoseT<double> truth = mmath::expSE3(xi);
+
+    // The noise of 0.01 on each axis, and 10% outliers
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0, 0.01);
+    std::uniform_real_distribution<double> outlier(-1, 1);
+    std::vector<mmath::PoseT<double>> poses(20000), outliers(20000);
+    for(std::size_t i = 0; i < poses.size(); i++) {
+        Vec6 d;
+        for(int k = 0; k < 6; k++) {
+            d[k] = noise(rng);
+        }
+        poses[i] = truth * mmath::expSE3(d);
+        if(i % 10 == 0) {
+            for(int k = 0; k < 6; k++) {
+                d[k] = outlier(rng);
+            }
+        }
+        outliers[i] = truth * mmath::expSE3(d);
+    }
+
+    Eigen::Matrix<double, 6, 6> cov;
+    mmath::PoseT<double> mean = mmath::averagePoses(poses.data(), poses.size(), &cov);
+    CHECK(mmath::logSO3(Eigen::Matrix3d(truth.R.transpose() * mean.R)).norm() < 1e-3);
+    CHECK((mean.t - truth.t).norm() < 1e-3);
+    for(int k = 0; k < 6; k++) {
+        CHECK(std::sqrt(cov(k, k)) == Approx(0.01).epsilon(0.1));
+    }
+
+    // The parallel reduction gives the same mean
+    mmath::AverageOptions options;
+    options.thread_num = 4;
+    mmath::PoseT<double> mean_mt = mmath::averagePoses(poses.data(), poses.size(),
+                                                       nullptr, options);
+    CHECK(mean_mt.R.isApprox(mean.R, 1e-12));
+    CHECK(mean_mt.t.isApprox(mean.t, 1e-12));
+
+    // The robust losses reject the outliers
+    mean = mmath::averagePoses(outliers.data(), outliers.size());
+    double err_l2 = (mean.t - truth.t).norm();
+    for(auto loss : {mmath::RobustLoss::HUBER, mmath::RobustLoss::WEISZFELD}) {
+        options.loss = loss;
+        mean = mmath::averagePoses(outliers.data(), outliers.size(), nullptr, options);
+        CHECK((mean.t - truth.t).norm() < err_l2);
+        CHECK(mmath::logSO3(Eigen::Matrix3d(truth.R.transpose() * mean.R)).norm() < 2e-3);
+    }
+
+    mmath::PoseT<float> pose_f = truth.cast<float>();
+    mmath::PoseT<float> mean_f = mmath::averagePoses(&pose_f, 1);
+    CHECK(mean_f.R.isApprox(pose_f.R, 1e-6f));
+}
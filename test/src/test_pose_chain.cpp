@@ -0,0 +1,69 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+TEST_CASE("Test orthonormalize", "[kine]")
+{
+    Eigen::Matrix3d R = Eigen::AngleAxisd(0.7, Eigen::Vector3d(1, 2, 3).normalized())
+            .toRotationMatrix();
+    Eigen::Matrix3d R_noisy = R;
+    R_noisy(0, 1) += 1e-4;
+    R_noisy(2, 0) -= 2e-4;
+    CHECK(mmath::orthogonalityError(R) < 1e-15);
+    CHECK(mmath::orthogonalityError(R_noisy) > 1e-4);
+
+    // Newton-Schulz converges quadratically
+    Eigen::Matrix3d R1 = R_noisy, R2 = R_noisy;
+    mmath::orthonormalize(R1, 1);
+    mmath::orthonormalize(R2, 2);
+    CHECK(mmath::orthogonalityError(R1) < 1e-7);
+    CHECK(mmath::orthogonalityError(R2) < 1e-14);
+    CHECK((R2 - R).norm() < 3e-4);
+
+    // The Gram-Schmidt process handles large errors
+    Eigen::Matrix3d R3 = R + 0.3 * Eigen::Matrix3d::Ones();
+    mmath::orthonormalize(R3, 2);
+    CHECK(mmath::orthogonalityError(R3) < 1e-12);
+    CHECK(R3.determinant() == Approx(1));
+
+    std::vector<double> Rs(18);
+    Eigen::Map<Eigen::Matrix3d>(Rs.data()) = R_noisy;
+    Eigen::Map<Eigen::Matrix3d>(Rs.data() + 9) = R_noisy;
+    mmath::orthonormalizeBatch(Rs.data(), 2, 2);
+    CHECK(Eigen::Map<Eigen::Matrix3d>(Rs.data() + 9).isApprox(R2));
+
+    mmath::PoseT<double> poses[2];
+    poses[1].R = R_noisy;
+    mmath::orthonormalizeBatch(poses, 2, 2);
+    CHECK(poses[1].R.isApprox(R2));
+    CHECK(poses[0].R.isIdentity());
+}
+
+
+TEST_CASE("Test pose chain", "[kine]")
+{
+    using Vec3f = Eigen::Vector<float, 3>;
+    mmath::PoseT<float> step(Eigen::AngleAxisf(0.01f, Vec3f(1, 2, 3).normalized())
+                             .toRotationMatrix(), Vec3f(0.01f, 0, 0.02f));
+
+    mmath::PoseChainT<float> chain;
+    mmath::PoseT<float> raw;
+    float max_bound = 0;
+    for(int i = 0; i < 100000; i++) {
+        chain *= step;
+        raw *= step;
+        max_bound = std::max(max_bound, chain.errorBound());
+    }
+    CHECK(max_bound <= 1024 * std::numeric_limits<float>::epsilon());
+    CHECK(chain.reorthonormalizeCount() > 0);
+    CHECK(mmath::orthogonalityError(chain.pose().R) < 1e-5f);
+    CHECK(mmath::orthogonalityError(chain.pose().R) <
+          mmath::orthogonalityError(raw.R));
+    CHECK(chain.pose().isUnitOrthogonal());
+
+    chain.reset();
+    CHECK(chain.reorthonormalizeCount() == 0);
+    CHECK(chain.pose().R.isIdentity());
+}
@@ -0,0 +1,94 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+
+namespace {
+using Vec6 = Eigen::Vector<double, 6>;
+
+/** A screw motion with the constant twist xi per second. */
+mmath::PoseT<double> screw(double time)
+{
+    Vec6 xi;
+    xi << 0.5, -0.2, 1.0, 0.1, 0.3, -0.6;
+    return mmath::expSE3(Vec6(time * xi));
+}
+}
+
+TEST_CASE("Test pose trajectory", "[kine]")
+{
+    mmath::PoseTrajectoryT<double> traj;
+    for(int i = 0; i <= 10; i++) {
+        REQUIRE(traj.push(0.5 * i, screw(0.5 * i)));
+    }
+    REQUIRE(traj.push(5.0, screw(5.0)) == false);
+    REQUIRE(traj.size() == 11);
+    CHECK(traj.startTime() == 0.0);
+    CHECK(traj.endTime() == 5.0);
+    CHECK(traj.findInterval(0.0) == 0);
+    CHECK(traj.findInterval(2.6, 3) == 5);
+    CHECK(traj.findInterval(0.7, 8) == 1);
+    CHECK(traj.findInterval(9.0) == 9);
+
+    // SCLERP follows the screw motion exactly
+    for(double time : {0.1, 1.3, 4.99}) {
+        mmath::PoseT<double> pose = traj.at(time, mmath::InterpMode::SCLERP);
+        mmath::PoseT<double> ref = screw(time);
+        CHECK(pose.R.isApprox(ref.R, 1e-9));
+        CHECK(pose.t.isApprox(ref.t, 1e-9));
+
+        // The constant axis makes SLERP exact for rotation
+        CHECK(traj.at(time).R.isApprox(ref.R, 1e-9));
+        // The cubic is close to the motion, less close at the ends
+        pose = traj.at(time, mmath::InterpMode::CUBIC);
+        CHECK((pose.R - ref.R).norm() == Approx(0).margin(1e-3));
+        CHECK((pose.t - ref.t).norm() == Approx(0).margin(1e-2));
+    }
+
+    // All the modes pass through the knots, and clamp outside
+    for(auto mode : {mmath::InterpMode::SLERP, mmath::InterpMode::SCLERP,
+                     mmath::InterpMode::CUBIC}) {
+        mmath::PoseT<double> pose = traj.at(1.5, mode);
+        CHECK(pose.R.isApprox(traj.pose(3).R, 1e-9));
+        CHECK(pose.t.isApprox(traj.pose(3).t, 1e-9));
+        CHECK(traj.at(-1.0, mode).t.isApprox(traj.pose(0).t, 1e-9));
+        CHECK(traj.at(7.0, mode).t.isApprox(traj.pose(10).t, 1e-9));
+    }
+
+    // Monotone, non-monotone and linspaced queries are the same as at()
+    std::vector<double> times = mmath::linspaceN<double>(-0.5, 5.5, 25);
+    std::vector<mmath::PoseT<double>> poses, poses_lin(times.size());
+    traj.resample(times, poses, mmath::InterpMode::CUBIC);
+    traj.resample(-0.5, 5.5, 25, poses_lin.data(), mmath::InterpMode::CUBIC);
+    for(std::size_t i = 0; i < times.size(); i++) {
+        mmath::PoseT<double> ref = traj.at(times[i], mmath::InterpMode::CUBIC);
+        CHECK(poses[i].R.isApprox(ref.R, 1e-12));
+        CHECK(poses_lin[i].t.isApprox(ref.t, 1e-9));
+    }
+    std::reverse(times.begin(), times.end());
+    traj.resample(times, poses);
+    for(std::size_t i = 0; i < times.size(); i++) {
+        CHECK(poses[i].t.isApprox(traj.at(times[i]).t, 1e-12));
+    }
+}
+
+
+TEST_CASE("Test pose trajectory in float", "[kine]")
+{
+    // The keys are 0.02 rad apart, where SCLERP takes the small-angle twists
+    Vec6 xi;
+    xi << 20, -10, 30, 0.1, 0.3, -0.6;
+    mmath::PoseTrajectoryT<float> traj;
+    for(int i = 0; i <= 20; i++) {
+        mmath::PoseT<double> pose = mmath::expSE3(Vec6(0.03 * i * xi));
+        REQUIRE(traj.push(0.03 * i, mmath::PoseT<float>(
+                              pose.R.cast<float>().eval(),
+                              pose.t.cast<float>().eval())));
+    }
+    for(double time : {0.012, 0.145, 0.33, 0.587}) {
+        mmath::PoseT<float> pose = traj.at(time, mmath::InterpMode::SCLERP);
+        mmath::PoseT<double> ref = mmath::expSE3(Vec6(time * xi));
+        CHECK((pose.R.cast<double>() - ref.R).cwiseAbs().maxCoeff() ==
+              Approx(0).margin(1e-6));
+        CHECK((pose.t.cast<double>() - ref.t).cwiseAbs().maxCoeff() ==
+              Approx(0).margin(1e-5));
+    }
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch.hpp>
+#include <lib_math/lib_math.h>
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Test singularity measure", "[kine]")
+{
+    using namespace mmath::continuum;
+    // Compare with the SVD over the closed-form and the general sizes
+    std::srand(7);
+    for(auto size : {std::make_pair(1, 4), std::make_pair(3, 2),
+                     std::make_pair(3, 3), std::make_pair(2, 6),
+                     std::make_pair(6, 4), std::make_pair(6, 6),
+                     std::make_pair(6, 9)}) {
+        Eigen::MatrixXd J = Eigen::MatrixXd::Random(size.first, size.second);
+        mmath::SingularityMeasureT<double> measure =
+                mmath::calcSingularityMeasure<double>(J);
+        Eigen::JacobiSVD<Eigen::MatrixXd> svd(J);
+        Eigen::VectorXd sigma = svd.singularValues();
+        CHECK(measure.sigma_max == Approx(sigma[0]).epsilon(1e-10));
+        CHECK(measure.sigma_min == Approx(sigma[sigma.size() - 1]).epsilon(1e-8));
+        CHECK(measure.manipulability == Approx(sigma.prod()).epsilon(1e-10));
+        CHECK(measure.condition ==
+              Approx(sigma[0] / sigma[sigma.size() - 1]).epsilon(1e-8));
+    }
+
+    // The delta column vanishes for a straight segment
+    Eigen::Matrix<double, 3, 2> Jv, Jw;
+    mmath::continuum::calcSingleSegmentJacobian<double>(30, 0, 0.4, Jv, Jw);
+    mmath::SingularityMeasureT<double> measure =
+            mmath::calcSingularityMeasure<double>(Jv);
+    CHECK(measure.sigma_min == Approx(0).margin(1e-12));
+    CHECK(measure.manipulability == Approx(0).margin(1e-12));
+    CHECK(std::isinf(measure.condition));
+
+    // A block of a larger Jacobian in float
+    Eigen::Matrix<float, 6, 3> J6;
+    J6.setZero();
+    J6.diagonal() << 3, 2, 0.5f;
+    mmath::SingularityMeasureT<float> measuref =
+            mmath::calcSingularityMeasure<float>(J6.leftCols(2));
+    CHECK(measuref.sigma_min == Approx(2));
+    CHECK(measuref.condition == Approx(1.5));
+
+    // The float measure near a straight segment matches the SVD in double
+    Eigen::Matrix<float, 3, 3> Jvf, Jwf;
+    Eigen::Matrix<float, 6, 3> Jf;
+    for(float theta : {1e-2f, 3e-3f, 1e-3f, 3e-4f, 1e-4f, 3e-5f, 1e-5f}) {
+        calcVariableLengthSegmentJacobian<float>(30, theta, 0.7f, Jvf, Jwf);
+        Jf << Jvf, Jwf;
+        measuref = mmath::calcSingularityMeasure<float>(Jf);
+        Eigen::JacobiSVD<Eigen::MatrixXd> svd(Jf.cast<double>());
+        Eigen::VectorXd sigma = svd.singularValues();
+        CHECK(measuref.sigma_min == Approx(sigma[2]).epsilon(1e-4));
+        CHECK(measuref.sigma_max == Approx(sigma[0]).epsilon(1e-5));
+        CHECK(measuref.manipulability == Approx(sigma.prod()).epsilon(1e-4));
+        CHECK(measuref.condition == Approx(sigma[0] / sigma[2]).epsilon(1e-4));
+    }
+}
+
+
+TEST_CASE("Test singularity monitor", "[kine]")
+{
+    using namespace mmath::continuum;
+    mmath::SingularityMonitorT<double> monitor(4);
+    monitor.setThresholds(0, 0.5, 0, 0.2);
+
+    std::vector<uint32_t> events;
+    monitor.setCallback([&events](const mmath::SingularityMeasureT<double>&,
+                        uint32_t flags) {
+        events.push_back(flags);
+    });
+
+    // Sweep theta through zero, where the monitor enters and leaves once
+    Eigen::Matrix<double, 3, 3> Jv, Jw;
+    Eigen::Matrix<double, 6, 3> J;
+    std::vector<double> sigma_mins;
+    for(int k = -20; k <= 20; k++) {
+        double theta = 0.05 * k;
+        calcVariableLengthSegmentJacobian<double>(1, theta, 0.3, Jv, Jw);
+        J << Jv, Jw;
+        sigma_mins.push_back(monitor.update(J).sigma_min);
+    }
+    REQUIRE(events.size() == 2);
+    CHECK(events[0] == monitor.LOW_SIGMA_MIN);
+    CHECK(events[1] == 0);
+    CHECK(monitor.flags() == 0);
+    CHECK(sigma_mins[20] == Approx(0).margin(1e-12));
+
+    // The last 4 samples are kept in the statistics
+    mmath::SingularityMonitorT<double>::Stats stats = monitor.stats();
+    CHECK(stats.count == 4);
+    CHECK(stats.sigma_min_mean == Approx((sigma_mins[37] + sigma_mins[38] +
+            sigma_mins[39] + sigma_mins[40]) / 4));
+    CHECK(stats.sigma_min_min == Approx(sigma_mins[37]));
+
+    // A measure hovering around the threshold does not flood the callback
+    events.clear();
+    Eigen::Matrix2d D = Eigen::Matrix2d::Identity();
+    for(int k = 0; k < 10; k++) {
+        D(1, 1) = k % 2 == 0 ? 0.49 : 0.55;
+        monitor.update(D);
+    }
+    CHECK(events.size() == 1);
+    D(1, 1) = 0.61;
+    monitor.update(D);
+    CHECK(events.size() == 2);
+
+    monitor.reset();
+    CHECK(monitor.stats().count == 0);
+    CHECK(monitor.flags() == 0);
+}